@@ -0,0 +1,158 @@
+#include "runner.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <imgui/imgui.h>
+#include "logstorm/logstorm.h"
+
+namespace benchmark {
+
+namespace {
+
+constexpr std::array scenes{
+  runner::scene{.name{"baseline"},  .instance_count{1},     .gui_window_count{0}},
+  runner::scene{.name{"instances"}, .instance_count{10000}, .gui_window_count{0}},
+  runner::scene{.name{"gui"},       .instance_count{1},     .gui_window_count{16}},
+  runner::scene{.name{"combined"},  .instance_count{10000}, .gui_window_count{16}},
+};
+
+constexpr unsigned int gpu_drain_frames{10};                                    // frames to wait after the last measured frame for its GPU time to arrive
+
+std::string get_statistics_json(std::vector<double> times) {
+  /// Summarise a set of frame times as a JSON object of percentiles, in milliseconds
+  if(times.empty()) return "null";
+  std::sort(times.begin(), times.end());
+  auto const percentile{[&](double fraction){
+    return times[static_cast<size_t>(std::ceil(fraction * static_cast<double>(times.size()))) - 1]; // nearest rank
+  }};
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(3)
+      << R"({"samples":)" << times.size()
+      << R"(,"mean":)" << std::accumulate(times.begin(), times.end(), 0.0) / static_cast<double>(times.size())
+      << R"(,"p50":)" << percentile(0.5)
+      << R"(,"p90":)" << percentile(0.9)
+      << R"(,"p95":)" << percentile(0.95)
+      << R"(,"p99":)" << percentile(0.99)
+      << R"(,"max":)" << times.back()
+      << "}";
+  return oss.str();
+}
+
+}
+
+runner::runner(logstorm::manager &this_logger)
+  : logger{this_logger} {
+  /// Default constructor
+}
+
+runner::scene const *runner::find_scene(std::string const &name) {
+  /// Look up a predefined scene by name, returning nullptr if there's no such scene
+  auto const it{std::find_if(scenes.begin(), scenes.end(), [&](scene const &this_scene){return name == this_scene.name;})};
+  return it == scenes.end() ? nullptr : &*it;
+}
+
+void runner::start(scene const &new_scene, uint64_t new_first_renderer_frame) {
+  /// Begin running a scene from its first frame, which the renderer will number as given
+  current_scene = new_scene;
+  frame = 0;
+  first_renderer_frame = new_first_renderer_frame;
+  done = false;
+  cpu_times.clear();
+  cpu_times.reserve(current_scene.frame_count);
+  gpu_times.clear();
+  gpu_times.reserve(current_scene.frame_count);
+  logger << "Benchmark: Running scene \"" << current_scene.name << "\" for " << current_scene.frame_count << " frames after " << warm_up_frames << " warm-up frames";
+}
+
+runner::scene const &runner::get_scene() const {
+  /// Return the scene being run
+  return current_scene;
+}
+
+bool runner::finished() const {
+  /// Return whether all frames have run and the results have been reported
+  return done;
+}
+
+vec2f runner::get_camera_rotation() const {
+  /// Return this frame's rotation along the camera path, which depends only on the frame number so every run sees the same views
+  auto const t{static_cast<float>(frame) * 0.01f};
+  return {0.02f + 0.01f * std::sin(t), 0.005f * std::cos(t * 0.7f)};
+}
+
+void runner::begin_frame() {
+  /// Mark the start of a frame's CPU work
+  frame_start = std::chrono::steady_clock::now();
+}
+
+void runner::end_frame() {
+  /// Mark the end of a frame's CPU work, reporting once all frames and their GPU times are in
+  if(done) return;
+  if(measuring()) {
+    cpu_times.emplace_back(std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - frame_start}.count());
+  }
+  ++frame;
+  if(frame < warm_up_frames + current_scene.frame_count) return;
+  if(gpu_times.size() < current_scene.frame_count && frame < warm_up_frames + current_scene.frame_count + gpu_drain_frames) return;
+  report();
+}
+
+void runner::add_gpu_time(uint64_t renderer_frame, double milliseconds) {
+  /// Record the GPU time of a submitted frame, if that frame was one of those measured - it may arrive several frames later
+  if(done || renderer_frame < first_renderer_frame + warm_up_frames || renderer_frame >= first_renderer_frame + warm_up_frames + current_scene.frame_count) return;
+  gpu_times.emplace_back(milliseconds);
+}
+
+void runner::draw_gui() const {
+  /// Draw the scene's heavy GUI windows, with contents that depend only on the frame number
+  for(unsigned int window{0}; window != current_scene.gui_window_count; ++window) {
+    auto const window_offset{static_cast<float>(window) * 24.0f};
+    ImGui::SetNextWindowPos({32.0f + window_offset, 32.0f + window_offset}, ImGuiCond_Always);
+    ImGui::SetNextWindowSize({360.0f, 480.0f}, ImGuiCond_Always);
+    if(ImGui::Begin(("Benchmark window " + std::to_string(window)).c_str())) {
+      std::array<float, 128> plot_values;
+      for(size_t i{0}; i != plot_values.size(); ++i) {
+        plot_values[i] = std::sin(static_cast<float>(i + frame + window) * 0.1f);
+      }
+      ImGui::PlotLines("Plot", plot_values.data(), static_cast<int>(plot_values.size()), 0, nullptr, -1.0f, 1.0f, {0.0f, 80.0f});
+      if(ImGui::BeginTable("Table", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        for(unsigned int row{0}; row != 64; ++row) {
+          ImGui::TableNextRow();
+          for(unsigned int column{0}; column != 4; ++column) {
+            ImGui::TableNextColumn();
+            ImGui::Text("%u:%u %u", row, column, (row * column + frame) % 1000);
+          }
+        }
+        ImGui::EndTable();
+      }
+    }
+    ImGui::End();
+  }
+}
+
+bool runner::measuring() const {
+  /// Return whether the current frame is past warm-up and within the measured frames
+  return frame >= warm_up_frames && frame < warm_up_frames + current_scene.frame_count;
+}
+
+void runner::report() {
+  /// Log the results as a single line of JSON, for collection by scripts
+  done = true;
+  if(gpu_times.size() < current_scene.frame_count) {
+    logger << "WARNING: Benchmark: Only " << gpu_times.size() << " of " << current_scene.frame_count << " GPU frame times arrived";
+  }
+  std::ostringstream oss;
+  oss << R"({"scene":")" << current_scene.name << '"'
+      << R"(,"frames":)" << current_scene.frame_count
+      << R"(,"instances":)" << current_scene.instance_count
+      << R"(,"gui_windows":)" << current_scene.gui_window_count
+      << R"(,"cpu_ms":)" << get_statistics_json(cpu_times)
+      << R"(,"gpu_ms":)" << get_statistics_json(gpu_times)
+      << "}";
+  logger << "Benchmark: " << oss.str();
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "logstorm/logstorm_forward.h"
+#include "vectorstorm/vector/vector2.h"
+
+namespace benchmark {
+
+class runner {
+  /// Runs a named scene for a fixed number of frames along a fixed camera path, then logs CPU and GPU frame time percentiles as JSON
+public:
+  struct scene {
+    char const *name{nullptr};
+    unsigned int instance_count{1};                                             // copies of the scene geometry drawn
+    unsigned int gui_window_count{0};                                           // heavy GUI windows drawn
+    unsigned int frame_count{600};                                              // frames measured, after warming up
+  };
+
+private:
+  logstorm::manager &logger;
+
+  scene current_scene;
+  unsigned int frame{0};                                                        // frame currently running, including warm-up frames
+  uint64_t first_renderer_frame{0};                                             // the renderer's number for our first frame, to match GPU times to the frames that submitted them
+  bool done{false};
+
+  std::chrono::steady_clock::time_point frame_start;
+  std::vector<double> cpu_times;                                                // milliseconds
+  std::vector<double> gpu_times;                                                // milliseconds, arriving asynchronously after their frames
+
+public:
+  static constexpr unsigned int warm_up_frames{60};                             // not measured, to let pipelines and caches settle
+
+  runner(logstorm::manager &logger);
+
+  static scene const *find_scene(std::string const &name);
+
+  void start(scene const &new_scene, uint64_t new_first_renderer_frame);
+
+  scene const &get_scene() const;
+  bool finished() const;
+  vec2f get_camera_rotation() const;
+
+  void begin_frame();
+  void end_frame();
+  void add_gpu_time(uint64_t renderer_frame, double milliseconds);
+
+  void draw_gui() const;
+
+private:
+  bool measuring() const;
+  void report();
+};
+
+}
@@ -3,6 +3,7 @@
 compiled_resources=(
   render/shaders/*.wgsl
 )
+compiled_resources_blob="embedded/blob.h"
 
 # redirect all stdout to stderr
 exec 1>&2
@@ -19,9 +20,7 @@ if [ "$target" = "clean" ]; then
   echo "Cleaning build directory \"$build_dir\"..."
   rm -r "$build_dir"
   echo "Cleaning ${#compiled_resources[@]} compiled resources..."
-  for file in "${compiled_resources[@]}"; do
-    rm "${file}.h"
-  done
+  rm "$compiled_resources_blob"
   target="client"
 fi
 
@@ -33,18 +32,13 @@ if [ ! -d "$build_dir" ]; then
   mkdir "$build_dir"
 fi
 
-# compile resources
-compiled_resources_total=0
-compiled_resources_up_to_date=0
-for file in "${compiled_resources[@]}"; do
-  ((++compiled_resources_total))
-  result=$(./compile_resource_to_raw_string.sh "$file")
-  if grep -Fq "up to date" <<< "$result"; then
-    ((++compiled_resources_up_to_date))
-  fi
-done
-compiled_resources_updated=$((compiled_resources_total - compiled_resources_up_to_date))
-echo "Compiled resources: $compiled_resources_updated updated, $compiled_resources_up_to_date up to date ($compiled_resources_total total)"
+# compile resources into a single compressed blob
+compiled_resources_updated=1
+result=$(./compile_resource_blob.sh "$compiled_resources_blob" "${compiled_resources[@]}") || exit 1
+echo "$result"
+if grep -Fq "up to date" <<< "$result"; then
+  compiled_resources_updated=0
+fi
 
 if [ "$compiled_resources_updated" != 0 ]; then
   # validate shaders
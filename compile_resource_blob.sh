@@ -0,0 +1,94 @@
+#!/bin/bash
+# Compile a set of resources into a single header holding one compressed, deduplicated blob and an index into it
+# Each unique resource is a separate gzip member, so it can be decompressed independently on first access
+
+# the following are file types we strip C-style comments for:
+strip_comment_suffixes=(
+  "wgsl"
+  "glsl"
+)
+
+outfile="$1"
+shift
+if [ -z "$outfile" ] || [ "$#" = 0 ]; then
+  echo "Usage: $0 <output header> <filename> [filename...]" 2>&1
+  exit 1
+fi
+
+infiles=($(printf '%s\n' "$@" | LC_ALL=C sort -u))                             # sorted by name, so the index can be binary searched
+
+# don't update if outfile is newer than every infile and lists the same files
+up_to_date=1
+for infile in "${infiles[@]}"; do
+  if [ ! -f "$infile" ]; then
+    echo "Resource compiler: File $infile not found." 2>&1
+    exit 1
+  fi
+  if [ "$infile" -nt "$outfile" ] || ! grep -Fq "{\"$infile\"," "$outfile" 2>/dev/null; then
+    up_to_date=0
+  fi
+done
+if [ "$up_to_date" = 1 ] && [ "$(grep -c '^  {"' "$outfile")" = "${#infiles[@]}" ]; then
+  echo "Resource compiler: $outfile up to date"
+  exit 0
+fi
+
+workdir=$(mktemp -d) || exit 1
+trap 'rm -r "$workdir"' EXIT
+
+# preprocess and compress each unique resource
+declare -A unique_ids
+unique_count=0
+offset=0
+index=""
+> "$workdir/blob"
+for infile in "${infiles[@]}"; do
+  suffix=${infile##*.} # get the suffix
+  suffix=${suffix,,} # make it lowercase
+
+  if printf '%s\0' "${strip_comment_suffixes[@]}" | grep -Fxzq -- "$suffix"; then
+    # strip comments and whitespace-only lines
+    sed "s/ *\/\/.*//;/^[ ]*$/d" "$infile" > "$workdir/content"
+  else
+    cp "$infile" "$workdir/content"
+  fi
+  size=$(stat -c %s "$workdir/content")
+  hash=$(md5sum "$workdir/content" | cut -c 1-32)
+
+  if [ -z "${unique_ids[$hash]}" ]; then
+    gzip -9 -n -c "$workdir/content" > "$workdir/compressed"
+    compressed_size=$(stat -c %s "$workdir/compressed")
+    cat "$workdir/compressed" >> "$workdir/blob"
+    unique_ids[$hash]="$unique_count $offset $compressed_size"
+    ((++unique_count))
+    ((offset += compressed_size))
+  else
+    echo "Resource compiler: $infile is a duplicate, sharing its data"
+  fi
+  read -r unique_id unique_offset unique_compressed_size <<< "${unique_ids[$hash]}"
+  index+="  {\"$infile\", $unique_id, $unique_offset, $unique_compressed_size, $size},"$'\n'
+done
+
+# truncate the destination file
+> "$outfile"
+
+# comments
+echo "#pragma once"$'\n' >> "$outfile"
+echo "// This file is automatically generated from ${#infiles[@]} resources by $0"$'\n' >> "$outfile"
+echo "#include \"resources.h\""$'\n' >> "$outfile"
+echo "namespace embedded::blob {"$'\n' >> "$outfile"
+
+# compressed data
+echo "inline constexpr unsigned char data[]{" >> "$outfile"
+od -An -v -tx1 -w24 "$workdir/blob" | sed 's/^ *//;s/ \+/,0x/g;s/^/  0x/;s/$/,/' >> "$outfile"
+echo "};"$'\n' >> "$outfile"
+
+# index
+echo "inline constexpr unsigned int unique_count{$unique_count};"$'\n' >> "$outfile"
+echo "inline constexpr entry index[]{                                                // name, unique id, offset, compressed size, size" >> "$outfile"
+echo -n "$index" >> "$outfile"
+echo "};" >> "$outfile"
+
+echo $'\n'"} // namespace embedded::blob" >> "$outfile"
+
+echo "Resource compiler: ${#infiles[@]} resources ($unique_count unique) compiled to $outfile: $offset bytes compressed"
@@ -0,0 +1,213 @@
+#pragma once
+
+// This file is automatically generated from 5 resources by ./compile_resource_blob.sh
+
+#include "resources.h"
+
+namespace embedded::blob {
+
+inline constexpr unsigned char data[]{
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x8d,0x56,0xdb,0x6e,0xe2,0x30,0x10,0x7d,0xef,0x57,0xf8,0x69,0x15,0x77,
+  0xd3,0x2c,0x49,0xd8,0x6e,0x05,0x05,0xf1,0x1f,0x55,0x15,0x99,0xc4,0xa1,0x5e,0x05,0x1b,0xf9,0x42,0xa9,0x56,0xfd,0xf7,0x1d,
+  0xc7,0xce,0x3d,0xb4,0xa0,0x08,0x1c,0xcf,0xed,0xcc,0xcc,0x19,0x1b,0xa5,0xa5,0xc9,0x35,0x3a,0x53,0xa9,0xe9,0x25,0x63,0xfc,
+  0x64,0x34,0xfa,0x77,0x87,0xd0,0xae,0x12,0x39,0xd1,0x4c,0xf0,0x60,0x81,0xd1,0x49,0x28,0x66,0xd7,0x2b,0xd0,0xcb,0xd3,0x32,
+  0x1c,0xc8,0x63,0x8c,0xb8,0x90,0x47,0x52,0xcd,0x4a,0x13,0x8c,0x72,0x51,0x09,0x23,0x6b,0xe9,0x72,0x24,0x4d,0x31,0x62,0x5c,
+  0x69,0xc2,0x73,0x9a,0x89,0xb2,0x54,0x54,0xb7,0x4e,0x3e,0xd7,0x77,0x6a,0x80,0x4d,0x18,0xdd,0x82,0xdb,0x1b,0x56,0x69,0xc6,
+  0x83,0x06,0xd8,0x08,0xe2,0x72,0x0a,0x71,0xc7,0xb8,0xa6,0xf2,0x24,0x2a,0xa2,0x69,0x50,0xc2,0x77,0x88,0x4a,0x26,0x95,0x9e,
+  0xc0,0xeb,0xe2,0x1a,0xce,0x4a,0x48,0x2c,0xf3,0xaf,0x36,0xf0,0x51,0x14,0xb4,0xca,0xce,0x8c,0xbe,0x67,0x27,0x29,0xfe,0xd2,
+  0xdc,0xba,0xcf,0x8e,0x44,0x4b,0x76,0x59,0x21,0xf8,0x5d,0x5e,0x5c,0x6c,0x57,0x91,0xbe,0x24,0xbd,0xf8,0xac,0x76,0x07,0x29,
+  0xcc,0xc9,0x96,0x75,0xb7,0x67,0xbc,0x60,0xfc,0x60,0xd7,0x67,0x22,0x9f,0x7d,0xc0,0x6d,0x13,0x59,0xad,0x46,0x18,0x5a,0xe3,
+  0x78,0x6a,0xac,0xb4,0x90,0xe4,0x40,0x43,0x24,0x29,0x29,0xb6,0x4d,0xd1,0xde,0x85,0x2c,0xc0,0x0d,0x91,0x92,0x7c,0x3c,0x97,
+  0x69,0xb2,0x9d,0x75,0x11,0xcf,0xba,0x00,0xe1,0xd8,0x83,0xb9,0xe6,0x21,0xb9,0xe2,0x61,0xd0,0xdb,0xef,0x81,0xa4,0xf3,0xb9,
+  0x30,0xc5,0xf6,0x15,0xcd,0x6c,0x4e,0x2c,0xa7,0xad,0x1b,0xe8,0x58,0x62,0xc0,0x91,0x00,0x81,0x64,0x05,0x6d,0x92,0x86,0x62,
+  0xc1,0x1b,0x14,0x2f,0x4d,0xd0,0x06,0xc5,0x0b,0xd3,0x53,0x69,0x78,0xd2,0xd2,0xcd,0x29,0x0d,0x74,0x7c,0xf3,0x86,0x1a,0x69,
+  0x5f,0xc3,0x71,0x66,0xa4,0xf1,0x08,0x1a,0xb9,0x80,0x94,0x51,0xc5,0x0e,0x6f,0x3a,0x2b,0x98,0x84,0xdd,0x9a,0xce,0xc1,0x22,
+  0x7a,0xfa,0x93,0xc0,0x13,0xa2,0x45,0x94,0xc4,0x4f,0xf0,0x84,0xe8,0x61,0x11,0x2d,0xd3,0x47,0x78,0x70,0x63,0x47,0x8e,0x7b,
+  0x46,0xb9,0xb6,0x78,0xa2,0xdf,0xe5,0xfa,0xae,0xe4,0x48,0xbd,0x91,0xc2,0x65,0x4e,0x2f,0x01,0xab,0xe9,0xdd,0x4d,0x2a,0x46,
+  0x0f,0xdb,0x99,0xf1,0x80,0x12,0x22,0x78,0x5d,0x0d,0x45,0x6b,0x90,0xc0,0x2a,0x6a,0x2a,0x00,0x51,0x1a,0x9e,0x45,0x5f,0xf1,
+  0x1a,0xdd,0xbb,0xd1,0x80,0xe8,0x9d,0xed,0x4f,0xe8,0x6d,0x34,0x6a,0x6f,0x88,0xe2,0x68,0x81,0x6d,0x98,0x8a,0x6a,0xa4,0x25,
+  0xe1,0xca,0x7a,0xa7,0x45,0xe6,0x0a,0xda,0x0f,0x38,0x98,0x0f,0x88,0x00,0xde,0xdc,0x56,0x63,0x5e,0xb0,0xb2,0x34,0x8a,0x66,
+  0x76,0x6c,0x39,0x04,0xfd,0x00,0xeb,0xe0,0x48,0x2e,0x41,0x21,0x74,0x30,0xf5,0x1d,0x76,0x35,0xc7,0xb6,0xc6,0x30,0x14,0xf7,
+  0x28,0x00,0x3c,0xe8,0xa1,0xa9,0x2a,0xc6,0x80,0xda,0xaf,0x9b,0x5a,0xb8,0x3e,0xba,0x2e,0xb9,0x0c,0xdd,0x4e,0x24,0x0f,0x7b,
+  0x70,0x30,0x01,0x11,0xa2,0x4e,0x85,0xd4,0xa9,0x4a,0xaa,0x8d,0xe4,0xd6,0xd9,0xfa,0xee,0xd3,0x36,0xcc,0x52,0x36,0x73,0x4d,
+  0xdf,0x13,0xe5,0x58,0xe8,0xfb,0x04,0x7b,0x75,0x7f,0xbc,0x8d,0x53,0xea,0x0f,0xea,0x8b,0xb5,0x78,0x0d,0xd1,0x64,0x0f,0x90,
+  0xc7,0xe6,0x8a,0x20,0x31,0xaf,0xd8,0xc6,0xde,0x39,0xa1,0xc5,0x70,0x56,0x50,0x59,0x38,0x1e,0x6f,0xe4,0x8b,0xc7,0x33,0xa2,
+  0x1a,0xf6,0x09,0x9d,0x4c,0x55,0x75,0xbb,0x70,0x24,0xd4,0x29,0x85,0xdd,0x70,0x77,0x9b,0x7d,0xff,0xdd,0x55,0x62,0xdb,0x59,
+  0x63,0xdd,0xb8,0x23,0xa5,0x26,0x54,0x6f,0x50,0xd7,0x9e,0xb2,0x63,0xb4,0x76,0xbf,0xcf,0xb9,0xcd,0xb8,0xb6,0x90,0xfc,0x68,
+  0x9c,0xb1,0xb7,0x69,0x09,0x37,0xb5,0x18,0x0c,0x77,0xa3,0x3f,0xe2,0xc1,0xd4,0x6a,0x30,0xf0,0x78,0xbe,0x11,0x03,0x1d,0x78,
+  0x4f,0xeb,0xc6,0xa0,0x99,0x49,0x69,0x8f,0x85,0xf1,0x01,0xf9,0x32,0x2c,0x2a,0x54,0x2a,0xb5,0x6d,0xbf,0x45,0xad,0xa1,0xc8,
+  0x8d,0xba,0x89,0x07,0xe7,0x7b,0xcf,0xf8,0x94,0x42,0xb6,0xf1,0xb4,0x08,0xda,0xcb,0xb6,0xed,0x0d,0xb8,0xc1,0xa8,0xff,0xe6,
+  0x19,0xd1,0x6a,0x0e,0x43,0xe2,0xef,0xa8,0xd2,0xa3,0xa2,0xe5,0x4a,0x77,0xef,0x34,0x8c,0xf1,0x75,0xee,0x87,0x44,0xbf,0x6c,
+  0x0a,0xeb,0xbe,0x09,0x68,0x2b,0x5a,0xc1,0xd9,0x15,0xf4,0x3c,0xfc,0x40,0x8b,0x4b,0x09,0x1f,0x13,0xf6,0xfd,0x6e,0xb7,0x28,
+  0x7e,0x84,0xad,0x41,0x4e,0xa0,0x1b,0x1b,0x8c,0x36,0x1b,0xfb,0xb3,0xbe,0x32,0x17,0x93,0x69,0x18,0x0f,0x02,0x9e,0x1b,0x46,
+  0xaa,0xde,0x00,0xe6,0xcd,0xa5,0xfc,0xa2,0x38,0xfe,0x2e,0xb4,0x0c,0x1a,0xdd,0x8a,0x83,0xf2,0xbc,0xde,0x82,0xdf,0x7b,0x88,
+  0x20,0x87,0x66,0xf9,0xe1,0xe1,0x97,0x70,0xff,0x1e,0xe1,0xa0,0xb4,0x09,0x94,0xd3,0xd3,0xc4,0x81,0xaa,0x61,0x0e,0xfe,0x28,
+  0xd6,0xe3,0xd3,0x3f,0x53,0xda,0xd9,0xb2,0x5e,0xff,0x03,0x60,0x19,0x2c,0x03,0x6c,0x0a,0x00,0x00,0x1f,0x8b,0x08,0x00,0x00,
+  0x00,0x00,0x00,0x02,0x03,0x5d,0x90,0x41,0x6e,0x83,0x30,0x10,0x45,0xf7,0x9c,0xe2,0xaf,0x2a,0xbb,0x22,0x88,0x38,0x5d,0x11,
+  0x1a,0x71,0x80,0xde,0x01,0x39,0xc1,0x46,0x96,0x88,0x1d,0x39,0x36,0xa2,0xaa,0x7a,0xf7,0x8e,0x81,0xd2,0xa4,0x1b,0xeb,0xfb,
+  0xcf,0xe8,0xcd,0xfc,0x69,0x7a,0xef,0xe2,0x8d,0x95,0x1c,0xcd,0xd9,0xd8,0xce,0xd8,0x3e,0xe9,0x51,0x7a,0xf4,0xd1,0xb4,0x41,
+  0x4d,0x21,0x7a,0x55,0x61,0x15,0xad,0xe8,0x6a,0x7d,0x10,0xa7,0x63,0xd6,0x8c,0xca,0x93,0x99,0x69,0x8b,0xf1,0xde,0x5e,0xa5,
+  0xb1,0xac,0x39,0x47,0x33,0x04,0x12,0x4b,0xa9,0x25,0x9c,0x9a,0x88,0xf5,0xf0,0xab,0x10,0x0f,0x82,0x63,0x77,0xc2,0xd6,0x7c,
+  0x73,0x77,0x13,0x8c,0xb3,0xa9,0xf1,0xf2,0xa6,0xf1,0x95,0x01,0x83,0x0a,0x88,0x23,0xde,0x93,0x25,0x34,0xa3,0x89,0xec,0x09,
+  0x8a,0xba,0xc6,0x3e,0x72,0xbc,0x40,0x44,0x9e,0x23,0xd5,0x9f,0xca,0xb3,0xcf,0x8f,0x44,0xf2,0x8a,0xd6,0xb6,0x0b,0x9a,0x11,
+  0xf2,0x15,0xa2,0x28,0xb1,0xc3,0xbe,0x28,0x73,0x94,0xe9,0x21,0x45,0x9d,0xdf,0x59,0xa3,0xbd,0xec,0xaf,0xca,0x86,0x14,0x49,
+  0xff,0x8f,0xf4,0xb7,0xe5,0xaf,0xaa,0x16,0xe8,0x12,0x66,0x70,0x17,0x99,0xcc,0xf9,0x76,0x5b,0x8c,0x75,0xf8,0x7a,0xbb,0x0f,
+  0x27,0x3b,0xf6,0x70,0xd4,0x7c,0x4e,0x67,0x36,0x74,0x31,0x7d,0x52,0x96,0x65,0x99,0x1f,0xfa,0x02,0x37,0xcb,0x96,0x01,0x00,
+  0x00,0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9d,0x56,0xdb,0x6e,0xdb,0x38,0x10,0x7d,0xf7,0x57,0xf0,0xa5,0x85,
+  0x14,0x3b,0xae,0x6f,0x5b,0x14,0xb6,0x23,0x78,0xbf,0xc3,0x30,0x04,0x9a,0xa2,0x1c,0xb6,0x92,0x68,0x50,0xa4,0xed,0x64,0xeb,
+  0x7f,0xef,0xf0,0xa6,0x5b,0x65,0x6d,0x9b,0x00,0x49,0x28,0x92,0x73,0xe6,0xcc,0xf0,0xcc,0x90,0xa5,0x14,0x8a,0x48,0xa4,0x0a,
+  0x96,0x72,0x91,0xc7,0xa5,0xfd,0xfc,0x6f,0x84,0x50,0xce,0x13,0x9a,0xc5,0x17,0x46,0xaf,0xf1,0x59,0xf0,0xef,0x94,0x48,0xc6,
+  0x8b,0x38,0xc7,0x52,0xb0,0xdb,0x1a,0xc1,0xff,0xd5,0x6d,0x95,0x4e,0x60,0x63,0x01,0x86,0x38,0x6b,0xae,0x2c,0x6f,0x4b,0x58,
+  0xb9,0x6f,0x46,0x0e,0x2e,0xa7,0xe5,0x6b,0x46,0x2d,0x2c,0xa1,0x85,0x14,0x74,0x8d,0x2e,0x94,0x2c,0x8d,0xb9,0xc0,0x09,0x53,
+  0xe5,0x1a,0xa5,0xcb,0x85,0xfe,0x24,0xbc,0xa0,0x31,0xbe,0xb1,0xb2,0xb1,0xc5,0xcc,0x11,0x25,0x79,0x9a,0x56,0xfb,0x2e,0x54,
+  0x48,0x7a,0x8b,0x61,0xaa,0xa4,0x72,0x8d,0x94,0x9d,0x05,0x0a,0xb8,0x38,0x65,0xb4,0x3b,0xef,0x76,0x13,0xae,0x8a,0x9e,0xcd,
+  0xcd,0xe9,0x9a,0x35,0x51,0x59,0x16,0xf7,0x24,0x86,0xe0,0x9c,0x0a,0x1c,0x9f,0x79,0xc9,0x74,0x4a,0x1a,0x3c,0x5d,0x9c,0x1d,
+  0x37,0xac,0x28,0x25,0x2e,0xc8,0x23,0x37,0x89,0xc0,0xd7,0x18,0x8b,0x93,0xca,0x21,0x33,0xa5,0xf1,0xd0,0x66,0x8b,0x25,0xcf,
+  0x19,0xd9,0x82,0x59,0xf4,0x10,0x0e,0xa1,0x94,0x89,0x52,0xc6,0xd6,0xb2,0x33,0xe9,0x2d,0x6a,0xd7,0xbb,0x93,0xe0,0xea,0x1c,
+  0xcc,0x42,0xb4,0x3b,0xb2,0x22,0x61,0xc5,0x49,0x8f,0x2f,0x58,0x6c,0x5d,0xbc,0x91,0x57,0x04,0x1c,0x43,0x3b,0x05,0x95,0xf1,
+  0x7c,0xc0,0xb8,0x99,0x3a,0x40,0xe8,0xc9,0x64,0x2f,0xcc,0xdc,0xc2,0x94,0x92,0x0b,0x7c,0xa2,0x13,0x24,0x28,0x4e,0x22,0x9f,
+  0x55,0xc0,0xc1,0x42,0xe0,0xb7,0xad,0xfb,0x8e,0x7a,0x21,0x16,0x43,0x10,0x26,0x3d,0x8c,0xd0,0x0a,0x4a,0xe7,0xb4,0x17,0x66,
+  0x39,0x08,0xe3,0x85,0xf3,0xff,0x38,0xab,0x5e,0x9c,0xea,0x08,0xad,0x4a,0x2b,0x98,0xf4,0x11,0xcc,0x3f,0x3d,0x30,0xf1,0x55,
+  0x30,0x49,0x23,0x74,0x61,0x25,0x3b,0x82,0x88,0xbb,0xb1,0x81,0x2a,0x17,0xaa,0x1f,0xee,0xeb,0x00,0x9c,0x97,0x23,0xe0,0xb4,
+  0x95,0xb9,0x19,0xa5,0x05,0x3a,0x41,0xf4,0x82,0x5f,0x03,0xf8,0x35,0x6a,0x0a,0xd1,0x73,0xa4,0xf5,0xbf,0x4a,0x8d,0x70,0x75,
+  0x91,0xe7,0xe8,0xa5,0x12,0xcf,0x74,0xa8,0x89,0x6c,0x74,0xf1,0x53,0xa9,0x44,0x61,0x11,0x82,0x7c,0x3f,0x3b,0xec,0x01,0xf9,
+  0x30,0x41,0xf9,0x7e,0x5e,0x0f,0x17,0xf5,0x70,0x69,0x87,0xe1,0x66,0x74,0xd7,0x74,0xb8,0x92,0x25,0x4b,0x68,0x7c,0xce,0x70,
+  0x41,0x03,0xf3,0x77,0x6d,0xc1,0x26,0x9d,0x46,0xd3,0x6c,0x33,0x86,0xf4,0x91,0xf3,0xcc,0x70,0x76,0x14,0x12,0x2e,0x2d,0xc0,
+  0xf4,0xf6,0xf6,0xee,0xad,0x43,0x34,0x46,0x76,0xf2,0x8a,0xb6,0xe8,0xd9,0x62,0xa0,0x27,0x88,0xb3,0x38,0xc9,0xd7,0x7a,0x7f,
+  0x97,0x4f,0x2a,0x54,0x29,0x55,0x1e,0xfc,0x29,0x07,0x9d,0x37,0x88,0x2b,0xbe,0x41,0xee,0x7c,0x8a,0x67,0x2a,0xdc,0x34,0x96,
+  0xde,0x1a,0x4b,0xf3,0xf6,0xd2,0x7b,0x63,0x69,0xd1,0x5e,0xba,0x36,0x96,0x96,0x76,0xc9,0xc5,0xdb,0x4e,0x9d,0xdd,0x3b,0xb6,
+  0x24,0x7c,0xf4,0x9e,0x70,0x08,0x56,0xfa,0xe7,0xe7,0xcf,0x5e,0xab,0xe7,0x0f,0x59,0x59,0x5f,0x6f,0x1f,0xf2,0xf5,0x77,0x56,
+  0x70,0x9a,0xfe,0xe7,0x03,0xbe,0xde,0x7f,0xf3,0xa5,0xcf,0x7a,0x47,0x78,0x7e,0x56,0x92,0xa2,0xdd,0x95,0x8b,0x1f,0xa6,0xc2,
+  0xe2,0x92,0xbd,0xd3,0xe0,0xeb,0x2a,0xd4,0x42,0x20,0x25,0x88,0x9c,0x15,0xc1,0xee,0xa8,0x58,0x26,0x61,0x70,0xca,0xf8,0x11,
+  0x2e,0x49,0x56,0x5c,0x38,0xc1,0xa6,0x08,0x58,0x12,0x22,0x96,0x58,0x6d,0xa8,0xb0,0x92,0x01,0xc9,0x40,0x3a,0x54,0xc0,0xb9,
+  0xb1,0x64,0x6a,0x6a,0x84,0xa5,0x81,0x9f,0x8c,0x5e,0xda,0xad,0x75,0xda,0xba,0x71,0x40,0x98,0xed,0xd5,0xf6,0x55,0x61,0x7d,
+  0x78,0x01,0x68,0xe4,0xbb,0xf3,0xe9,0xf7,0x81,0x53,0xef,0xe9,0xcb,0x90,0x23,0xaf,0x30,0xf9,0xca,0x20,0x4e,0x77,0xb9,0xbf,
+  0x54,0x8d,0x7a,0xef,0x41,0x3e,0x0d,0x81,0x1c,0x3c,0x8a,0x6d,0x82,0x60,0x6f,0xaa,0x24,0xe8,0x36,0xc7,0x7d,0xc5,0xee,0x09,
+  0x2d,0x15,0x74,0x81,0xe1,0x0d,0x20,0xac,0xf9,0x1f,0xed,0x5a,0xa8,0x43,0x55,0x2a,0xf6,0x84,0x81,0x42,0x33,0xa2,0xa9,0x9b,
+  0x1d,0x3b,0x86,0xee,0x2c,0xfa,0x6b,0x7c,0xd2,0x36,0x75,0x52,0x79,0x9c,0x72,0xc9,0xe3,0xca,0xa9,0x1b,0x3c,0x77,0xb2,0xd5,
+  0x79,0x67,0x38,0xf7,0xba,0x4f,0x55,0xc6,0x1d,0xaf,0xd5,0xdb,0x29,0xd4,0x4a,0xf9,0x7d,0xc9,0x3e,0xa1,0xea,0xfe,0x55,0xe1,
+  0xe8,0x3e,0xd7,0xc7,0xff,0x21,0x7d,0xf3,0xb0,0x00,0xea,0xf6,0x6d,0xf2,0x6f,0x92,0x04,0x9f,0xab,0x8b,0x63,0xda,0x7c,0xbe,
+  0x74,0x18,0xb6,0x9f,0x5c,0xe6,0x28,0xcc,0x21,0x40,0xc4,0x01,0x5c,0x49,0xd5,0x93,0x0c,0xa0,0x67,0x6a,0x53,0x7f,0x6e,0x87,
+  0x60,0xea,0x7d,0xe3,0xb1,0xa7,0xac,0x49,0x9e,0x31,0xf9,0x41,0x93,0x5a,0x98,0xf5,0xbd,0xbd,0xef,0x47,0x73,0x4a,0x1c,0x57,
+  0x78,0x46,0xa3,0x35,0x3b,0xc2,0x45,0x61,0x4a,0x53,0x73,0x73,0x1f,0x5b,0x08,0xc1,0x7f,0xd4,0xee,0x2d,0x81,0x0c,0x6a,0x5d,
+  0xd7,0x7c,0x42,0x75,0x63,0x0f,0x1c,0x9f,0x28,0x42,0x81,0x33,0x7e,0x42,0xdf,0x14,0x88,0xe4,0x33,0x9a,0xdd,0xd2,0x54,0x6d,
+  0x9c,0x69,0xf7,0x46,0xdf,0xdb,0x6c,0xd7,0xb4,0xbc,0x84,0x2d,0xca,0xc1,0x96,0xce,0x42,0x05,0xdd,0x67,0x4e,0x3b,0xcc,0xd6,
+  0x8b,0x19,0xac,0x1b,0xec,0x1a,0xf5,0x12,0x5a,0x16,0x77,0x73,0xd8,0xf7,0xd1,0x2f,0x3d,0x4e,0x0a,0xb2,0x20,0x0c,0x00,0x00,
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x85,0x17,0xcb,0x72,0xa3,0x38,0xf0,0x9e,0xaf,0xd0,0x69,0x0b,0x1c,0xcc,
+  0x18,0x6c,0xcf,0x24,0xb6,0x27,0x95,0xc3,0x1e,0xf7,0xb6,0x1f,0x40,0x61,0x10,0x0e,0x55,0x20,0x5c,0x48,0x38,0x9e,0xd9,0xc9,
+  0xbf,0x6f,0xab,0x85,0x04,0x12,0xd8,0xbe,0x18,0xdc,0xef,0x77,0x37,0xcd,0x85,0xb6,0x6d,0x99,0x53,0x22,0x1a,0x46,0xeb,0xf4,
+  0x9c,0x50,0x96,0x1e,0x2b,0x9a,0xef,0xc8,0xb1,0x69,0x2a,0xf2,0x93,0x88,0xb6,0xa3,0xfb,0xa7,0x46,0x93,0x15,0xd7,0x34,0x7d,
+  0x44,0x93,0x35,0x55,0xd3,0xb5,0xc9,0xa9,0x4d,0x73,0x3a,0xa1,0x2d,0xd2,0x8a,0x8f,0x89,0x2f,0xe5,0x89,0x51,0x21,0xe8,0x0d,
+  0xa1,0x1c,0x1e,0x99,0x20,0xe7,0x86,0x8b,0xe4,0xdc,0x36,0x19,0xe5,0x3c,0xe9,0x58,0x59,0x34,0x6d,0xcd,0xc9,0x7f,0x4f,0x84,
+  0x94,0x0c,0x24,0x71,0x9a,0xf0,0xf2,0x37,0xdd,0x91,0x0b,0xcd,0xe2,0x22,0x00,0x30,0xbd,0x02,0x4b,0xd7,0x02,0xa8,0x58,0xc7,
+  0x12,0x60,0x19,0x05,0x52,0x29,0x3b,0x89,0x0f,0x83,0x35,0x56,0xdc,0xc6,0x00,0x63,0xd9,0xf1,0x1e,0xfe,0xb5,0x7f,0x7a,0x3f,
+  0xb5,0x4d,0x77,0xf6,0x56,0x3e,0x79,0x3f,0x96,0x2c,0x2f,0xd9,0x49,0xbe,0x5f,0xd2,0x16,0x4c,0x3a,0x77,0x22,0x11,0xf4,0x2a,
+  0xd0,0x80,0xfe,0x25,0x89,0xf3,0x03,0xf0,0xbe,0xcd,0x72,0x46,0x63,0x4e,0x9e,0xd6,0xe7,0x8a,0xb6,0x3b,0xd2,0xbf,0xcc,0x72,
+  0xc4,0x8a,0xc3,0x72,0xab,0xea,0xc4,0xa0,0x6e,0x7d,0x47,0xdd,0x1a,0x99,0x0f,0x7d,0x20,0xdf,0x88,0x8e,0xe8,0x6e,0x3e,0xd0,
+  0xfb,0xa7,0xac,0x61,0x5c,0xf4,0xc9,0xcf,0x4f,0x34,0x11,0x1f,0x2d,0xe5,0x1f,0x4d,0x95,0x43,0xa2,0x56,0x61,0x14,0x6f,0xef,
+  0x90,0x24,0x75,0xc9,0x90,0x6c,0xb5,0x8e,0x62,0x8b,0xae,0xa5,0x79,0x97,0xd1,0xa4,0xee,0x2a,0x51,0x9e,0xab,0x92,0xb6,0xb3,
+  0xd2,0x34,0x95,0x96,0xb2,0xfa,0xf1,0xe2,0x92,0xf0,0x73,0xca,0x92,0x3a,0xbd,0x02,0xc1,0x4b,0xb8,0x02,0x97,0xa1,0x26,0x20,
+  0x0e,0x4f,0x05,0x23,0x17,0x0e,0x88,0x92,0x79,0xef,0xc7,0xae,0x04,0x35,0xcc,0x53,0xa8,0x04,0x22,0x41,0xaf,0x10,0x86,0xd1,
+  0xbf,0x1d,0xe9,0xd6,0x10,0xd6,0xe5,0x1b,0x31,0xc4,0x10,0x8e,0x52,0x94,0x0d,0x93,0x84,0xd9,0xa6,0xc0,0x8a,0xab,0xa8,0x20,
+  0xdd,0x05,0x54,0x61,0xb1,0x79,0x10,0x64,0xcf,0x12,0x4a,0x0e,0x07,0x12,0x75,0x3e,0xf9,0x8b,0xc4,0x9d,0x1f,0xc8,0x7a,0xb1,
+  0xd1,0x08,0xf7,0xf7,0x20,0xa9,0xa5,0x90,0x29,0xa6,0x44,0x7b,0x20,0x72,0x41,0xe2,0x70,0x45,0x96,0x24,0x0a,0x57,0x81,0xf4,
+  0x34,0x90,0x6f,0x40,0xf9,0x25,0x1d,0xe9,0x1b,0xd4,0x53,0x19,0xc7,0x52,0x5f,0x17,0x68,0x2d,0xbe,0x19,0xd3,0xb0,0xf2,0xa9,
+  0x4c,0x8c,0xa2,0x04,0xa9,0x3a,0x8f,0xa1,0xee,0x8a,0x91,0x72,0x9e,0xc2,0x23,0x15,0xd4,0xf3,0x34,0xe3,0x82,0x78,0x71,0xb8,
+  0x8d,0xe0,0xa9,0x21,0xcf,0x98,0x3c,0xdf,0x27,0xdf,0x88,0x4d,0xb5,0x59,0x3b,0x54,0xdb,0x57,0x1f,0x9f,0xd1,0xc6,0xd7,0x76,
+  0x73,0xb0,0x21,0xa3,0xe0,0x5e,0xdf,0x9d,0x33,0x26,0xf7,0x86,0xfe,0xd4,0xb5,0xfb,0x2f,0xd6,0xfd,0x3f,0xf4,0x42,0x2b,0xcf,
+  0x6a,0xa6,0xc0,0xee,0x90,0x00,0xf2,0x80,0x81,0xf2,0xc3,0xf6,0x74,0x94,0x4e,0x95,0x85,0x3b,0xc8,0x50,0x89,0xf1,0xd6,0x0e,
+  0x22,0x26,0xe1,0x6b,0x26,0x16,0x06,0x8d,0x1e,0x54,0x5d,0x9d,0xce,0x84,0x1d,0x12,0x8b,0xc2,0x7b,0xe6,0xbc,0x11,0x3d,0x51,
+  0xa0,0x88,0xbc,0x55,0x18,0xbf,0xbe,0x4a,0xfb,0xb6,0x2f,0x3f,0xe4,0x23,0x1a,0x45,0x45,0x96,0xed,0xdd,0x98,0x80,0xc7,0x54,
+  0x8e,0x41,0x93,0xbb,0xf1,0xa0,0xdb,0xeb,0xc0,0x51,0x06,0xf3,0x0a,0xa8,0x4c,0x90,0x7d,0x8d,0x92,0x46,0x27,0x06,0xaf,0x5c,
+  0xc0,0x7f,0x36,0x05,0xfb,0xd4,0x58,0x23,0x02,0x12,0xa8,0x2a,0x7b,0x89,0x75,0x28,0x7f,0x7d,0x48,0x33,0x1a,0xe4,0x3b,0xdc,
+  0xf4,0x36,0x37,0x79,0xc8,0xcd,0x1f,0xea,0x26,0xf7,0xb8,0x1f,0xea,0xbe,0xc7,0xad,0xa6,0x09,0xfc,0x7a,0xa3,0x40,0x05,0x08,
+  0x30,0x40,0xf6,0x19,0x68,0x37,0xfd,0x60,0xa0,0xe5,0x1a,0xcc,0xa9,0xef,0x4a,0xc5,0x11,0x04,0xbf,0x8e,0x54,0x00,0x18,0xa0,
+  0x23,0x55,0x83,0xa7,0x52,0xa1,0x96,0x8d,0xd0,0xe5,0x60,0xf5,0x01,0x79,0x6e,0xcc,0xd9,0x60,0x60,0x59,0xcc,0xcd,0x62,0xdf,
+  0x6e,0x07,0x65,0xa0,0xee,0x02,0xe9,0x46,0x5e,0xb6,0x34,0x93,0x13,0x0f,0x86,0x3f,0xcf,0xd2,0x0a,0x07,0x49,0x9f,0x12,0x4f,
+  0x3b,0x00,0x71,0xd6,0x1e,0x80,0x65,0xda,0x7e,0x0d,0x95,0x0e,0x04,0xc4,0xa5,0xe5,0x9f,0x03,0x2d,0x94,0xcd,0x88,0x76,0x3f,
+  0x51,0xad,0x26,0x7e,0x1f,0xc9,0xa9,0xd2,0x41,0xe4,0x48,0x0c,0xf8,0x0b,0xfd,0xb6,0xd5,0x6e,0x4f,0x56,0x4b,0xe0,0x2e,0x93,
+  0x19,0xbd,0xe8,0x30,0xa8,0x85,0xba,0x91,0xa3,0x4e,0x66,0x3c,0x3d,0x72,0x6f,0x1a,0x93,0xf0,0x0a,0x1e,0xde,0x40,0xfd,0xf2,
+  0xe5,0x08,0x74,0x9d,0x99,0x6a,0x93,0x03,0xba,0x82,0x39,0x36,0x23,0x03,0x9c,0x70,0x8c,0x0a,0x74,0x0e,0xac,0x75,0xe7,0x6b,
+  0xb0,0x0d,0x35,0x35,0xaf,0x75,0x32,0x9a,0xaa,0xd5,0x2a,0xc3,0x63,0xb5,0xcb,0x60,0x0d,0x20,0x94,0xdb,0x6b,0x5c,0x41,0x40,
+  0x8b,0x7e,0xdc,0x24,0x8e,0x5d,0x62,0xe3,0x61,0x81,0xca,0x50,0xe7,0x02,0x75,0x3e,0xeb,0xcc,0x8c,0x54,0x2f,0x2d,0x69,0x52,
+  0xc0,0x1d,0x65,0x28,0xdf,0x6a,0x34,0xa5,0x03,0xbb,0x1f,0x5e,0xad,0x76,0x91,0xa8,0xc3,0xd0,0x2e,0x7f,0xfe,0x0c,0xe0,0xb7,
+  0xa1,0x3b,0xac,0x36,0x90,0xb6,0x3a,0xab,0xa0,0x90,0x10,0x9c,0xd4,0xe3,0x0b,0xeb,0xe1,0xf2,0xad,0xe4,0x72,0x82,0x01,0x2d,
+  0x0f,0x5d,0xd8,0xfb,0xfd,0xda,0xfa,0xbb,0xac,0x29,0xe3,0xe0,0x0b,0xf7,0xdc,0x7b,0xcd,0x87,0x52,0xda,0x9b,0xa3,0x42,0x0e,
+  0x44,0xcf,0xac,0x6d,0xcf,0x48,0x5b,0xaa,0x51,0xf6,0xac,0x02,0xf5,0xcd,0xa8,0xd1,0x9c,0x28,0x2e,0x9f,0x5f,0xa0,0xae,0xc6,
+  0x99,0x1d,0xfa,0x69,0x2f,0xd1,0x3e,0x04,0x75,0x79,0x35,0x0b,0x4d,0x29,0x08,0x86,0x6d,0x34,0x7b,0x4e,0xeb,0xe5,0xa6,0x6f,
+  0x66,0x3b,0x5c,0x52,0xd3,0xbd,0x1b,0xa0,0x65,0xb4,0x4d,0xf2,0x92,0x8b,0x94,0x61,0xf3,0x57,0x28,0x53,0x15,0x0b,0xfa,0xbd,
+  0x80,0x28,0x6c,0xa2,0x4d,0x1c,0xad,0xb7,0xdf,0x47,0x76,0x0e,0xf1,0x8a,0xb0,0x1a,0x8d,0x8d,0x93,0xa3,0x1e,0x68,0x78,0xdd,
+  0x34,0xe2,0x83,0x0b,0x7a,0xf6,0xa6,0x74,0xea,0xc4,0x0f,0xd4,0xf6,0x70,0x0c,0x52,0x9b,0xfb,0xbd,0x68,0xd3,0x13,0x24,0x53,
+  0xe0,0x0e,0x77,0x4f,0xcb,0xe1,0x5a,0xd4,0x6f,0x3b,0x75,0xdc,0xa9,0xa3,0xb2,0x6a,0xb2,0x54,0x02,0xf1,0x3b,0x61,0x7a,0x4e,
+  0x6a,0x9e,0xf0,0xfa,0x6b,0x7c,0xb3,0xb9,0x7b,0x7f,0xb8,0xfa,0xfb,0xb8,0xf6,0xc5,0x3f,0xfe,0x32,0xeb,0xcb,0xdb,0xdc,0x55,
+  0xfd,0xb5,0xa1,0xee,0x1d,0x42,0xe1,0x0b,0xcc,0xa5,0xb0,0x0f,0x88,0x2f,0x25,0x72,0xee,0x43,0xce,0x65,0x9c,0x69,0x8f,0xb1,
+  0x08,0xf7,0xf3,0xce,0x65,0x77,0x4a,0x45,0xd6,0x88,0x7b,0x95,0xa9,0xf3,0x58,0xe3,0xf5,0x45,0xfc,0x3f,0x57,0x14,0xfc,0x1e,
+  0xb9,0x0e,0x00,0x00,0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9d,0x57,0xdd,0x6e,0xeb,0x36,0x0c,0xbe,0xcf,0x53,
+  0x68,0x17,0xa7,0xb0,0xcf,0x71,0xdc,0xc4,0x49,0xbb,0x2e,0x6d,0x83,0x3e,0xc0,0xde,0xa0,0x28,0x0c,0xd5,0x96,0x1b,0x6d,0xb6,
+  0x95,0xc9,0x72,0x9a,0x6c,0xe8,0xbb,0x8f,0x14,0x25,0xc5,0x4e,0xd2,0x83,0x6e,0x40,0xe0,0x5a,0x16,0xc5,0x9f,0xef,0x23,0x29,
+  0xb6,0x33,0xba,0x2f,0x0c,0xeb,0x5b,0x59,0x29,0xdd,0xe4,0x1d,0x2d,0xff,0x99,0x30,0xd6,0xa8,0x52,0xd4,0xf9,0x4e,0x8a,0xf7,
+  0x7c,0xab,0xd5,0x1f,0xa2,0x30,0x52,0xb5,0x79,0xc3,0x8d,0x96,0xfb,0x15,0x83,0xbf,0xcb,0xfd,0xb2,0x4a,0x40,0xb0,0x85,0x83,
+  0xbc,0x1e,0xee,0x2c,0xf6,0x0b,0xd8,0xf9,0xb8,0x9f,0x38,0x75,0x46,0x68,0xcd,0x65,0x9b,0x5f,0xb0,0x62,0x34,0x6f,0xbb,0x9a,
+  0xa3,0xee,0x15,0xdb,0x89,0x62,0x61,0x55,0x76,0x5b,0x5e,0xc8,0xf6,0x6d,0xc5,0xaa,0x45,0x86,0x6b,0xf4,0x42,0x68,0x2b,0x90,
+  0x59,0x81,0x77,0xd9,0x96,0xea,0xbd,0x5b,0x31,0x0e,0x9a,0x0f,0x0f,0xf0,0x7d,0x29,0x13,0x76,0xb7,0xbe,0x64,0x75,0xcb,0x4d,
+  0xb1,0xb1,0xc6,0x94,0x96,0x6f,0x92,0xec,0x64,0xd2,0xda,0x91,0x7f,0x0b,0x5a,0xf6,0xb8,0xac,0xc5,0x4e,0xd4,0x2b,0xd6,0xa3,
+  0xd1,0xa3,0x9e,0x9d,0xd0,0x46,0xec,0x73,0xd5,0x9b,0x6d,0x4f,0x4e,0x3f,0xbd,0xf6,0xb2,0x36,0xb2,0x8d,0xb6,0xaa,0x93,0xe8,
+  0x7a,0xcc,0xfc,0x9b,0xd5,0x46,0xb8,0x3c,0xd5,0xaa,0xb0,0x81,0x45,0xb3,0xd8,0x81,0x34,0x08,0xf1,0xb8,0x3b,0x8f,0xd9,0x46,
+  0xc8,0xb7,0x8d,0x09,0xe1,0x1e,0xf7,0xb2,0x98,0x75,0x46,0x88,0x6d,0x2b,0xba,0xce,0x6d,0x83,0x63,0x4f,0x6f,0x5a,0xf5,0x5b,
+  0x54,0xfb,0xf4,0x0a,0x40,0x00,0x52,0xf8,0xbe,0xe3,0xfa,0xc1,0x21,0xbc,0xf6,0x84,0xc2,0xa1,0x31,0xe8,0xe1,0xf0,0xfc,0x27,
+  0x87,0x1d,0x72,0xab,0x4f,0x88,0xbb,0xa8,0x63,0x6e,0x75,0xb8,0x48,0x1a,0xbe,0xc5,0xc3,0x7b,0xd3,0x6b,0x91,0x67,0x65,0x4e,
+  0x2c,0x81,0xfb,0xeb,0x8b,0x67,0x33,0xb2,0xdf,0x19,0xa5,0xf9,0x9b,0x48,0x98,0x16,0xbc,0x5c,0x33,0xcb,0x9b,0x08,0x1c,0x8f,
+  0xe8,0x04,0x3d,0x0a,0x78,0xd1,0xb2,0x14,0xc4,0x5a,0x5e,0xa8,0xbe,0x35,0x96,0x3b,0xf6,0xc8,0x6e,0xfb,0xb3,0x7d,0xa2,0x9a,
+  0xb6,0xe7,0xd9,0x48,0xc0,0x3b,0x3a,0x16,0xb9,0x03,0x91,0x42,0xb5,0x9d,0x61,0x35,0x86,0x94,0x97,0x52,0xc3,0x77,0xcb,0x5f,
+  0x34,0x4b,0xef,0x7e,0xcd,0xe0,0x97,0xb0,0x59,0x9a,0xcd,0xef,0xe0,0x97,0xb0,0xe9,0x2c,0x5d,0x2e,0x6e,0xe1,0x17,0xfb,0x73,
+  0xbc,0x79,0x95,0xa2,0x35,0x70,0x6a,0x96,0xde,0x54,0xf7,0x93,0xaa,0x75,0xf0,0xe4,0xdc,0x44,0x83,0x5c,0x63,0x1d,0x6f,0xb6,
+  0xb5,0x4b,0x44,0x19,0xb3,0xe9,0x1a,0x99,0xb6,0x99,0x56,0x0b,0xe3,0x72,0x3d,0xaf,0xa4,0xee,0x50,0x97,0xc3,0x21,0x75,0x25,
+  0xf0,0x6c,0x15,0xbd,0xa4,0xfb,0xc3,0xbd,0x93,0x87,0x70,0x44,0x0d,0x82,0x45,0x0d,0x6a,0x23,0xd2,0x9d,0x8c,0xb4,0x8c,0x57,
+  0xec,0x07,0x93,0x8b,0x2c,0x1a,0xa2,0x00,0x3e,0x30,0x20,0xe8,0x8a,0x3c,0x8a,0x2e,0x6f,0xa3,0x3d,0x2d,0xe0,0x63,0xeb,0x11,
+  0xfc,0x5d,0xf1,0x32,0x0a,0x19,0x90,0x90,0x27,0x89,0xd5,0x6e,0xbd,0x8c,0x01,0xaf,0x38,0xd5,0xf7,0x93,0x0f,0xc4,0xa2,0x50,
+  0x5c,0x77,0x42,0xe7,0xff,0x07,0x13,0x77,0x16,0xa2,0xb4,0x67,0x20,0x84,0x79,0xef,0xe3,0xdf,0xf0,0xba,0xca,0xe9,0x38,0xec,
+  0xbb,0x97,0xf5,0x9a,0xca,0x3c,0x9a,0xf7,0xb1,0x17,0x54,0x65,0x09,0x02,0x0e,0xa1,0x10,0xec,0x3c,0x8e,0xd9,0x2f,0x8f,0x6e,
+  0x31,0xb3,0xc2,0xb2,0x8a,0x40,0x36,0xdd,0xb3,0xab,0x2b,0x3c,0x94,0x1e,0x62,0xeb,0x48,0x08,0x3f,0x3a,0x86,0xe0,0x1c,0x4b,
+  0x46,0x5e,0xfc,0xf0,0xaa,0x31,0xfe,0x18,0x96,0x5f,0x94,0x9f,0x25,0x00,0x33,0x1c,0xf8,0x8e,0x09,0x84,0x8e,0x7c,0x4c,0xbe,
+  0x6a,0xf3,0x3f,0x58,0x81,0x88,0x06,0x46,0x2c,0x35,0x8d,0xd2,0xdb,0x4d,0x5e,0xf1,0x02,0x2a,0xf2,0x8b,0xac,0x00,0x46,0x47,
+  0x2a,0xd8,0xfa,0x71,0x58,0x96,0x27,0x70,0xcd,0xd2,0x99,0x0f,0x06,0x69,0xa8,0xb4,0x6a,0x72,0xea,0xf0,0x40,0x07,0x7f,0xed,
+  0x22,0xdb,0xe6,0x23,0x1f,0xc8,0x34,0xa4,0xbc,0x13,0xba,0x66,0x91,0xff,0xe2,0x2e,0x0a,0x70,0x1e,0xfc,0x00,0x6e,0xd9,0xc3,
+  0x03,0x19,0x86,0x88,0xc6,0xf9,0x00,0x69,0x0b,0xda,0x2b,0x9f,0x8a,0x2e,0x8f,0x03,0xb2,0x54,0x68,0xa5,0xd9,0x7c,0x22,0x34,
+  0xf7,0x42,0x04,0x4a,0x28,0xaf,0x68,0xe8,0xfd,0x14,0x58,0x09,0xc6,0xa6,0x4e,0x1f,0x94,0x4a,0x8a,0xac,0x5f,0xd3,0x3a,0xa1,
+  0x4b,0x0c,0x5a,0xc8,0x2c,0xf6,0xef,0x56,0x60,0x50,0x4e,0x0d,0xdf,0x47,0x64,0x27,0xdd,0x27,0xce,0x22,0x24,0x1d,0x92,0xf3,
+  0x44,0xb7,0x11,0x92,0xb4,0xeb,0xe0,0xce,0x85,0x4b,0x28,0xdc,0x46,0xee,0xa2,0x82,0xd2,0x16,0xfb,0x98,0x0d,0x57,0x8e,0xbd,
+  0x20,0x29,0xa1,0x3d,0xf1,0xb6,0x10,0x5e,0x76,0xbc,0xb6,0xd2,0x96,0xdc,0xf3,0xab,0xcf,0x36,0x98,0x8d,0xec,0xdc,0xad,0xfa,
+  0xe8,0xbb,0xf4,0xf3,0x58,0xc5,0x0b,0x46,0x83,0xf7,0xc1,0x5f,0x3d,0x2f,0x21,0x09,0x74,0x2b,0x74,0x87,0xec,0x62,0x2b,0x8f,
+  0x42,0x76,0x7b,0x08,0x5c,0xaa,0x27,0xc3,0x3a,0xb9,0xb8,0x38,0x15,0x9b,0x1f,0x69,0x46,0x4b,0xb6,0x41,0x1f,0xc3,0x06,0xcc,
+  0x6f,0x43,0x5b,0x08,0x1d,0xe1,0xe8,0x7e,0x4a,0x03,0x41,0xa8,0x04,0xea,0x10,0x56,0xd1,0xb7,0xa1,0x18,0xf2,0x89,0x4c,0xd8,
+  0x9d,0xeb,0xf3,0x1d,0x5b,0xd3,0xc3,0x48,0x9f,0x47,0x5e,0x7c,0x03,0x2f,0x5e,0xbc,0x1b,0x54,0x24,0x23,0x2f,0xec,0xa7,0xe0,
+  0xa6,0xcb,0xe8,0x63,0xa3,0xff,0x3c,0xc7,0x3d,0xc8,0x54,0xe8,0x70,0xe4,0xa4,0x95,0xfa,0x7a,0x0d,0x18,0xd9,0xba,0x06,0xb9,
+  0xf3,0xfa,0x1e,0x89,0x42,0x2d,0x93,0xe4,0x1a,0x6b,0xd5,0x57,0x6f,0xb0,0xd2,0xc8,0xbd,0xeb,0x3e,0xc9,0x67,0x4d,0x3c,0xa8,
+  0x4b,0xc8,0x56,0x3c,0x2c,0xf8,0xae,0x56,0x5b,0x41,0x77,0x29,0x24,0xff,0x40,0xf7,0xd9,0xf1,0xd3,0xce,0x39,0xfd,0x54,0x70,
+  0x3a,0x12,0x4c,0xbe,0xa4,0x94,0xda,0xeb,0x17,0x94,0x92,0x20,0x2a,0x0d,0x48,0xd2,0x3c,0x07,0x41,0xd0,0x0b,0xa4,0x41,0x44,
+  0xa3,0xc1,0xd4,0x46,0x87,0xd9,0x92,0xa5,0x33,0xe0,0xcc,0xb1,0x07,0xf3,0x01,0x6d,0x1c,0xe2,0x40,0x1b,0x94,0xd5,0x6a,0x5c,
+  0x62,0xb8,0x03,0x6f,0xa9,0x9f,0x26,0x41,0xbf,0x1f,0xe4,0xd2,0x9f,0xcd,0xe3,0x60,0xc7,0x8e,0x9d,0xce,0x07,0xcc,0x13,0x0a,
+  0x01,0x72,0x73,0xe8,0x83,0x67,0x6d,0x20,0x70,0x18,0x08,0x60,0x1a,0xfb,0xac,0x1b,0x0c,0xe6,0x89,0xed,0x60,0xde,0xb7,0x10,
+  0x79,0xf0,0x6c,0xf4,0x0f,0x00,0x68,0xa3,0xb5,0x97,0x3f,0x49,0x4e,0xff,0x39,0x8c,0xb5,0x38,0x6c,0x01,0x52,0x53,0x77,0x2c,
+  0x3d,0x0c,0x1a,0xa1,0x42,0x48,0xa0,0xe9,0x55,0x30,0x17,0x36,0x30,0x4a,0x61,0xdb,0xab,0x5c,0xdb,0xa3,0x41,0x7e,0x00,0x9e,
+  0xed,0x58,0xa3,0xa1,0xdb,0x62,0x12,0xda,0xd6,0x9b,0xe6,0xd6,0x9a,0x1f,0xe1,0xb2,0x1b,0x1c,0xdf,0x96,0xf6,0x39,0xbf,0x09,
+  0xcc,0x6a,0x55,0xfc,0x39,0x90,0xa2,0xfd,0x25,0x3e,0x16,0x47,0xa1,0xae,0x55,0xef,0x03,0xa1,0xdf,0xac,0x10,0x3e,0x3d,0x52,
+  0xc8,0x6f,0xa1,0x6a,0xd5,0x6b,0x57,0x30,0xd6,0x7a,0x62,0xb5,0x43,0x7e,0x35,0x4a,0x99,0x0d,0x40,0x00,0x43,0x3c,0xd8,0x76,
+  0x16,0xb0,0xd6,0x3d,0x2a,0x94,0x25,0x23,0x0d,0xb4,0x48,0xac,0xed,0x91,0x8a,0x0c,0x8a,0x34,0x61,0x0b,0xfb,0x04,0x1d,0x84,
+  0x33,0xd2,0x1a,0x11,0xb0,0x23,0x6b,0x0b,0x34,0x76,0x73,0x6a,0x2c,0x04,0x56,0xca,0xaa,0xea,0x3b,0xec,0xe2,0x46,0xb4,0x90,
+  0x84,0x07,0x9c,0x90,0xf0,0x3e,0x2a,0x95,0x89,0x8e,0xb9,0x0e,0xa7,0x69,0x01,0x05,0x1e,0xc6,0x63,0x1c,0xef,0xb0,0x5d,0x04,
+  0xc3,0x6e,0x00,0xb6,0xed,0xd1,0xbd,0x0f,0xc8,0xa5,0x8c,0x75,0x21,0x7e,0x3f,0xb7,0xec,0xc1,0xfc,0x98,0xfc,0x0b,0xe3,0xf7,
+  0xb1,0x75,0xa5,0x0e,0x00,0x00,
+};
+
+inline constexpr unsigned int unique_count{5};
+
+inline constexpr entry index[]{                                                // name, unique id, offset, compressed size, size
+  {"render/shaders/default.wgsl", 0, 0, 859, 2668},
+  {"render/shaders/gui_composite.wgsl", 1, 859, 246, 406},
+  {"render/shaders/meshlet_cull.wgsl", 2, 1105, 959, 3104},
+  {"render/shaders/post_process.wgsl", 3, 2064, 1180, 3769},
+  {"render/shaders/terrain.wgsl", 4, 3244, 1322, 3749},
+};
+
+} // namespace embedded::blob
@@ -0,0 +1,61 @@
+#include "resources.h"
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+#define ZLIB_CONST
+#include <zlib.h>
+#include "blob.h"
+
+namespace embedded {
+
+namespace {
+
+static_assert(std::ranges::is_sorted(blob::index, {}, &entry::name), "The resource index must be sorted by name for lookup");
+
+[[noreturn]] void fail(std::string const &message) {
+  /// Report an unrecoverable problem with the embedded data
+  #ifdef __cpp_exceptions
+    throw std::runtime_error(message);
+  #else
+    (void)message;
+    std::abort();
+  #endif // __cpp_exceptions
+}
+
+std::string decompress(entry const &this_entry) {
+  /// Inflate a single gzip member from the blob
+  std::string result;
+  result.resize_and_overwrite(this_entry.size, [&](char *data, size_t size){
+    z_stream stream{};
+    stream.next_in = blob::data + this_entry.offset;
+    stream.avail_in = this_entry.compressed_size;
+    stream.next_out = reinterpret_cast<Bytef*>(data);
+    stream.avail_out = static_cast<uInt>(size);
+    if(inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) return size_t{0};         // 16 selects gzip rather than zlib framing
+    auto const status{inflate(&stream, Z_FINISH)};
+    inflateEnd(&stream);
+    if(status != Z_STREAM_END) return size_t{0};
+    return static_cast<size_t>(stream.total_out);
+  });
+  if(result.size() != this_entry.size) fail("Embedded resource " + std::string{this_entry.name} + " is corrupt");
+  return result;
+}
+
+}
+
+std::string const &get(std::string_view name) {
+  /// Return the contents of an embedded resource, decompressing it on first access
+  /// The returned string lives for the rest of the program, so its c_str() can be handed straight to APIs
+  static std::vector<std::optional<std::string>> cache(blob::unique_count);      // indexed by unique id, so duplicates decompress once
+
+  auto const it{std::ranges::lower_bound(blob::index, name, {}, &entry::name)};
+  if(it == std::end(blob::index) || it->name != name) fail("Embedded resource " + std::string{name} + " not found");
+
+  auto &cached{cache[it->unique_id]};
+  if(!cached) cached = decompress(*it);
+  return *cached;
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace embedded {
+
+struct entry {
+  /// Index entry for one embedded resource, generated by compile_resource_blob.sh
+  std::string_view name;                                                        // path of the source file, relative to the project root
+  uint32_t unique_id;                                                           // identical resources share an id, and their data
+  uint32_t offset;                                                              // start of the gzip member in the blob
+  uint32_t compressed_size;
+  uint32_t size;
+};
+
+std::string const &get(std::string_view name);
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdlib>
 #include <string>
 #include <emscripten.h>
 
@@ -18,11 +19,14 @@ namespace emscripten_browser_clipboard {
 /////////////////////////////////// Interface //////////////////////////////////
 
 using paste_handler = void(*)(std::string&&, void*);
+using paste_buffer_handler = void(*)(char*, size_t, void*);
 using copy_handler = char const*(*)(void*);
 
 inline void paste(paste_handler callback, void *callback_data = nullptr);
+inline void paste_buffer(paste_buffer_handler callback, void *callback_data = nullptr);
 inline void copy(copy_handler callback, void *callback_data = nullptr);
 inline void copy(std::string const &content);
+inline void copy(char const *content);
 
 ///////////////////////////////// Implementation ///////////////////////////////
 
@@ -37,6 +41,24 @@ EM_JS_INLINE(void, paste_js, (paste_handler callback, void *callback_data), {
   });
 });
 
+EM_JS_DEPS(emscripten_browser_clipboard, "$lengthBytesUTF8,$stringToUTF8");
+
+EM_JS_INLINE(void, paste_buffer_js, (paste_buffer_handler callback, void *callback_data), {
+  /// Register the given callback to handle paste events without intermediate copies. Callback data pointer is passed through to the callback.
+  /// The text is written as UTF-8 straight into a single heap allocation sized for it, whose ownership passes to the callback.
+  /// Paste buffer handler callback signature is:
+  ///   void my_handler(char *paste_data, size_t size, void *callback_data = nullptr);
+  /// where paste_data is null terminated, size excludes the terminator, and the handler must free() paste_data when done with it.
+  document.addEventListener('paste', (event) => {
+    const text = event.clipboardData.getData('text/plain');
+    const size = lengthBytesUTF8(text);
+    const paste_data = _emscripten_browser_clipboard_detail_paste_allocate(size + 1);
+    if(!paste_data) return;
+    stringToUTF8(text, paste_data, size + 1);
+    _emscripten_browser_clipboard_detail_paste_buffer_return(paste_data, size, callback, callback_data);
+  });
+});
+
 EM_JS_INLINE(void, copy_js, (copy_handler callback, void *callback_data), {
   /// Register the given callback to handle copy events. Callback data pointer is passed through to the callback.
   /// Copy handler callback signature is:
@@ -60,6 +82,11 @@ inline void paste(paste_handler callback, void *callback_data) {
   detail::paste_js(callback, callback_data);
 }
 
+inline void paste_buffer(paste_buffer_handler callback, void *callback_data) {
+  /// C++ wrapper for javascript paste call, handing over ownership of a single buffer rather than copying through a std::string
+  detail::paste_buffer_js(callback, callback_data);
+}
+
 inline void copy(copy_handler callback, void *callback_data) {
   /// C++ wrapper for javascript copy call
   detail::copy_js(callback, callback_data);
@@ -70,6 +97,11 @@ inline void copy(std::string const &content) {
   detail::copy_async_js(content.c_str());
 }
 
+inline void copy(char const *content) {
+  /// C++ wrapper for javascript copy call, for null terminated content
+  detail::copy_async_js(content);
+}
+
 namespace detail {
 
 extern "C" {
@@ -82,6 +114,21 @@ EMSCRIPTEN_KEEPALIVE inline int emscripten_browser_clipboard_detail_paste_return
   return 1;
 }
 
+EMSCRIPTEN_KEEPALIVE inline void *emscripten_browser_clipboard_detail_paste_allocate(size_t size);
+
+EMSCRIPTEN_KEEPALIVE inline void *emscripten_browser_clipboard_detail_paste_allocate(size_t size) {
+  /// Allocate the buffer javascript writes paste data into - this function is called from javascript when the paste event occurs
+  return std::malloc(size);
+}
+
+EMSCRIPTEN_KEEPALIVE inline int emscripten_browser_clipboard_detail_paste_buffer_return(char *paste_data, size_t size, paste_buffer_handler callback, void *callback_data);
+
+EMSCRIPTEN_KEEPALIVE inline int emscripten_browser_clipboard_detail_paste_buffer_return(char *paste_data, size_t size, paste_buffer_handler callback, void *callback_data) {
+  /// Call paste buffer callback, passing ownership of the buffer - this function is called from javascript when the paste event occurs
+  callback(paste_data, size, callback_data);
+  return 1;
+}
+
 EMSCRIPTEN_KEEPALIVE inline char const *emscripten_browser_clipboard_detail_copy_return(copy_handler callback, void *callback_data);
 
 EMSCRIPTEN_KEEPALIVE inline char const *emscripten_browser_clipboard_detail_copy_return(copy_handler callback, void *callback_data) {
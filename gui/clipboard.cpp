@@ -1,4 +1,6 @@
 #include "clipboard.h"
+#include <cstdlib>
+#include <cstring>
 #include <imgui/imgui.h>
 #include <imgui/imgui_internal.h>
 #include "emscripten_browser_clipboard.h"
@@ -14,19 +16,26 @@
 #ifdef DEBUG_CLIPBOARD
   #include <iostream>
   #include <iomanip>
+  #include <string_view>
 #endif // DEBUG_CLIPBOARD
 
 namespace gui {
 
+void clipboard::scrubbing_deleter::operator()(char *data) const {
+  /// Wipe and free clipboard content
+  secure_cleanse(data, size);
+  std::free(data);
+}
+
 clipboard::clipboard() {
   /// Default constructor
-  emscripten_browser_clipboard::paste([](std::string &&paste_data, void *callback_data){
-    /// Callback to handle clipboard paste from browser
+  emscripten_browser_clipboard::paste_buffer([](char *paste_data, size_t size, void *callback_data){
+    /// Callback to handle clipboard paste from browser, taking ownership of the pasted data without copying it
     auto &parent{*static_cast<clipboard*>(callback_data)};
     #ifdef DEBUG_CLIPBOARD
-      std::cout << "DEBUG: Clipboard: browser paste event with data " << std::quoted(paste_data) << std::endl;
+      std::cout << "DEBUG: Clipboard: browser paste event with data " << std::quoted(std::string_view{paste_data, size}) << std::endl;
     #endif // DEBUG_CLIPBOARD
-    parent.content = std::move(paste_data);
+    parent.set_content(paste_data, size);
   }, this);
 
   /*
@@ -36,7 +45,7 @@ clipboard::clipboard() {
     #ifdef DEBUG_CLIPBOARD
       std::cout << "DEBUG: Clipboard: browser copy event, sending data " << std::quoted(parent.content) << std::endl;
     #endif // DEBUG_CLIPBOARD
-    return parent.content.c_str();
+    return parent.get_content();
   });
   */
 }
@@ -60,20 +69,24 @@ void clipboard::set_imgui_callbacks() {
     auto &parent{*static_cast<clipboard*>(ctx->PlatformIO.Platform_ClipboardUserData)};
 
     #ifdef DEBUG_CLIPBOARD
-      std::cout << "DEBUG: Clipboard: imgui requested content, returning " << std::quoted(parent.content) << std::endl;
+      std::cout << "DEBUG: Clipboard: imgui requested content, returning " << std::quoted(parent.get_content()) << std::endl;
     #endif // DEBUG_CLIPBOARD
-    return parent.content.c_str();
+    return parent.get_content();
   };
 
   imgui_platform_io.Platform_SetClipboardTextFn = [](ImGuiContext *ctx, char const *text){
     /// Callback for imgui, to set clipboard content
     auto &parent{*static_cast<clipboard*>(ctx->PlatformIO.Platform_ClipboardUserData)};
 
-    parent.content = text;
+    auto const size{std::strlen(text)};
+    auto *data{static_cast<char*>(std::malloc(size + 1))};
+    if(!data) return;
+    std::memcpy(data, text, size + 1);
+    parent.set_content(data, size);
     #ifdef DEBUG_CLIPBOARD
-      std::cout << "DEBUG: Clipboard: imgui set content, now " << std::quoted(parent.content) << std::endl;
+      std::cout << "DEBUG: Clipboard: imgui set content, now " << std::quoted(parent.get_content()) << std::endl;
     #endif // DEBUG_CLIPBOARD
-    emscripten_browser_clipboard::copy(parent.content);
+    emscripten_browser_clipboard::copy(parent.get_content());
   };
 }
 
@@ -82,7 +95,17 @@ void clipboard::scrub() {
   #ifdef DEBUG_CLIPBOARD
     std::cout << "DEBUG: Clipboard: Scrubbing" << std::endl;
   #endif // DEBUG_CLIPBOARD
-  secure_cleanse(content);
+  content.reset();
+}
+
+void clipboard::set_content(char *data, size_t size) {
+  /// Take ownership of new null terminated content allocated with malloc, securely erasing the old content
+  content = std::unique_ptr<char, scrubbing_deleter>{data, scrubbing_deleter{size + 1}};
+}
+
+char const *clipboard::get_content() const {
+  /// Return the current content as a null terminated string, which is empty if there is none
+  return content ? content.get() : "";
 }
 
 }
@@ -1,11 +1,19 @@
 #pragma once
 
-#include <string>
+#include <cstddef>
+#include <memory>
 
 namespace gui {
 
 class clipboard {
-  std::string content;
+  struct scrubbing_deleter {
+    /// Securely erases clipboard content before freeing it
+    size_t size{0};                                                             // size of the allocation, including the null terminator
+
+    void operator()(char *data) const;
+  };
+
+  std::unique_ptr<char, scrubbing_deleter> content;                             // null terminated UTF-8, allocated with malloc
 
 public:
   clipboard();
@@ -14,6 +22,10 @@ public:
   void set_imgui_callbacks();
 
   void scrub();
+
+private:
+  void set_content(char *data, size_t size);
+  char const *get_content() const;
 };
 
 }
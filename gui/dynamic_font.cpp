@@ -0,0 +1,219 @@
+#include "dynamic_font.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <imgui/imgui_internal.h>
+#include <imgui/imgui_impl_wgpu.h>
+#include "logstorm/logstorm.h"
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imgui/imstb_rectpack.h>
+
+namespace gui {
+
+struct dynamic_font::packer_data {
+  stbrp_context context;
+  std::vector<stbrp_node> nodes;
+  vec2i origin;                                                                 // top left of the reserved region within the atlas
+};
+
+namespace {
+
+constexpr unsigned int atlas_empty_pixel{IM_COL32(255, 255, 255, 0)};          // matches the background of an atlas converted to RGBA32 by ImGui
+
+int freetype_ceil(FT_Pos value) {
+  /// Round a 26.6 fixed point FreeType value up to whole pixels, as imgui_freetype does
+  return static_cast<int>(((value + 63) & -64) / 64);
+}
+
+}
+
+dynamic_font::dynamic_font(logstorm::manager &this_logger)
+  : logger{this_logger} {
+  /// Default constructor
+}
+
+dynamic_font::~dynamic_font() {
+  /// Default destructor
+  if(face) FT_Done_Face(face);
+  if(freetype) FT_Done_FreeType(freetype);
+}
+
+ImFont *dynamic_font::load(std::string const &filename, float size_pixels, vec2i const &this_region_size) {
+  /// Add a font to the ImGui atlas, baking only the default ranges and reserving space for the rest to be rasterised as needed
+  /// Must be called before the atlas is built, i.e. before the first frame
+  region_size = this_region_size;
+  auto &atlas{*ImGui::GetIO().Fonts};
+  font = atlas.AddFontFromFileTTF(filename.c_str(), size_pixels, nullptr, atlas.GetGlyphRangesDefault());
+  if(!font) {
+    logger << "ERROR: GUI: Could not load font " << filename;
+    return nullptr;
+  }
+  region_rect_id = atlas.AddCustomRectRegular(region_size.x, region_size.y);
+  atlas.TexDesiredWidth = std::max(atlas.TexDesiredWidth, region_size.x);      // the atlas must be at least as wide as the region we reserve in it
+
+  if(FT_Init_FreeType(&freetype) != 0) {
+    logger << "ERROR: GUI: Could not initialise FreeType, glyphs outside the default ranges will not be available";
+    return font;
+  }
+  if(FT_New_Face(freetype, filename.c_str(), 0, &face) != 0) {
+    logger << "ERROR: GUI: FreeType could not open " << filename << ", glyphs outside the default ranges will not be available";
+    return font;
+  }
+  FT_Size_RequestRec size_request{                                              // size the face the same way imgui_freetype does for the baked glyphs
+    .type{FT_SIZE_REQUEST_TYPE_REAL_DIM},
+    .width{0},
+    .height{static_cast<FT_Long>(size_pixels * 64.0f)},
+    .horiResolution{0},
+    .vertResolution{0},
+  };
+  FT_Request_Size(face, &size_request);
+  logger << "GUI: Loaded font " << filename << " at " << size_pixels << "px with a " << region_size << " dynamic glyph region";
+  return font;
+}
+
+void dynamic_font::update() {
+  /// Rasterise any glyphs the font was asked for during the last frame but didn't contain
+  /// Call between frames, after the last frame's draw data has been submitted and before ImGui::NewFrame(), as a flush moves glyphs that draw data refers to
+  /// If the region fills up, it's flushed at most once per batch, and the glyphs this batch already added are packed again, so none of them miss next frame
+  if(!font || !face || !font->ContainerAtlas->IsBuilt() || !font->FallbackGlyph) return;
+  if(!packer) init_packer();
+  if(font->MissingGlyphs.empty()) return;
+
+  ImVector<ImWchar> missing_glyphs;
+  font->TakeMissingGlyphs(&missing_glyphs);
+  ImFontGlyph const fallback_glyph{*font->FallbackGlyph};                       // copied, as adding glyphs invalidates pointers into the glyph list
+  int const frame{ImGui::GetFrameCount()};
+  bool may_flush{frame - last_flush_frame >= min_frames_between_flushes};
+  for(int i{0}; i != missing_glyphs.Size; ++i) {
+    auto result{add_glyph(missing_glyphs[i])};
+    if(result == glyph_result::region_full && may_flush) {
+      flush();
+      last_flush_frame = frame;
+      may_flush = false;
+      for(int j{0}; j != i; ++j) add_glyph_or_fallback(missing_glyphs[j], fallback_glyph); // repack what this batch already added
+      result = add_glyph(missing_glyphs[i]);
+    }
+    if(result != glyph_result::added) add_fallback_glyph(missing_glyphs[i], fallback_glyph); // until the region is next flushed
+  }
+  rebuild_tab_glyph();
+  font->BuildLookupTable();
+}
+
+void dynamic_font::init_packer() {
+  /// Set up packing into the region reserved in the atlas, now that the atlas has been built and the region placed
+  auto &atlas{*font->ContainerAtlas};                                           // non-const, as GetCustomRectByIndex() is
+  auto const &region{*atlas.GetCustomRectByIndex(region_rect_id)};
+  packer = std::make_unique<packer_data>();
+  packer->origin.assign(region.X, region.Y);
+  packer->nodes.resize(static_cast<size_t>(region_size.x));
+  stbrp_init_target(&packer->context, region_size.x, region_size.y, packer->nodes.data(), static_cast<int>(packer->nodes.size()));
+
+  rebuild_tab_glyph();
+  static_glyph_count = static_cast<int>(std::count_if(font->Glyphs.begin(), font->Glyphs.end(), [](ImFontGlyph const &glyph){
+    return glyph.Codepoint != '\t';
+  }));                                                                          // the tab glyph is rebuilt after any dynamic glyphs, so it's never counted as static
+  font->BuildLookupTable();
+}
+
+void dynamic_font::rebuild_tab_glyph() {
+  /// Remove the tab glyph from wherever it is in the glyph list, and add it again at the end, rebuilt from the space glyph as ImGui builds it
+  /// Keeping it last means dynamic glyphs are only ever added after it, and a flush back to the static glyphs always drops it
+  auto &glyphs{font->Glyphs};
+  auto const glyphs_end{std::remove_if(glyphs.begin(), glyphs.end(), [](ImFontGlyph const &glyph){
+    return glyph.Codepoint == '\t';
+  })};
+  glyphs.resize(static_cast<int>(glyphs_end - glyphs.begin()));
+  auto const space{std::find_if(glyphs.begin(), glyphs.end(), [](ImFontGlyph const &glyph){
+    return glyph.Codepoint == ' ';
+  })};
+  if(space == glyphs.end()) return;
+  ImFontGlyph tab_glyph{*space};
+  tab_glyph.Codepoint = '\t';
+  tab_glyph.AdvanceX *= IM_TABSIZE;
+  glyphs.push_back(tab_glyph);
+}
+
+void dynamic_font::flush() {
+  /// Discard all dynamically added glyphs and clear their region, so it can be repacked with the glyphs currently in use
+  logger << "GUI: Dynamic glyph region full, flushing " << font->Glyphs.Size - static_glyph_count << " glyphs";
+  font->Glyphs.resize(static_glyph_count);
+  stbrp_init_target(&packer->context, region_size.x, region_size.y, packer->nodes.data(), static_cast<int>(packer->nodes.size()));
+
+  auto &atlas{*font->ContainerAtlas};
+  for(int y{0}; y != region_size.y; ++y) {
+    auto const row_offset{(packer->origin.y + y) * atlas.TexWidth + packer->origin.x};
+    std::fill_n(atlas.TexPixelsRGBA32 + row_offset, region_size.x, atlas_empty_pixel);
+    if(atlas.TexPixelsAlpha8) std::memset(atlas.TexPixelsAlpha8 + row_offset, 0, static_cast<size_t>(region_size.x));
+  }
+  ImGui_ImplWGPU_UpdateFontsTexture(packer->origin.x, packer->origin.y, region_size.x, region_size.y);
+}
+
+dynamic_font::glyph_result dynamic_font::add_glyph(ImWchar codepoint) {
+  /// Rasterise a single glyph into the atlas and add it to the font, unless the font can't provide it or there's no room left for it
+  if(font->FindGlyphNoFallback(codepoint)) return glyph_result::added;          // already added, e.g. by a duplicate request
+  auto const glyph_index{FT_Get_Char_Index(face, codepoint)};
+  if(glyph_index == 0) return glyph_result::unavailable;                        // not present in this font
+  if(FT_Load_Glyph(face, glyph_index, FT_LOAD_NO_BITMAP | FT_LOAD_TARGET_NORMAL) != 0) return glyph_result::unavailable;
+  if(FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL) != 0) return glyph_result::unavailable;
+  auto const &bitmap{face->glyph->bitmap};
+  if(bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) return glyph_result::unavailable;
+
+  auto &atlas{*font->ContainerAtlas};
+  int const padding{atlas.TexGlyphPadding};
+  vec2i const size{static_cast<int>(bitmap.width), static_cast<int>(bitmap.rows)};
+  stbrp_rect rect{
+    .id{0},
+    .w{size.x + padding},
+    .h{size.y + padding},
+  };
+  if(!stbrp_pack_rects(&packer->context, &rect, 1)) return glyph_result::region_full;
+  vec2i const pos{packer->origin.x + rect.x + padding, packer->origin.y + rect.y + padding};
+
+  // blit into the CPU copy of the atlas, then upload just this rectangle
+  for(int y{0}; y != size.y; ++y) {
+    auto const *src{bitmap.buffer + y * bitmap.pitch};
+    auto const row_offset{(pos.y + y) * atlas.TexWidth + pos.x};
+    for(int x{0}; x != size.x; ++x) {
+      atlas.TexPixelsRGBA32[row_offset + x] = IM_COL32(255, 255, 255, src[x]);
+    }
+    if(atlas.TexPixelsAlpha8) std::memcpy(atlas.TexPixelsAlpha8 + row_offset, src, static_cast<size_t>(size.x));
+  }
+  ImGui_ImplWGPU_UpdateFontsTexture(pos.x, pos.y, size.x, size.y);
+
+  auto const &config{*font->ConfigData};
+  float const x0{static_cast<float>(face->glyph->bitmap_left) + config.GlyphOffset.x};
+  float const y0{static_cast<float>(-face->glyph->bitmap_top) + config.GlyphOffset.y + IM_ROUND(font->Ascent)};
+  auto const texture_size{static_cast<vec2f>(vec2i{atlas.TexWidth, atlas.TexHeight})};
+  font->AddGlyph(
+    &config,
+    codepoint,
+    x0,
+    y0,
+    x0 + static_cast<float>(size.x),
+    y0 + static_cast<float>(size.y),
+    static_cast<float>(pos.x) / texture_size.x,
+    static_cast<float>(pos.y) / texture_size.y,
+    static_cast<float>(pos.x + size.x) / texture_size.x,
+    static_cast<float>(pos.y + size.y) / texture_size.y,
+    static_cast<float>(freetype_ceil(face->glyph->advance.x))
+  );
+  return glyph_result::added;
+}
+
+void dynamic_font::add_glyph_or_fallback(ImWchar codepoint, ImFontGlyph const &fallback_glyph) {
+  /// Add a glyph, aliasing it to the fallback glyph if it can't be added
+  if(add_glyph(codepoint) != glyph_result::added) add_fallback_glyph(codepoint, fallback_glyph);
+}
+
+void dynamic_font::add_fallback_glyph(ImWchar codepoint, ImFontGlyph const &fallback_glyph) {
+  /// Alias a glyph the font can't provide to the fallback glyph, so it isn't requested again
+  ImFontGlyph glyph{fallback_glyph};
+  glyph.Codepoint = codepoint;
+  font->Glyphs.push_back(glyph);
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <imgui/imgui.h>
+#include "logstorm/logstorm_forward.h"
+#include "vectorstorm/vector/vector2.h"
+
+struct FT_LibraryRec_;
+struct FT_FaceRec_;
+
+namespace gui {
+
+class dynamic_font {
+  /// A font whose glyphs outside the baked ranges are rasterised on demand
+  /// into a reserved region of the ImGui font atlas, so large character sets
+  /// don't have to be baked at startup
+  logstorm::manager &logger;
+
+  FT_LibraryRec_ *freetype{nullptr};                                            // FreeType library instance used for on-demand rasterisation
+  FT_FaceRec_ *face{nullptr};                                                   // face of the loaded font file, sized to match the baked font
+  ImFont *font{nullptr};                                                        // the ImGui font we add glyphs to
+
+  vec2i region_size;                                                            // size of the atlas region reserved for dynamic glyphs
+  int region_rect_id{-1};                                                       // atlas custom rect id reserving the region
+  int static_glyph_count{0};                                                    // number of glyphs baked at startup, which are never flushed
+  int last_flush_frame{-min_frames_between_flushes};                            // ImGui frame count when the region was last flushed
+
+  struct packer_data;
+  std::unique_ptr<packer_data> packer;                                          // rectangle packer for the reserved region, created once the atlas has been built
+
+  enum class glyph_result {
+    added,
+    unavailable,                                                                // the font can't provide it
+    region_full,                                                                // no room left in the region to pack it
+  };
+
+public:
+  static constexpr vec2i default_region_size{1024, 512};
+  static constexpr int min_frames_between_flushes{60};                          // so a working set larger than the region falls back rather than repacking every frame
+
+  dynamic_font(logstorm::manager &logger);
+  ~dynamic_font();
+
+  ImFont *load(std::string const &filename, float size_pixels, vec2i const &region_size = default_region_size);
+
+  void update();
+
+private:
+  void init_packer();
+  void flush();
+  void rebuild_tab_glyph();
+  glyph_result add_glyph(ImWchar codepoint);
+  void add_glyph_or_fallback(ImWchar codepoint, ImFontGlyph const &fallback_glyph);
+  void add_fallback_glyph(ImWchar codepoint, ImFontGlyph const &fallback_glyph);
+};
+
+}
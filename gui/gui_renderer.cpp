@@ -7,7 +7,8 @@
 namespace gui {
 
 gui_renderer::gui_renderer(logstorm::manager &this_logger)
-  :logger{this_logger} {
+  :logger{this_logger},
+   font{this_logger} {
   /// Construct the top level GUI and initialise ImGUI
   logger << "GUI: Initialising";
   #ifndef NDEBUG
@@ -18,6 +19,8 @@ gui_renderer::gui_renderer(logstorm::manager &this_logger)
 
   imgui_io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
   imgui_io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+
+  font.load("DejaVuSans.ttf", 16.0f);
 }
 
 void gui_renderer::init(ImGui_ImplWGPU_InitInfo &imgui_wgpu_info) {
@@ -28,13 +31,38 @@ void gui_renderer::init(ImGui_ImplWGPU_InitInfo &imgui_wgpu_info) {
   clipboard.set_imgui_callbacks();
 }
 
-void gui_renderer::draw() const {
-  /// Render the top level GUI
+void gui_renderer::reinit_device(ImGui_ImplWGPU_InitInfo &imgui_wgpu_info) {
+  /// Move the WebGPU backend to a replacement device after the previous one was lost
+  /// Device objects, including the font texture, are recreated from the atlas when the next frame starts
+  images.clear();                                                               // their bind groups belong to the lost device
+  ImGui_ImplWGPU_Shutdown();
+  ImGui_ImplWGPU_Init(&imgui_wgpu_info);
+}
+
+image_cache &gui_renderer::get_image_cache() {
+  /// Access the cache used to display renderer textures in the GUI
+  return images;
+}
+
+void gui_renderer::add_window(std::function<void()> &&draw_window) {
+  /// Add a function to draw a window every frame
+  windows.emplace_back(std::move(draw_window));
+}
+
+void gui_renderer::begin_frame() {
+  /// Prepare the backends for a new frame, submitting their pending input to ImGui
+  /// Input queued for ImGui can be inspected or replaced between this and draw()
   ImGui_ImplWGPU_NewFrame();
+  font.update();                                                                // rasterise any glyphs the last frame needed that the font atlas didn't have yet, now its draw data has been submitted
   ImGui_ImplEmscripten_NewFrame();
+}
+
+void gui_renderer::draw() {
+  /// Render the top level GUI
   ImGui::NewFrame();
 
   ImGui::ShowDemoWindow();
+  for(auto const &draw_window : windows) draw_window();
 
   ImGui::Render();                                                              // finalise draw data (actual rendering of draw data is done by the renderer later)
 }
@@ -1,6 +1,10 @@
 #pragma once
+#include <functional>
+#include <vector>
 #include "logstorm/logstorm_forward.h"
 #include "clipboard.h"
+#include "dynamic_font.h"
+#include "image_cache.h"
 
 class ImGui_ImplWGPU_InitInfo;
 
@@ -10,13 +14,23 @@ class gui_renderer {
   logstorm::manager &logger;
 
   clipboard clipboard;
+  image_cache images;                                                           // renderer textures displayed in the GUI
+  dynamic_font font;                                                            // main GUI font, rasterising uncommon glyphs on demand
+
+  std::vector<std::function<void()>> windows;                                   // drawn every frame, for other systems to expose their settings
 
 public:
   gui_renderer(logstorm::manager &logger);
 
   void init(ImGui_ImplWGPU_InitInfo &wgpu_info);
+  void reinit_device(ImGui_ImplWGPU_InitInfo &wgpu_info);
+
+  image_cache &get_image_cache();
+
+  void add_window(std::function<void()> &&draw_window);
 
-  void draw() const;
+  void begin_frame();
+  void draw();
 };
 
 }
@@ -0,0 +1,79 @@
+#include "image_cache.h"
+#include <iterator>
+#include <imgui/imgui_impl_wgpu.h>
+
+namespace gui {
+
+ImTextureID image_cache::get_texture_id(wgpu::Texture const &texture, wgpu::TextureView const &texture_view) {
+  /// Return the ImGui texture id for a texture view, marking it as used this frame
+  if(drawn_callback) drawn_callback();                                          // a cached GUI wouldn't otherwise see the texture's contents change
+  int const frame{ImGui::GetFrameCount()};
+  if(auto it{lookup.find(texture_view.Get())}; it != lookup.end()) {
+    entries.splice(entries.begin(), entries, it->second);                       // move to the front of the LRU list, iterators remain valid
+    it->second->last_used_frame = frame;
+  } else {
+    entries.emplace_front(texture, texture_view, frame);
+    lookup.emplace(texture_view.Get(), entries.begin());
+    evict();
+  }
+  return reinterpret_cast<ImTextureID>(texture_view.Get());
+}
+
+void image_cache::image(wgpu::Texture const &texture, wgpu::TextureView const &texture_view, ImVec2 const &size, ImVec2 const &uv0, ImVec2 const &uv1) {
+  /// Draw a view of a renderer texture as an ImGui image
+  ImGui::Image(get_texture_id(texture, texture_view), size, uv0, uv1);
+}
+
+void image_cache::invalidate(wgpu::Texture const &texture) {
+  /// Drop the cached bind groups for every view of a texture - call this when the texture is destroyed or recreated
+  for(auto it{entries.begin()}; it != entries.end();) {
+    if(it->texture.Get() == texture.Get()) {
+      release(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void image_cache::clear() {
+  /// Release all cached bind groups
+  for(auto const &this_entry : entries) {
+    ImGui_ImplWGPU_ReleaseImageBindGroup(reinterpret_cast<ImTextureID>(this_entry.texture_view.Get()));
+  }
+  entries.clear();
+  lookup.clear();
+}
+
+void image_cache::set_capacity(size_t new_capacity) {
+  /// Set how many texture bind groups to keep cached, evicting any excess
+  capacity = new_capacity;
+  evict();
+}
+
+void image_cache::set_drawn_callback(std::function<void()> &&new_drawn_callback) {
+  /// Set a callback to be told each frame a texture is drawn, such as to redraw a cached GUI
+  drawn_callback = std::move(new_drawn_callback);
+}
+
+size_t image_cache::size() const {
+  /// Return the number of texture bind groups currently cached
+  return entries.size();
+}
+
+void image_cache::evict() {
+  /// Release least recently used bind groups until we're within capacity
+  /// Textures drawn this frame are never evicted, as their bind groups are still needed to render it
+  int const frame{ImGui::GetFrameCount()};
+  while(entries.size() > capacity && entries.back().last_used_frame != frame) {
+    release(std::prev(entries.end()));
+  }
+}
+
+void image_cache::release(std::list<entry>::iterator it) {
+  /// Release an entry's bind group and forget it
+  ImGui_ImplWGPU_ReleaseImageBindGroup(reinterpret_cast<ImTextureID>(it->texture_view.Get()));
+  lookup.erase(it->texture_view.Get());
+  entries.erase(it);
+}
+
+}
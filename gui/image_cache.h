@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <webgpu/webgpu_cpp.h>
+#include <imgui/imgui.h>
+
+namespace gui {
+
+class image_cache {
+  /// Displays renderer textures through ImGui::Image, keeping the bind groups
+  /// the WebGPU backend creates for them bounded by least-recently-used eviction
+  /// Entries for a texture are dropped as soon as it's destroyed, so a recreated texture's memory isn't held until eviction
+  struct entry {
+    wgpu::Texture texture;                                                      // the texture the view is of, so its views can be dropped when it's destroyed
+    wgpu::TextureView texture_view;                                             // held so the view's handle can't be reused by another view while its bind group is cached
+    int last_used_frame{-1};                                                    // ImGui frame count when this texture was last drawn
+  };
+
+  std::list<entry> entries;                                                     // most recently used first
+  std::unordered_map<WGPUTextureView, std::list<entry>::iterator> lookup;       // index into entries by texture view handle
+  size_t capacity{default_capacity};                                            // number of bind groups we aim to keep cached
+  std::function<void()> drawn_callback;                                         // called whenever a texture is drawn, as its contents may have changed since the GUI was last rendered
+
+public:
+  static constexpr size_t default_capacity{64};
+
+  ImTextureID get_texture_id(wgpu::Texture const &texture, wgpu::TextureView const &texture_view);
+
+  void image(wgpu::Texture const &texture, wgpu::TextureView const &texture_view, ImVec2 const &size, ImVec2 const &uv0 = {0.0f, 0.0f}, ImVec2 const &uv1 = {1.0f, 1.0f});
+
+  void invalidate(wgpu::Texture const &texture);
+  void clear();
+
+  void set_capacity(size_t new_capacity);
+  void set_drawn_callback(std::function<void()> &&new_drawn_callback);
+  size_t size() const;
+
+private:
+  void evict();
+  void release(std::list<entry>::iterator it);
+};
+
+}
@@ -3569,12 +3569,16 @@ struct ImFont
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize] (unscaled)
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
+    // LOCAL PATCH (dynamic glyphs): not in upstream Dear ImGui - reapply MissingGlyphs, MissingGlyphsMap and TakeMissingGlyphs() here and in imgui_draw.cpp when updating ImGui
+    ImVector<ImWchar>           MissingGlyphs;      // 12-16 // out //            // Codepoints FindGlyph() was asked for that the font doesn't contain, so the application can rasterise them on demand. Taken by the application with TakeMissingGlyphs().
+    ImVector<ImU32>             MissingGlyphsMap;   // 12-16 // out //            // 1 bit per codepoint in MissingGlyphs, so FindGlyph() doesn't have to search it.
 
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
     IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c);
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c);
+    IMGUI_API void              TakeMissingGlyphs(ImVector<ImWchar>* out_codepoints); // LOCAL PATCH (dynamic glyphs): Move the codepoints in MissingGlyphs into out_codepoints, so they're recorded again if still missing
     float                       GetCharAdvance(ImWchar c)           { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
@@ -3674,6 +3674,9 @@ void    ImFont::ClearOutputData()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    // LOCAL PATCH (dynamic glyphs)
+    MissingGlyphs.clear();
+    MissingGlyphsMap.clear();
 }
 
 static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_chars, int candidate_chars_count)
@@ -3860,14 +3863,23 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 }
 
 // Find glyph, return fallback if missing
+// LOCAL PATCH (dynamic glyphs): not in upstream Dear ImGui - records each missing codepoint once in MissingGlyphs, using the MissingGlyphsMap bitmap, so the application can rasterise it on demand
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c)
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
-    if (i == (ImWchar)-1)
+    if (c >= (size_t)IndexLookup.Size || IndexLookup.Data[c] == (ImWchar)-1)
+    {
+        const int map_index = (int)(c >> 5);
+        const ImU32 map_mask = (ImU32)1 << (c & 31);
+        if (map_index >= MissingGlyphsMap.Size)
+            MissingGlyphsMap.resize(map_index + 1, 0);
+        if (!(MissingGlyphsMap.Data[map_index] & map_mask))
+        {
+            MissingGlyphsMap.Data[map_index] |= map_mask;
+            MissingGlyphs.push_back(c);
+        }
         return FallbackGlyph;
-    return &Glyphs.Data[i];
+    }
+    return &Glyphs.Data[IndexLookup.Data[c]];
 }
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c)
@@ -3880,6 +3892,15 @@ const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c)
     return &Glyphs.Data[i];
 }
 
+// LOCAL PATCH (dynamic glyphs): not in upstream Dear ImGui
+void ImFont::TakeMissingGlyphs(ImVector<ImWchar>* out_codepoints)
+{
+    for (int n = 0; n < MissingGlyphs.Size; n++)
+        MissingGlyphsMap.Data[MissingGlyphs.Data[n] >> 5] &= ~((ImU32)1 << (MissingGlyphs.Data[n] & 31));
+    out_codepoints->clear();
+    out_codepoints->swap(MissingGlyphs);
+}
+
 // Trim trailing space and find beginning of next line
 static inline const char* CalcWordWrapNextLineStartA(const char* text, const char* text_end)
 {
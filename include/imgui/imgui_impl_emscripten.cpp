@@ -4,6 +4,8 @@
 //
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-18: Inputs: Mouse position, button and wheel events are buffered and coalesced until NewFrame(), with optional raw history via ImGui_ImplEmscripten_GetRawMouseHistory().
+//  2026-10-18: Inputs: Replaced ImGuiStorage key lookup with a perfect hash table built at compile time, removing startup construction and the per-key binary search.
 //  2026-04-02: Inputs: Replaced custom KeyboardEvent.code parser with ImHashStr()/ImGuiStorage lookup to match Dear ImGui backend style.
 //  2026-03-31: Emscripten: Added configurable TargetDevicePixelRatio to control how browser device pixels map to Dear ImGui pixels.
 //  2026-03-31: Inputs: Added BrowserBack/Forward and F13-F24 key mappings.
@@ -22,15 +24,14 @@
 #include <emscripten.h>
 #include <emscripten/html5.h>
 
-extern ImGuiID ImHashStr(char const* data, size_t data_size = 0, ImGuiID seed = 0); // Declared in imgui_internal.h.
-
 float ImGui_ImplEmscripten_TargetDevicePixelRatio{1.0f};
+bool ImGui_ImplEmscripten_KeepRawMouseHistory{false};
 
 namespace {
 
 // W3C UI Events KeyboardEvent.code translation helpers
 
-ImGuiKey translate_key(char const* emscripten_key);
+constexpr ImGuiKey translate_key(char const* emscripten_key);
 constexpr ImGuiMouseButton translate_mousebutton(unsigned short emscripten_button) __attribute__((__const__));
 
 } // anonymous namespace
@@ -109,6 +110,9 @@ struct ImGui_ImplEmscripten_Data
     char* CursorToRestore{nullptr};
     bool LastMouseDrawCursor{false};
     bool LastNoMouseCursorChange{false};
+    ImVector<ImGui_ImplEmscripten_MouseEvent> PendingMouseEvents;             // coalesced mouse events waiting to be submitted to Dear ImGui
+    ImVector<ImGui_ImplEmscripten_MouseEvent> RawMouseEvents;                 // every mouse event received since the last NewFrame(), if ImGui_ImplEmscripten_KeepRawMouseHistory is set
+    ImVector<ImGui_ImplEmscripten_MouseEvent> RawMouseHistory;                // every mouse event received before the last NewFrame()
 };
 
 float get_target_device_pixel_ratio()
@@ -133,6 +137,72 @@ ImGui_ImplEmscripten_Data* ImGui_ImplEmscripten_GetBackendData()
     return ImGui::GetCurrentContext() ? static_cast<ImGui_ImplEmscripten_Data*>(ImGui::GetIO().BackendPlatformUserData) : nullptr;
 }
 
+void queue_mouse_event(ImGui_ImplEmscripten_MouseEvent const& event)
+{
+    // Buffer a mouse event until the next frame, merging it into the previous event where that loses nothing Dear ImGui would see:
+    // consecutive moves keep only the last position and consecutive wheel events are summed, while button events are never merged.
+    ImGui_ImplEmscripten_Data* bd{ImGui_ImplEmscripten_GetBackendData()};
+    if (bd == nullptr) return;
+    if (ImGui_ImplEmscripten_KeepRawMouseHistory) bd->RawMouseEvents.push_back(event);
+
+    ImVector<ImGui_ImplEmscripten_MouseEvent>& pending{bd->PendingMouseEvents};
+    if (!pending.empty() && pending.back().Type == event.Type)
+    {
+        ImGui_ImplEmscripten_MouseEvent& last{pending.back()};
+        switch (event.Type)
+        {
+        case ImGui_ImplEmscripten_MouseEventType_Pos:
+            last.Value = event.Value;
+            last.Timestamp = event.Timestamp;
+            return;
+        case ImGui_ImplEmscripten_MouseEventType_Wheel:
+            last.Value.x += event.Value.x;
+            last.Value.y += event.Value.y;
+            last.Timestamp = event.Timestamp;
+            return;
+        case ImGui_ImplEmscripten_MouseEventType_Button:
+            break;
+        }
+    }
+    pending.push_back(event);
+}
+
+void queue_mouse_pos_event(EmscriptenMouseEvent const& mouse_event)
+{
+    ImGui_ImplEmscripten_Data* bd{ImGui_ImplEmscripten_GetBackendData()};
+    float const css_to_imgui_scale{bd ? bd->CssToImGuiScale : 1.0f};
+    queue_mouse_event({
+        .Type{ImGui_ImplEmscripten_MouseEventType_Pos},
+        .Timestamp{mouse_event.timestamp},
+        .Value{static_cast<float>(mouse_event.clientX) * css_to_imgui_scale, static_cast<float>(mouse_event.clientY) * css_to_imgui_scale},
+    });
+}
+
+void flush_mouse_events()
+{
+    // Submit buffered mouse events to Dear ImGui in the order they arrived.  Called once per frame, and before any other
+    // input event is submitted, so that e.g. a click followed by a key press reaches Dear ImGui in that order.
+    ImGui_ImplEmscripten_Data* bd{ImGui_ImplEmscripten_GetBackendData()};
+    if (bd == nullptr || bd->PendingMouseEvents.empty()) return;
+    ImGuiIO& io{ImGui::GetIO()};
+    for (ImGui_ImplEmscripten_MouseEvent const& event : bd->PendingMouseEvents)
+    {
+        switch (event.Type)
+        {
+        case ImGui_ImplEmscripten_MouseEventType_Pos:
+            io.AddMousePosEvent(event.Value.x, event.Value.y);
+            break;
+        case ImGui_ImplEmscripten_MouseEventType_Button:
+            io.AddMouseButtonEvent(event.Button, event.Down);
+            break;
+        case ImGui_ImplEmscripten_MouseEventType_Wheel:
+            io.AddMouseWheelEvent(event.Value.x, event.Value.y);
+            break;
+        }
+    }
+    bd->PendingMouseEvents.resize(0);
+}
+
 } // anonymous namespace
 
 void ImGui_ImplEmscripten_Init()
@@ -159,12 +229,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenMouseEvent const* mouse_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_MOUSEMOVE
-            ImGui_ImplEmscripten_Data* bd{ImGui_ImplEmscripten_GetBackendData()};
-            float const css_to_imgui_scale{bd ? bd->CssToImGuiScale : 1.0f};
-            ImGui::GetIO().AddMousePosEvent(
-                static_cast<float>(mouse_event->clientX) * css_to_imgui_scale,
-                static_cast<float>(mouse_event->clientY) * css_to_imgui_scale
-            );
+            queue_mouse_pos_event(*mouse_event);
             return true;                                                        // the event was consumed
         }
     );
@@ -173,7 +238,12 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenMouseEvent const* mouse_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_MOUSEDOWN
-            ImGui::GetIO().AddMouseButtonEvent(translate_mousebutton(mouse_event->button), true); // translated button, down
+            queue_mouse_event({
+                .Type{ImGui_ImplEmscripten_MouseEventType_Button},
+                .Timestamp{mouse_event->timestamp},
+                .Button{translate_mousebutton(mouse_event->button)},
+                .Down{true},
+            });
             return true;                                                        // the event was consumed
         }
     );
@@ -182,7 +252,12 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenMouseEvent const* mouse_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_MOUSEUP
-            ImGui::GetIO().AddMouseButtonEvent(translate_mousebutton(mouse_event->button), false); // translated button, up
+            queue_mouse_event({
+                .Type{ImGui_ImplEmscripten_MouseEventType_Button},
+                .Timestamp{mouse_event->timestamp},
+                .Button{translate_mousebutton(mouse_event->button)},
+                .Down{false},
+            });
             return true;                                                        // the event was consumed
         }
     );
@@ -191,12 +266,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenMouseEvent const* mouse_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_MOUSEENTER
-            ImGui_ImplEmscripten_Data* bd{ImGui_ImplEmscripten_GetBackendData()};
-            float const css_to_imgui_scale{bd ? bd->CssToImGuiScale : 1.0f};
-            ImGui::GetIO().AddMousePosEvent(
-                static_cast<float>(mouse_event->clientX) * css_to_imgui_scale,
-                static_cast<float>(mouse_event->clientY) * css_to_imgui_scale
-            );
+            queue_mouse_pos_event(*mouse_event);
             return true;                                                        // the event was consumed
         }
     );
@@ -204,10 +274,14 @@ void ImGui_ImplEmscripten_Init()
         EMSCRIPTEN_EVENT_TARGET_DOCUMENT,                                       // target - WINDOW doesn't produce mouseenter events
         nullptr,                                                                // userData
         false,                                                                  // useCapture
-        [](int /*event_type*/, EmscriptenMouseEvent const* /*mouse_event*/, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_MOUSELEAVE
-            ImGuiIO& io{ImGui::GetIO()};
-            io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);                            // cursor is not in the window
-            io.ClearInputKeys();                                                // clear pending input keys on mouse exit
+        [](int /*event_type*/, EmscriptenMouseEvent const* mouse_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_MOUSELEAVE
+            queue_mouse_event({
+                .Type{ImGui_ImplEmscripten_MouseEventType_Pos},
+                .Timestamp{mouse_event->timestamp},
+                .Value{-FLT_MAX, -FLT_MAX},                                     // cursor is not in the window
+            });
+            flush_mouse_events();
+            ImGui::GetIO().ClearInputKeys();                                    // clear pending input keys on mouse exit
             return true;                                                        // the event was consumed
         }
     );
@@ -230,12 +304,12 @@ void ImGui_ImplEmscripten_Init()
                 break;
             }
             // TODO: make scrolling speeds configurable
-            ImGuiIO& io{ImGui::GetIO()};
-            io.AddMouseWheelEvent(
-                -static_cast<float>(wheel_event->deltaX) * scale,
-                -static_cast<float>(wheel_event->deltaY) * scale
-            );
-            return io.WantCaptureMouse;                                         // consume the event when imgui wants to capture mouse input
+            queue_mouse_event({
+                .Type{ImGui_ImplEmscripten_MouseEventType_Wheel},
+                .Timestamp{wheel_event->mouse.timestamp},
+                .Value{-static_cast<float>(wheel_event->deltaX) * scale, -static_cast<float>(wheel_event->deltaY) * scale},
+            });
+            return ImGui::GetIO().WantCaptureMouse;                             // consume the event when imgui wants to capture mouse input
         }
     );
     emscripten_set_keydown_callback(
@@ -243,6 +317,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenKeyboardEvent const* key_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_KEYDOWN
+            flush_mouse_events();                                               // keep mouse events ordered before this key event
             const ImGuiKey key{translate_key(key_event->code)};
             ImGuiIO& io{ImGui::GetIO()};
             io.AddKeyEvent(key, true);
@@ -281,6 +356,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenKeyboardEvent const* key_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_KEYUP
+            flush_mouse_events();                                               // keep mouse events ordered before this key event
             const ImGuiKey key{translate_key(key_event->code)};
             ImGuiIO& io{ImGui::GetIO()};
             io.AddKeyEvent(key, false);
@@ -313,6 +389,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenKeyboardEvent const* key_event, void* /*data*/) { // callback, event_type == EMSCRIPTEN_EVENT_KEYPRESS
+            flush_mouse_events();
             ImGuiIO& io{ImGui::GetIO()};
             io.AddInputCharactersUTF8(key_event->key);
             return io.WantCaptureKeyboard;                                      // the event was consumed only if imgui wants to capture the keyboard
@@ -334,6 +411,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenFocusEvent const* /*event*/, void* /*data*/) { // event_type == EMSCRIPTEN_EVENT_BLUR
+            flush_mouse_events();
             ImGuiIO& io{ImGui::GetIO()};
             io.AddFocusEvent(false);
             io.ClearInputKeys();                                                // clear pending input keys on focus loss
@@ -345,6 +423,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenFocusEvent const* /*event*/, void* /*data*/) { // event_type == EMSCRIPTEN_EVENT_FOCUS
+            flush_mouse_events();
             ImGuiIO& io{ImGui::GetIO()};
             io.AddFocusEvent(true);
             io.ClearInputKeys();                                                // clear pending input keys on focus gain - for example if you press tab to cycle back into the browser window
@@ -356,6 +435,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenFocusEvent const* /*event*/, void* /*data*/) { // event_type == EMSCRIPTEN_EVENT_FOCUSIN
+            flush_mouse_events();
             ImGuiIO& io{ImGui::GetIO()};
             io.AddFocusEvent(true);
             io.ClearInputKeys();                                                // clear pending input keys on focus gain
@@ -367,6 +447,7 @@ void ImGui_ImplEmscripten_Init()
         nullptr,                                                                // userData
         false,                                                                  // useCapture
         [](int /*event_type*/, EmscriptenFocusEvent const* /*event*/, void* /*data*/) { // event_type == EMSCRIPTEN_EVENT_FOCUSOUT
+            flush_mouse_events();
             ImGuiIO& io{ImGui::GetIO()};
             io.AddFocusEvent(false);
             io.ClearInputKeys();                                                // clear pending input keys on focus loss - for example if you press tab to cycle to another part of the UI
@@ -514,10 +595,22 @@ void ImGui_ImplEmscripten_NewFrame()
     ImGui_ImplEmscripten_Data* bd{ImGui_ImplEmscripten_GetBackendData()};
     IM_ASSERT(bd != nullptr && "Context or backend not initialized? Did you call ImGui_ImplEmscripten_Init()?");
 
+    // Submit the mouse input buffered since the last frame
+    flush_mouse_events();
+    bd->RawMouseHistory.swap(bd->RawMouseEvents);
+    bd->RawMouseEvents.resize(0);
+
     // Update any state that needs to be polled
     update_cursor(bd);
 }
 
+ImVector<ImGui_ImplEmscripten_MouseEvent> const& ImGui_ImplEmscripten_GetRawMouseHistory()
+{
+    ImGui_ImplEmscripten_Data* bd{ImGui_ImplEmscripten_GetBackendData()};
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized? Did you call ImGui_ImplEmscripten_Init()?");
+    return bd->RawMouseHistory;
+}
+
 namespace emscripten_browser_cursor_internal
 {
 
@@ -590,229 +683,333 @@ constexpr ImGuiMouseButton translate_mousebutton(unsigned short emscripten_butto
     return emscripten_button;                                                   // any other button translates 1:1
 }
 
-ImGuiStorage const& get_key_translation_storage()
+struct KeyTranslation
 {
-    static ImGuiStorage storage;
-    static bool is_initialized{false};
-    if (is_initialized) return storage;
-    is_initialized = true;
-    storage.Data.reserve(128);
-
-    // main character keys
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Backquote"),          ImGuiKey_GraveAccent));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Backslash"),          ImGuiKey_Backslash));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("BracketLeft"),        ImGuiKey_LeftBracket));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("BracketRight"),       ImGuiKey_RightBracket));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Comma"),              ImGuiKey_Comma));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit0"),             ImGuiKey_0));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit1"),             ImGuiKey_1));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit2"),             ImGuiKey_2));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit3"),             ImGuiKey_3));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit4"),             ImGuiKey_4));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit5"),             ImGuiKey_5));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit6"),             ImGuiKey_6));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit7"),             ImGuiKey_7));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit8"),             ImGuiKey_8));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Digit9"),             ImGuiKey_9));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Equal"),              ImGuiKey_Equal));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("IntlBackslash"),      ImGuiKey_Backslash)); // Mapping to generic backslash
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("IntlRo"),             ImGuiKey_Slash)); // Closest match for non-standard layouts
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("IntlYen"),            ImGuiKey_Backslash)); // Closest match for non-standard layouts
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyA"),               ImGuiKey_A));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyB"),               ImGuiKey_B));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyC"),               ImGuiKey_C));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyD"),               ImGuiKey_D));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyE"),               ImGuiKey_E));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyF"),               ImGuiKey_F));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyG"),               ImGuiKey_G));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyH"),               ImGuiKey_H));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyI"),               ImGuiKey_I));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyJ"),               ImGuiKey_J));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyK"),               ImGuiKey_K));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyL"),               ImGuiKey_L));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyM"),               ImGuiKey_M));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyN"),               ImGuiKey_N));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyO"),               ImGuiKey_O));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyP"),               ImGuiKey_P));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyQ"),               ImGuiKey_Q));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyR"),               ImGuiKey_R));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyS"),               ImGuiKey_S));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyT"),               ImGuiKey_T));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyU"),               ImGuiKey_U));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyV"),               ImGuiKey_V));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyW"),               ImGuiKey_W));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyX"),               ImGuiKey_X));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyY"),               ImGuiKey_Y));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("KeyZ"),               ImGuiKey_Z));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Minus"),              ImGuiKey_Minus));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Period"),             ImGuiKey_Period));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Quote"),              ImGuiKey_Apostrophe));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Semicolon"),          ImGuiKey_Semicolon));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Slash"),              ImGuiKey_Slash));
+    char const* Code;                                                           // W3C KeyboardEvent.code string
+    ImGuiKey Key;
+};
+
+constexpr KeyTranslation key_translations[]{
+    {"Backquote",            ImGuiKey_GraveAccent},
+    {"Backslash",            ImGuiKey_Backslash},
+    {"BracketLeft",          ImGuiKey_LeftBracket},
+    {"BracketRight",         ImGuiKey_RightBracket},
+    {"Comma",                ImGuiKey_Comma},
+    {"Digit0",               ImGuiKey_0},
+    {"Digit1",               ImGuiKey_1},
+    {"Digit2",               ImGuiKey_2},
+    {"Digit3",               ImGuiKey_3},
+    {"Digit4",               ImGuiKey_4},
+    {"Digit5",               ImGuiKey_5},
+    {"Digit6",               ImGuiKey_6},
+    {"Digit7",               ImGuiKey_7},
+    {"Digit8",               ImGuiKey_8},
+    {"Digit9",               ImGuiKey_9},
+    {"Equal",                ImGuiKey_Equal},
+    {"IntlBackslash",        ImGuiKey_Backslash}, // Mapping to generic backslash
+    {"IntlRo",               ImGuiKey_Slash}, // Closest match for non-standard layouts
+    {"IntlYen",              ImGuiKey_Backslash}, // Closest match for non-standard layouts
+    {"KeyA",                 ImGuiKey_A},
+    {"KeyB",                 ImGuiKey_B},
+    {"KeyC",                 ImGuiKey_C},
+    {"KeyD",                 ImGuiKey_D},
+    {"KeyE",                 ImGuiKey_E},
+    {"KeyF",                 ImGuiKey_F},
+    {"KeyG",                 ImGuiKey_G},
+    {"KeyH",                 ImGuiKey_H},
+    {"KeyI",                 ImGuiKey_I},
+    {"KeyJ",                 ImGuiKey_J},
+    {"KeyK",                 ImGuiKey_K},
+    {"KeyL",                 ImGuiKey_L},
+    {"KeyM",                 ImGuiKey_M},
+    {"KeyN",                 ImGuiKey_N},
+    {"KeyO",                 ImGuiKey_O},
+    {"KeyP",                 ImGuiKey_P},
+    {"KeyQ",                 ImGuiKey_Q},
+    {"KeyR",                 ImGuiKey_R},
+    {"KeyS",                 ImGuiKey_S},
+    {"KeyT",                 ImGuiKey_T},
+    {"KeyU",                 ImGuiKey_U},
+    {"KeyV",                 ImGuiKey_V},
+    {"KeyW",                 ImGuiKey_W},
+    {"KeyX",                 ImGuiKey_X},
+    {"KeyY",                 ImGuiKey_Y},
+    {"KeyZ",                 ImGuiKey_Z},
+    {"Minus",                ImGuiKey_Minus},
+    {"Period",               ImGuiKey_Period},
+    {"Quote",                ImGuiKey_Apostrophe},
+    {"Semicolon",            ImGuiKey_Semicolon},
+    {"Slash",                ImGuiKey_Slash},
 
     // control keys
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("AltLeft"),            ImGuiKey_LeftAlt));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("AltRight"),           ImGuiKey_RightAlt));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Backspace"),          ImGuiKey_Backspace));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("CapsLock"),           ImGuiKey_CapsLock));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ContextMenu"),        ImGuiKey_Menu));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ControlLeft"),        ImGuiKey_LeftCtrl));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ControlRight"),       ImGuiKey_RightCtrl));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Enter"),              ImGuiKey_Enter));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("MetaLeft"),           ImGuiKey_LeftSuper));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("MetaRight"),          ImGuiKey_RightSuper));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ShiftLeft"),          ImGuiKey_LeftShift));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ShiftRight"),         ImGuiKey_RightShift));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Space"),              ImGuiKey_Space));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Tab"),                ImGuiKey_Tab));
+    {"AltLeft",              ImGuiKey_LeftAlt},
+    {"AltRight",             ImGuiKey_RightAlt},
+    {"Backspace",            ImGuiKey_Backspace},
+    {"CapsLock",             ImGuiKey_CapsLock},
+    {"ContextMenu",          ImGuiKey_Menu},
+    {"ControlLeft",          ImGuiKey_LeftCtrl},
+    {"ControlRight",         ImGuiKey_RightCtrl},
+    {"Enter",                ImGuiKey_Enter},
+    {"MetaLeft",             ImGuiKey_LeftSuper},
+    {"MetaRight",            ImGuiKey_RightSuper},
+    {"ShiftLeft",            ImGuiKey_LeftShift},
+    {"ShiftRight",           ImGuiKey_RightShift},
+    {"Space",                ImGuiKey_Space},
+    {"Tab",                  ImGuiKey_Tab},
 
     // navigation key group
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Delete"),             ImGuiKey_Delete));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("End"),                ImGuiKey_End));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Help"),               ImGuiKey_PrintScreen)); // Best approximation
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Home"),               ImGuiKey_Home));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Insert"),             ImGuiKey_Insert));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("PageDown"),           ImGuiKey_PageDown));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("PageUp"),             ImGuiKey_PageUp));
+    {"Delete",               ImGuiKey_Delete},
+    {"End",                  ImGuiKey_End},
+    //{"Help",                 ImGuiKey_PrintScreen}, // Best approximation
+    {"Home",                 ImGuiKey_Home},
+    {"Insert",               ImGuiKey_Insert},
+    {"PageDown",             ImGuiKey_PageDown},
+    {"PageUp",               ImGuiKey_PageUp},
 
     // arrow key group
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ArrowDown"),          ImGuiKey_DownArrow));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ArrowLeft"),          ImGuiKey_LeftArrow));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ArrowRight"),         ImGuiKey_RightArrow));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ArrowUp"),            ImGuiKey_UpArrow));
+    {"ArrowDown",            ImGuiKey_DownArrow},
+    {"ArrowLeft",            ImGuiKey_LeftArrow},
+    {"ArrowRight",           ImGuiKey_RightArrow},
+    {"ArrowUp",              ImGuiKey_UpArrow},
 
     // browser key group
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("BrowserBack"),        ImGuiKey_AppBack)); // Pass through so the embedding app can decide
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("BrowserFavorites"),   ImGuiKey_None)); // No direct mapping
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("BrowserForward"),     ImGuiKey_AppForward)); // Pass through so the embedding app can decide
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("BrowserHome"),        ImGuiKey_None)); // No direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("BrowserRefresh"),     ImGuiKey_None)); // No direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("BrowserSearch"),      ImGuiKey_None)); // No direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("BrowserStop"),        ImGuiKey_None)); // No direct mapping
+    {"BrowserBack",          ImGuiKey_AppBack}, // Pass through so the embedding app can decide
+    //{"BrowserFavorites",     ImGuiKey_None}, // No direct mapping
+    {"BrowserForward",       ImGuiKey_AppForward}, // Pass through so the embedding app can decide
+    //{"BrowserHome",          ImGuiKey_None}, // No direct mapping
+    //{"BrowserRefresh",       ImGuiKey_None}, // No direct mapping
+    //{"BrowserSearch",        ImGuiKey_None}, // No direct mapping
+    //{"BrowserStop",          ImGuiKey_None}, // No direct mapping
 
     // number pad group
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumLock"),            ImGuiKey_NumLock));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad0"),            ImGuiKey_Keypad0));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad1"),            ImGuiKey_Keypad1));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad2"),            ImGuiKey_Keypad2));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad3"),            ImGuiKey_Keypad3));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad4"),            ImGuiKey_Keypad4));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad5"),            ImGuiKey_Keypad5));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad6"),            ImGuiKey_Keypad6));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad7"),            ImGuiKey_Keypad7));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad8"),            ImGuiKey_Keypad8));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Numpad9"),            ImGuiKey_Keypad9));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadAdd"),          ImGuiKey_KeypadAdd));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadBackspace"),    ImGuiKey_Backspace)); // No direct mapping; backspace functionality
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadClear"),        ImGuiKey_None)); // No defined Dear ImGui mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadClearEntry"),   ImGuiKey_None)); // No defined Dear ImGui mapping
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadComma"),        ImGuiKey_KeypadDecimal)); // Closest match
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadDecimal"),      ImGuiKey_KeypadDecimal));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadDivide"),       ImGuiKey_KeypadDivide));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadEnter"),        ImGuiKey_KeypadEnter));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadEqual"),        ImGuiKey_KeypadEqual));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadHash"),         ImGuiKey_Backslash)); // Mapped to generic backslash for telephone-style '#'
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadMemoryAdd"),    ImGuiKey_None)); // No defined mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadMemoryClear"),  ImGuiKey_None)); // No defined mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadMemoryRecall"), ImGuiKey_None)); // No defined mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadMemoryStore"),  ImGuiKey_None)); // No defined mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadMemorySubtract"), ImGuiKey_None)); // No defined mapping
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadMultiply"),     ImGuiKey_KeypadMultiply));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadParenLeft"),    ImGuiKey_LeftBracket)); // Closest available
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadParenRight"),   ImGuiKey_RightBracket)); // Closest available
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadStar"),         ImGuiKey_KeypadMultiply)); // Same as multiply
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("NumpadSubtract"),     ImGuiKey_KeypadSubtract));
+    {"NumLock",              ImGuiKey_NumLock},
+    {"Numpad0",              ImGuiKey_Keypad0},
+    {"Numpad1",              ImGuiKey_Keypad1},
+    {"Numpad2",              ImGuiKey_Keypad2},
+    {"Numpad3",              ImGuiKey_Keypad3},
+    {"Numpad4",              ImGuiKey_Keypad4},
+    {"Numpad5",              ImGuiKey_Keypad5},
+    {"Numpad6",              ImGuiKey_Keypad6},
+    {"Numpad7",              ImGuiKey_Keypad7},
+    {"Numpad8",              ImGuiKey_Keypad8},
+    {"Numpad9",              ImGuiKey_Keypad9},
+    {"NumpadAdd",            ImGuiKey_KeypadAdd},
+    {"NumpadBackspace",      ImGuiKey_Backspace}, // No direct mapping; backspace functionality
+    //{"NumpadClear",          ImGuiKey_None}, // No defined Dear ImGui mapping
+    //{"NumpadClearEntry",     ImGuiKey_None}, // No defined Dear ImGui mapping
+    {"NumpadComma",          ImGuiKey_KeypadDecimal}, // Closest match
+    {"NumpadDecimal",        ImGuiKey_KeypadDecimal},
+    {"NumpadDivide",         ImGuiKey_KeypadDivide},
+    {"NumpadEnter",          ImGuiKey_KeypadEnter},
+    {"NumpadEqual",          ImGuiKey_KeypadEqual},
+    {"NumpadHash",           ImGuiKey_Backslash}, // Mapped to generic backslash for telephone-style '#'
+    //{"NumpadMemoryAdd",      ImGuiKey_None}, // No defined mapping
+    //{"NumpadMemoryClear",    ImGuiKey_None}, // No defined mapping
+    //{"NumpadMemoryRecall",   ImGuiKey_None}, // No defined mapping
+    //{"NumpadMemoryStore",    ImGuiKey_None}, // No defined mapping
+    //{"NumpadMemorySubtract", ImGuiKey_None}, // No defined mapping
+    {"NumpadMultiply",       ImGuiKey_KeypadMultiply},
+    {"NumpadParenLeft",      ImGuiKey_LeftBracket}, // Closest available
+    {"NumpadParenRight",     ImGuiKey_RightBracket}, // Closest available
+    {"NumpadStar",           ImGuiKey_KeypadMultiply}, // Same as multiply
+    {"NumpadSubtract",       ImGuiKey_KeypadSubtract},
 
     // top row key group
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Escape"),             ImGuiKey_Escape));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F1"),                 ImGuiKey_F1));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F2"),                 ImGuiKey_F2));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F3"),                 ImGuiKey_F3));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F4"),                 ImGuiKey_F4));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F5"),                 ImGuiKey_F5));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F6"),                 ImGuiKey_F6));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F7"),                 ImGuiKey_F7));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F8"),                 ImGuiKey_F8));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F9"),                 ImGuiKey_F9));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F10"),                ImGuiKey_F10));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F11"),                ImGuiKey_F11));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F12"),                ImGuiKey_F12));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F13"),                ImGuiKey_F13));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F14"),                ImGuiKey_F14));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F15"),                ImGuiKey_F15));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F16"),                ImGuiKey_F16));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F17"),                ImGuiKey_F17));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F18"),                ImGuiKey_F18));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F19"),                ImGuiKey_F19));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F20"),                ImGuiKey_F20));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F21"),                ImGuiKey_F21));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F22"),                ImGuiKey_F22));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F23"),                ImGuiKey_F23));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("F24"),                ImGuiKey_F24));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Fn"),                 ImGuiKey_None)); // No direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("FnLock"),             ImGuiKey_None)); // No direct mapping
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("PrintScreen"),        ImGuiKey_PrintScreen));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("ScrollLock"),         ImGuiKey_ScrollLock));
-    storage.Data.push_back(ImGuiStoragePair(ImHashStr("Pause"),              ImGuiKey_Pause));
+    {"Escape",               ImGuiKey_Escape},
+    {"F1",                   ImGuiKey_F1},
+    {"F2",                   ImGuiKey_F2},
+    {"F3",                   ImGuiKey_F3},
+    {"F4",                   ImGuiKey_F4},
+    {"F5",                   ImGuiKey_F5},
+    {"F6",                   ImGuiKey_F6},
+    {"F7",                   ImGuiKey_F7},
+    {"F8",                   ImGuiKey_F8},
+    {"F9",                   ImGuiKey_F9},
+    {"F10",                  ImGuiKey_F10},
+    {"F11",                  ImGuiKey_F11},
+    {"F12",                  ImGuiKey_F12},
+    {"F13",                  ImGuiKey_F13},
+    {"F14",                  ImGuiKey_F14},
+    {"F15",                  ImGuiKey_F15},
+    {"F16",                  ImGuiKey_F16},
+    {"F17",                  ImGuiKey_F17},
+    {"F18",                  ImGuiKey_F18},
+    {"F19",                  ImGuiKey_F19},
+    {"F20",                  ImGuiKey_F20},
+    {"F21",                  ImGuiKey_F21},
+    {"F22",                  ImGuiKey_F22},
+    {"F23",                  ImGuiKey_F23},
+    {"F24",                  ImGuiKey_F24},
+    //{"Fn",                   ImGuiKey_None}, // No direct mapping
+    //{"FnLock",               ImGuiKey_None}, // No direct mapping
+    {"PrintScreen",          ImGuiKey_PrintScreen},
+    {"ScrollLock",           ImGuiKey_ScrollLock},
+    {"Pause",                ImGuiKey_Pause},
 
     // clipboard/editing keys without direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Abort"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Again"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Convert"),            ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Copy"),               ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Cut"),                ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Find"),               ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Open"),               ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Paste"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Props"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Resume"),             ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Select"),             ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Undo"),               ImGuiKey_None));
+    //{"Abort",                ImGuiKey_None},
+    //{"Again",                ImGuiKey_None},
+    //{"Convert",              ImGuiKey_None},
+    //{"Copy",                 ImGuiKey_None},
+    //{"Cut",                  ImGuiKey_None},
+    //{"Find",                 ImGuiKey_None},
+    //{"Open",                 ImGuiKey_None},
+    //{"Paste",                ImGuiKey_None},
+    //{"Props",                ImGuiKey_None},
+    //{"Resume",               ImGuiKey_None},
+    //{"Select",               ImGuiKey_None},
+    //{"Undo",                 ImGuiKey_None},
 
     // IME and international keys without direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Hiragana"),           ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("KanaMode"),           ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Katakana"),           ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Lang1"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Lang2"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("NonConvert"),         ImGuiKey_None));
+    //{"Hiragana",             ImGuiKey_None},
+    //{"KanaMode",             ImGuiKey_None},
+    //{"Katakana",             ImGuiKey_None},
+    //{"Lang1",                ImGuiKey_None},
+    //{"Lang2",                ImGuiKey_None},
+    //{"NonConvert",           ImGuiKey_None},
 
     // media and launcher keys without direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("AudioVolumeDown"),    ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("AudioVolumeMute"),    ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("AudioVolumeUp"),      ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("LaunchApp1"),         ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("LaunchApp2"),         ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("LaunchMail"),         ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("MediaPlayPause"),     ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("MediaSelect"),        ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("MediaStop"),          ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("MediaTrackNext"),     ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("MediaTrackPrevious"), ImGuiKey_None));
+    //{"AudioVolumeDown",      ImGuiKey_None},
+    //{"AudioVolumeMute",      ImGuiKey_None},
+    //{"AudioVolumeUp",        ImGuiKey_None},
+    //{"LaunchApp1",           ImGuiKey_None},
+    //{"LaunchApp2",           ImGuiKey_None},
+    //{"LaunchMail",           ImGuiKey_None},
+    //{"MediaPlayPause",       ImGuiKey_None},
+    //{"MediaSelect",          ImGuiKey_None},
+    //{"MediaStop",            ImGuiKey_None},
+    //{"MediaTrackNext",       ImGuiKey_None},
+    //{"MediaTrackPrevious",   ImGuiKey_None},
 
     // system keys without direct mapping
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Eject"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Hyper"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Power"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Sleep"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Super"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Suspend"),            ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Turbo"),              ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("Unidentified"),       ImGuiKey_None));
-    //storage.Data.push_back(ImGuiStoragePair(ImHashStr("WakeUp"),             ImGuiKey_None));
-
-    storage.BuildSortByKey();
-    return storage;
+    //{"Eject",                ImGuiKey_None},
+    //{"Hyper",                ImGuiKey_None},
+    //{"Power",                ImGuiKey_None},
+    //{"Sleep",                ImGuiKey_None},
+    //{"Super",                ImGuiKey_None},
+    //{"Suspend",              ImGuiKey_None},
+    //{"Turbo",                ImGuiKey_None},
+    //{"Unidentified",         ImGuiKey_None},
+    //{"WakeUp",               ImGuiKey_None},
+};
+
+constexpr ImU32 hash_key_code(char const* code)
+{
+    // FNV-1a hash of a KeyboardEvent.code string, usable at compile time
+    ImU32 hash{2166136261u};
+    for (; *code != '\0'; ++code) hash = (hash ^ static_cast<unsigned char>(*code)) * 16777619u;
+    return hash;
+}
+
+constexpr ImU32 mix_key_code_hash(ImU32 hash, ImU32 seed)
+{
+    // Rehash a code hash with a per-bucket seed, using the murmur3 finaliser so every seed gives an independent slot
+    hash ^= seed * 0x9E3779B9u;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
 }
 
-ImGuiKey translate_key(char const* emscripten_key)
+constexpr bool key_codes_equal(char const* lhs, char const* rhs)
+{
+    for (; *lhs != '\0' && *lhs == *rhs; ++lhs, ++rhs) {}
+    return *lhs == *rhs;
+}
+
+// Perfect hash over key_translations, built at compile time by hash-and-displace: each code falls into a bucket by its
+// hash, and each bucket is given the first seed that places all of its codes into distinct free slots.
+struct KeyTranslationTable
+{
+    static constexpr int BucketCount{64};
+    static constexpr int SlotCount{256};
+    static constexpr int MaxSeed{255};
+    static_assert(IM_ARRAYSIZE(key_translations) <= SlotCount / 2, "Key translation table is too full to build quickly, increase SlotCount.");
+
+    ImU8 BucketSeeds[BucketCount]{};
+    ImS16 Slots[SlotCount]{};                                                   // index into key_translations, or -1 for an empty slot
+    bool IsComplete{false};                                                     // false if some bucket couldn't be placed
+
+    static constexpr int get_bucket(ImU32 hash) { return static_cast<int>(hash % BucketCount); }
+    static constexpr int get_slot(ImU32 hash, ImU32 seed) { return static_cast<int>(mix_key_code_hash(hash, seed) % SlotCount); }
+
+    consteval KeyTranslationTable()
+    {
+        constexpr int key_count{IM_ARRAYSIZE(key_translations)};
+        ImU32 hashes[key_count]{};
+        int bucket_sizes[BucketCount]{};
+        int max_bucket_size{0};
+        for (int i{0}; i != key_count; ++i)
+        {
+            hashes[i] = hash_key_code(key_translations[i].Code);
+            int const size{++bucket_sizes[get_bucket(hashes[i])]};
+            if (size > max_bucket_size) max_bucket_size = size;
+        }
+        for (ImS16& slot : Slots) slot = -1;
+
+        for (int size{max_bucket_size}; size != 0; --size)                      // place the largest buckets first, while the table is emptiest
+        {
+            for (int bucket{0}; bucket != BucketCount; ++bucket)
+            {
+                if (bucket_sizes[bucket] != size) continue;
+                int seed{1};
+                for (; seed <= MaxSeed; ++seed)
+                {
+                    int placed{0};
+                    for (int i{0}; i != key_count; ++i)                         // tentatively place the bucket's codes, backing out on a collision
+                    {
+                        if (get_bucket(hashes[i]) != bucket) continue;
+                        ImS16& slot{Slots[get_slot(hashes[i], static_cast<ImU32>(seed))]};
+                        if (slot != -1) break;
+                        slot = static_cast<ImS16>(i);
+                        ++placed;
+                    }
+                    if (placed == size) break;
+                    for (int i{0}; i != key_count && placed != 0; ++i)
+                    {
+                        if (get_bucket(hashes[i]) != bucket) continue;
+                        Slots[get_slot(hashes[i], static_cast<ImU32>(seed))] = -1;
+                        --placed;
+                    }
+                }
+                if (seed > MaxSeed) return;                                     // leaves the table incomplete, caught by the static_assert below
+                BucketSeeds[bucket] = static_cast<ImU8>(seed);
+            }
+        }
+        IsComplete = true;
+    }
+
+    constexpr ImGuiKey find(char const* code) const
+    {
+        ImU32 const hash{hash_key_code(code)};
+        int const index{Slots[get_slot(hash, BucketSeeds[get_bucket(hash)])]};
+        if (index == -1 || !key_codes_equal(key_translations[index].Code, code)) return ImGuiKey_None;
+        return key_translations[index].Key;
+    }
+};
+
+constexpr KeyTranslationTable key_translation_table;
+static_assert(key_translation_table.IsComplete, "Could not find a perfect hash seed for every key translation bucket, increase SlotCount.");
+
+constexpr ImGuiKey translate_key(char const* emscripten_key)
 {
     // Translate a W3C KeyboardEvent.code string into an ImGuiKey.
     if (emscripten_key == nullptr || emscripten_key[0] == '\0') return ImGuiKey_None;
+    return key_translation_table.find(emscripten_key);
+}
 
-    ImGuiStorage const& storage{get_key_translation_storage()};
-    return static_cast<ImGuiKey>(storage.GetInt(ImHashStr(emscripten_key), ImGuiKey_None));
+consteval bool verify_key_translations()
+{
+    // Check at compile time that every code in the table translates to its own key, and that codes outside it don't.
+    for (KeyTranslation const& translation : key_translations)
+    {
+        if (translate_key(translation.Code) != translation.Key) return false;
+    }
+    return translate_key("Fn") == ImGuiKey_None && translate_key("Unidentified") == ImGuiKey_None && translate_key("keya") == ImGuiKey_None;
 }
+static_assert(verify_key_translations(), "Key translation table does not round-trip every KeyboardEvent.code.");
 
 } // anonymous namespace
 
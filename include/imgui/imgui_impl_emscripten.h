@@ -16,7 +16,7 @@
 // Supported features:
 // - Keyboard input
 // - Window resizing
-// - Cursor position
+// - Cursor position, with high frequency mouse events coalesced per frame
 // - Cursor enters and leaves the window
 // - Application focus
 // - Browser cursors
@@ -44,6 +44,27 @@
 // Default 1.0f gives 1:1 device-pixel rendering. Set before Init() if you want a different scaling policy.
 extern IMGUI_IMPL_API float ImGui_ImplEmscripten_TargetDevicePixelRatio;
 
+// Mouse events are buffered between frames, with consecutive moves and consecutive wheel events merged, before being passed to Dear ImGui.
+// High polling rate mice can otherwise produce hundreds of events per frame.  Button events are never merged and keep their order.
+// Set ImGui_ImplEmscripten_KeepRawMouseHistory to also record every unmerged event, for tools that need the full path (i.e. drawing).
+enum ImGui_ImplEmscripten_MouseEventType
+{
+    ImGui_ImplEmscripten_MouseEventType_Pos,
+    ImGui_ImplEmscripten_MouseEventType_Button,
+    ImGui_ImplEmscripten_MouseEventType_Wheel,
+};
+
+struct ImGui_ImplEmscripten_MouseEvent
+{
+    ImGui_ImplEmscripten_MouseEventType Type;
+    double Timestamp;                                                           // milliseconds, as reported by the browser
+    ImVec2 Value;                                                               // position in Dear ImGui coordinates for Pos events, scroll amount for Wheel events
+    ImGuiMouseButton Button;                                                    // Button events only
+    bool Down;                                                                  // Button events only
+};
+
+extern IMGUI_IMPL_API bool ImGui_ImplEmscripten_KeepRawMouseHistory;
+
 // Initialise the Emscripten backend, setting input callbacks.  This should be called after ImGui::CreateContext();
 IMGUI_IMPL_API void ImGui_ImplEmscripten_Init();
 
@@ -53,8 +74,10 @@ IMGUI_IMPL_API void ImGui_ImplEmscripten_Init();
 // Otherwise, there is not necessarily any such concept as "shutting down" when running in the browser, and we have no resources to release.  The user can just close the tab, so you don't need to worry about exiting cleanly.
 IMGUI_IMPL_API void ImGui_ImplEmscripten_Shutdown();
 
-// Call every frame to synchronize Dear ImGui's cursor state with the browser's native cursors.
-// If you are not using browser native cursor rendering (i.e. if Dear ImGui is rendering cursors internally), you don't need to call this.
+// Call every frame, before ImGui::NewFrame(), to submit buffered mouse input and synchronize Dear ImGui's cursor state with the browser's native cursors.
 IMGUI_IMPL_API void ImGui_ImplEmscripten_NewFrame();
 
+// Every mouse event received between the previous two calls to NewFrame(), unmerged, if ImGui_ImplEmscripten_KeepRawMouseHistory is set.
+IMGUI_IMPL_API ImVector<ImGui_ImplEmscripten_MouseEvent> const& ImGui_ImplEmscripten_GetRawMouseHistory();
+
 #endif // IMGUI_DISABLE
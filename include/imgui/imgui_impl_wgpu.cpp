@@ -77,14 +77,29 @@ struct RenderResources
     WGPUBindGroupLayout ImageBindGroupLayout = nullptr; // Cache layout used for the image bind group. Avoids allocating unnecessary JS objects when working with WebASM
 };
 
+// What was last uploaded for one draw list into a frame's buffers, so unchanged lists can skip their upload
+struct DrawListUploadState
+{
+    int         VtxOffset;                              // Offset into VertexBuffer the vertices were written at, in vertices
+    int         IdxOffset;                              // Offset into IndexBuffer the indices were written at, in indices
+    ImGuiID     VtxHash;                                // Content hash of the uploaded vertices
+    ImGuiID     IdxHash;                                // Content hash of the uploaded indices
+};
+
+// Content hashes of one draw list, computed once per frame by ImGui_ImplWGPU_HashDrawData()
+struct DrawListHashes
+{
+    ImGuiID     VtxHash;                                // Hash of the vertices, seeded with their count
+    ImGuiID     IdxHash;                                // Hash of the indices, seeded with their count
+};
+
 struct FrameResources
 {
     WGPUBuffer  IndexBuffer;
     WGPUBuffer  VertexBuffer;
-    ImDrawIdx*  IndexBufferHost;
-    ImDrawVert* VertexBufferHost;
-    int         IndexBufferSize;
-    int         VertexBufferSize;
+    int         IndexBufferSize;                        // Capacity of IndexBuffer, in indices
+    int         VertexBufferSize;                       // Capacity of VertexBuffer, in vertices
+    ImVector<DrawListUploadState> UploadStates;         // Per draw list record of the current buffer contents
 };
 
 struct Uniforms
@@ -106,6 +121,10 @@ struct ImGui_ImplWGPU_Data
     FrameResources*         pFrameResources = nullptr;
     unsigned int            numFramesInFlight = 0;
     unsigned int            frameIndex = UINT_MAX;
+
+    ImVector<DrawListHashes> listHashes;                // Per draw list hashes of the draw data hashed in listHashesFrame
+    ImDrawData*             listHashesDrawData = nullptr;
+    int                     listHashesFrame = -1;
 };
 
 // Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
@@ -173,18 +192,14 @@ fn main(in: VertexOutput) -> @location(0) vec4<f32> {
 }
 )";
 
-static void SafeRelease(ImDrawIdx*& res)
+// Tell the application about a buffer or texture being created or released, if it asked
+static void ImGui_ImplWGPU_ReportMemory(const void* resource, size_t size)
 {
-    if (res)
-        delete[] res;
-    res = nullptr;
-}
-static void SafeRelease(ImDrawVert*& res)
-{
-    if (res)
-        delete[] res;
-    res = nullptr;
+    ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
+    if (bd && bd->initInfo.MemoryCallback && resource)
+        bd->initInfo.MemoryCallback(resource, size, bd->initInfo.MemoryCallbackUserData);
 }
+
 static void SafeRelease(WGPUBindGroupLayout& res)
 {
     if (res)
@@ -199,6 +214,7 @@ static void SafeRelease(WGPUBindGroup& res)
 }
 static void SafeRelease(WGPUBuffer& res)
 {
+    ImGui_ImplWGPU_ReportMemory(res, 0);
     if (res)
         wgpuBufferRelease(res);
     res = nullptr;
@@ -235,6 +251,7 @@ static void SafeRelease(WGPUTextureView& res)
 }
 static void SafeRelease(WGPUTexture& res)
 {
+    ImGui_ImplWGPU_ReportMemory(res, 0);
     if (res)
         wgpuTextureRelease(res);
     res = nullptr;
@@ -242,6 +259,10 @@ static void SafeRelease(WGPUTexture& res)
 
 static void SafeRelease(RenderResources& res)
 {
+    for (ImGuiStoragePair& pair : res.ImageBindGroups.Data)
+        if (pair.val_p != res.ImageBindGroup)
+            SafeRelease((WGPUBindGroup&)pair.val_p);
+    res.ImageBindGroups.Clear();
     SafeRelease(res.FontTexture);
     SafeRelease(res.FontTextureView);
     SafeRelease(res.Sampler);
@@ -255,8 +276,44 @@ static void SafeRelease(FrameResources& res)
 {
     SafeRelease(res.IndexBuffer);
     SafeRelease(res.VertexBuffer);
-    SafeRelease(res.IndexBufferHost);
-    SafeRelease(res.VertexBufferHost);
+    res.UploadStates.clear();
+}
+
+// Buffers grow geometrically so that a steadily growing GUI reallocates a logarithmic number of times
+static int ImGui_ImplWGPU_GrowBufferSize(int current_size, int required_size)
+{
+    int new_size = current_size > 0 ? current_size : 1;
+    while (new_size < required_size)
+        new_size *= 2;
+    return new_size;
+}
+
+// wgpuQueueWriteBuffer() requires 4-byte aligned offsets, so each draw list's indices start on a 4-byte boundary
+static int ImGui_ImplWGPU_PaddedIdxCount(int idx_count)
+{
+    return (int)(MEMALIGN(idx_count * sizeof(ImDrawIdx), 4) / sizeof(ImDrawIdx));
+}
+
+ImGuiID ImGui_ImplWGPU_HashDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
+    ImGuiID hash = ImHashData(&draw_data->DisplayPos, sizeof(draw_data->DisplayPos), (ImGuiID)draw_data->CmdListsCount);
+    hash = ImHashData(&draw_data->DisplaySize, sizeof(draw_data->DisplaySize), hash);
+    hash = ImHashData(&draw_data->FramebufferScale, sizeof(draw_data->FramebufferScale), hash);
+    bd->listHashes.resize(draw_data->CmdListsCount);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        DrawListHashes& list_hashes = bd->listHashes[n];
+        list_hashes.VtxHash = ImHashData(draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert), (ImGuiID)draw_list->VtxBuffer.Size);
+        list_hashes.IdxHash = ImHashData(draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx), (ImGuiID)draw_list->IdxBuffer.Size);
+        ImGuiID cmd_hash = ImHashData(draw_list->CmdBuffer.Data, draw_list->CmdBuffer.Size * sizeof(ImDrawCmd), (ImGuiID)draw_list->CmdBuffer.Size); // Includes texture ids and clip rects
+        hash = ImHashData(&list_hashes, sizeof(list_hashes), hash);
+        hash = ImHashData(&cmd_hash, sizeof(cmd_hash), hash);
+    }
+    bd->listHashesDrawData = draw_data;
+    bd->listHashesFrame = ImGui::GetFrameCount();
+    return hash;
 }
 
 static WGPUProgrammableStageDescriptor ImGui_ImplWGPU_CreateShaderModule(const char* wgsl_source)
@@ -381,15 +438,17 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
     FrameResources* fr = &bd->pFrameResources[bd->frameIndex % bd->numFramesInFlight];
 
     // Create and grow vertex/index buffers if needed
+    // (each draw list's indices are padded to a 4-byte boundary, so allow for up to one padding index per list)
+    int required_idx_count = draw_data->TotalIdxCount + (sizeof(ImDrawIdx) < 4 ? draw_data->CmdListsCount : 0);
     if (fr->VertexBuffer == nullptr || fr->VertexBufferSize < draw_data->TotalVtxCount)
     {
         if (fr->VertexBuffer)
         {
+            ImGui_ImplWGPU_ReportMemory(fr->VertexBuffer, 0);
             wgpuBufferDestroy(fr->VertexBuffer);
             wgpuBufferRelease(fr->VertexBuffer);
         }
-        SafeRelease(fr->VertexBufferHost);
-        fr->VertexBufferSize = draw_data->TotalVtxCount + 5000;
+        fr->VertexBufferSize = ImGui_ImplWGPU_GrowBufferSize(fr->VertexBufferSize, draw_data->TotalVtxCount);
 
         WGPUBufferDescriptor vb_desc =
         {
@@ -403,20 +462,20 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
             false
         };
         fr->VertexBuffer = wgpuDeviceCreateBuffer(bd->wgpuDevice, &vb_desc);
+        ImGui_ImplWGPU_ReportMemory(fr->VertexBuffer, (size_t)vb_desc.size);
+        fr->UploadStates.clear();
         if (!fr->VertexBuffer)
             return;
-
-        fr->VertexBufferHost = new ImDrawVert[fr->VertexBufferSize];
     }
-    if (fr->IndexBuffer == nullptr || fr->IndexBufferSize < draw_data->TotalIdxCount)
+    if (fr->IndexBuffer == nullptr || fr->IndexBufferSize < required_idx_count)
     {
         if (fr->IndexBuffer)
         {
+            ImGui_ImplWGPU_ReportMemory(fr->IndexBuffer, 0);
             wgpuBufferDestroy(fr->IndexBuffer);
             wgpuBufferRelease(fr->IndexBuffer);
         }
-        SafeRelease(fr->IndexBufferHost);
-        fr->IndexBufferSize = draw_data->TotalIdxCount + 10000;
+        fr->IndexBufferSize = ImGui_ImplWGPU_GrowBufferSize(fr->IndexBufferSize, required_idx_count);
 
         WGPUBufferDescriptor ib_desc =
         {
@@ -430,27 +489,55 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
             false
         };
         fr->IndexBuffer = wgpuDeviceCreateBuffer(bd->wgpuDevice, &ib_desc);
+        ImGui_ImplWGPU_ReportMemory(fr->IndexBuffer, (size_t)ib_desc.size);
+        fr->UploadStates.clear();
         if (!fr->IndexBuffer)
             return;
-
-        fr->IndexBufferHost = new ImDrawIdx[fr->IndexBufferSize];
     }
 
-    // Upload vertex/index data into a single contiguous GPU buffer
-    ImDrawVert* vtx_dst = (ImDrawVert*)fr->VertexBufferHost;
-    ImDrawIdx* idx_dst = (ImDrawIdx*)fr->IndexBufferHost;
+    // Upload each draw list's vertex/index data straight into its region of the GPU buffers, with no intermediate host copy
+    // Lists whose content and offset match what was last written to this frame's buffers are skipped, as the GPU copy is still valid
+    static_assert(sizeof(ImDrawVert) % 4 == 0, "ImDrawVert size must be a multiple of 4 bytes to be written at arbitrary vertex offsets");
+    if (bd->listHashesFrame != ImGui::GetFrameCount() || bd->listHashesDrawData != draw_data || bd->listHashes.Size != draw_data->CmdListsCount)
+        ImGui_ImplWGPU_HashDrawData(draw_data);         // Not already hashed this frame by the caller
+    int global_vtx_offset = 0;
+    int global_idx_offset = 0;
+    int previous_upload_count = fr->UploadStates.Size;
+    fr->UploadStates.resize(draw_data->CmdListsCount);
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* draw_list = draw_data->CmdLists[n];
-        memcpy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
-        memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-        vtx_dst += draw_list->VtxBuffer.Size;
-        idx_dst += draw_list->IdxBuffer.Size;
+        size_t vtx_size = draw_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        size_t idx_size = draw_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+        ImGuiID vtx_hash = bd->listHashes[n].VtxHash;
+        ImGuiID idx_hash = bd->listHashes[n].IdxHash;
+        DrawListUploadState& upload_state = fr->UploadStates[n];
+        bool was_uploaded = n < previous_upload_count;
+        bool vtx_unchanged = was_uploaded && upload_state.VtxOffset == global_vtx_offset && upload_state.VtxHash == vtx_hash;
+        bool idx_unchanged = was_uploaded && upload_state.IdxOffset == global_idx_offset && upload_state.IdxHash == idx_hash;
+
+        if (vtx_size != 0 && !vtx_unchanged)
+            wgpuQueueWriteBuffer(bd->defaultQueue, fr->VertexBuffer, global_vtx_offset * sizeof(ImDrawVert), draw_list->VtxBuffer.Data, vtx_size);
+        if (!idx_unchanged)
+        {
+            size_t idx_size_aligned = idx_size & ~(size_t)3;
+            if (idx_size_aligned != 0)
+                wgpuQueueWriteBuffer(bd->defaultQueue, fr->IndexBuffer, global_idx_offset * sizeof(ImDrawIdx), draw_list->IdxBuffer.Data, idx_size_aligned);
+            if (idx_size_aligned != idx_size)
+            {
+                // Odd trailing 16-bit index: write it along with a padding index, as write sizes must also be a multiple of 4 bytes
+                ImDrawIdx idx_tail[2] = { draw_list->IdxBuffer.back(), 0 };
+                wgpuQueueWriteBuffer(bd->defaultQueue, fr->IndexBuffer, global_idx_offset * sizeof(ImDrawIdx) + idx_size_aligned, idx_tail, sizeof(idx_tail));
+            }
+        }
+
+        upload_state.VtxOffset = global_vtx_offset;
+        upload_state.IdxOffset = global_idx_offset;
+        upload_state.VtxHash = vtx_hash;
+        upload_state.IdxHash = idx_hash;
+        global_vtx_offset += draw_list->VtxBuffer.Size;
+        global_idx_offset += ImGui_ImplWGPU_PaddedIdxCount(draw_list->IdxBuffer.Size);
     }
-    int64_t vb_write_size = MEMALIGN((char*)vtx_dst - (char*)fr->VertexBufferHost, 4);
-    int64_t ib_write_size = MEMALIGN((char*)idx_dst - (char*)fr->IndexBufferHost, 4);
-    wgpuQueueWriteBuffer(bd->defaultQueue, fr->VertexBuffer, 0, fr->VertexBufferHost, vb_write_size);
-    wgpuQueueWriteBuffer(bd->defaultQueue, fr->IndexBuffer,  0, fr->IndexBufferHost,  ib_write_size);
 
     // Setup desired render state
     ImGui_ImplWGPU_SetupRenderState(draw_data, pass_encoder, fr);
@@ -464,8 +551,8 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
 
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
-    int global_vtx_offset = 0;
-    int global_idx_offset = 0;
+    global_vtx_offset = 0;
+    global_idx_offset = 0;
     ImVec2 clip_scale = draw_data->FramebufferScale;
     ImVec2 clip_off = draw_data->DisplayPos;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
@@ -517,7 +604,7 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
                 wgpuRenderPassEncoderDrawIndexed(pass_encoder, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
             }
         }
-        global_idx_offset += draw_list->IdxBuffer.Size;
+        global_idx_offset += ImGui_ImplWGPU_PaddedIdxCount(draw_list->IdxBuffer.Size);
         global_vtx_offset += draw_list->VtxBuffer.Size;
     }
     platform_io.Renderer_RenderState = nullptr;
@@ -549,6 +636,7 @@ static void ImGui_ImplWGPU_CreateFontsTexture()
         tex_desc.mipLevelCount = 1;
         tex_desc.usage = WGPUTextureUsage_CopyDst | WGPUTextureUsage_TextureBinding;
         bd->renderResources.FontTexture = wgpuDeviceCreateTexture(bd->wgpuDevice, &tex_desc);
+        ImGui_ImplWGPU_ReportMemory(bd->renderResources.FontTexture, (size_t)width * height * 4);
 
         WGPUTextureViewDescriptor tex_view_desc = {};
         tex_view_desc.format = WGPUTextureFormat_RGBA8Unorm;
@@ -595,6 +683,31 @@ static void ImGui_ImplWGPU_CreateFontsTexture()
     io.Fonts->SetTexID((ImTextureID)bd->renderResources.FontTextureView);
 }
 
+void ImGui_ImplWGPU_UpdateFontsTexture(int x, int y, int width, int height)
+{
+    ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
+    ImGuiIO& io = ImGui::GetIO();
+    if (!bd || !bd->renderResources.FontTexture || !io.Fonts->TexPixelsRGBA32 || width <= 0 || height <= 0)
+        return; // The whole atlas is uploaded when the texture is (re)created, so there's nothing to do until then
+    IM_ASSERT(x >= 0 && y >= 0 && x + width <= io.Fonts->TexWidth && y + height <= io.Fonts->TexHeight);
+
+    // Only the rows spanned by the rectangle are passed, starting at its first pixel
+    const int size_pp = 4;
+    const unsigned char* pixels = (const unsigned char*)(io.Fonts->TexPixelsRGBA32 + y * io.Fonts->TexWidth + x);
+    WGPUImageCopyTexture dst_view = {};
+    dst_view.texture = bd->renderResources.FontTexture;
+    dst_view.mipLevel = 0;
+    dst_view.origin = { (uint32_t)x, (uint32_t)y, 0 };
+    dst_view.aspect = WGPUTextureAspect_All;
+    WGPUTextureDataLayout layout = {};
+    layout.offset = 0;
+    layout.bytesPerRow = io.Fonts->TexWidth * size_pp;
+    layout.rowsPerImage = height;
+    WGPUExtent3D size = { (uint32_t)width, (uint32_t)height, 1 };
+    size_t data_size = (size_t)((height - 1) * io.Fonts->TexWidth + width) * size_pp;
+    wgpuQueueWriteTexture(bd->defaultQueue, &dst_view, pixels, data_size, &layout, &size);
+}
+
 static void ImGui_ImplWGPU_CreateUniformBuffer()
 {
     ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
@@ -610,6 +723,7 @@ static void ImGui_ImplWGPU_CreateUniformBuffer()
         false
     };
     bd->renderResources.Uniforms = wgpuDeviceCreateBuffer(bd->wgpuDevice, &ub_desc);
+    ImGui_ImplWGPU_ReportMemory(bd->renderResources.Uniforms, (size_t)ub_desc.size);
 }
 
 bool ImGui_ImplWGPU_CreateDeviceObjects()
@@ -775,6 +889,24 @@ void ImGui_ImplWGPU_InvalidateDeviceObjects()
         SafeRelease(bd->pFrameResources[i]);
 }
 
+void ImGui_ImplWGPU_ReleaseImageBindGroup(ImTextureID tex_id)
+{
+    ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
+    if (!bd)
+        return;
+    ImGuiStorage& storage = bd->renderResources.ImageBindGroups;
+    ImGuiID tex_id_hash = ImHashData(&tex_id, sizeof(tex_id));
+    for (ImGuiStoragePair& pair : storage.Data)
+    {
+        if (pair.key != tex_id_hash)
+            continue;
+        if (pair.val_p != bd->renderResources.ImageBindGroup) // The font bind group is owned separately
+            wgpuBindGroupRelease((WGPUBindGroup)pair.val_p);
+        storage.Data.erase(&pair);
+        return;
+    }
+}
+
 bool ImGui_ImplWGPU_Init(ImGui_ImplWGPU_InitInfo* init_info)
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -819,8 +951,6 @@ bool ImGui_ImplWGPU_Init(ImGui_ImplWGPU_InitInfo* init_info)
         FrameResources* fr = &bd->pFrameResources[i];
         fr->IndexBuffer = nullptr;
         fr->VertexBuffer = nullptr;
-        fr->IndexBufferHost = nullptr;
-        fr->VertexBufferHost = nullptr;
         fr->IndexBufferSize = 10000;
         fr->VertexBufferSize = 5000;
     }
@@ -39,6 +39,10 @@ struct ImGui_ImplWGPU_InitInfo
     WGPUTextureFormat       DepthStencilFormat = WGPUTextureFormat_Undefined;
     WGPUMultisampleState    PipelineMultisampleState = {};
 
+    // Optional: called as each buffer and texture the backend owns is created (with its size in bytes) and released (with a size of 0), e.g. to account for GPU memory
+    void                    (*MemoryCallback)(const void* resource, size_t size, void* user_data) = nullptr;
+    void*                   MemoryCallbackUserData = nullptr;
+
     ImGui_ImplWGPU_InitInfo()
     {
         PipelineMultisampleState.count = 1;
@@ -57,6 +61,16 @@ IMGUI_IMPL_API void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURen
 IMGUI_IMPL_API bool ImGui_ImplWGPU_CreateDeviceObjects();
 IMGUI_IMPL_API void ImGui_ImplWGPU_InvalidateDeviceObjects();
 
+// Release the bind group cached for a user texture (e.g. when the texture is destroyed or recreated). It is recreated if the texture is used again.
+IMGUI_IMPL_API void ImGui_ImplWGPU_ReleaseImageBindGroup(ImTextureID tex_id);
+
+// Hash the content of a frame's draw data, once per frame: every list's vertices, indices and commands, each seeded with its length, along with the display rect.
+// RenderDrawData reuses the per-list hashes this computes for the same frame to skip unchanged uploads, rather than hashing the lists again.
+IMGUI_IMPL_API ImGuiID ImGui_ImplWGPU_HashDrawData(ImDrawData* draw_data);
+
+// Re-upload a rectangle of the font atlas from io.Fonts->TexPixelsRGBA32, after glyphs have been added to it at runtime.
+IMGUI_IMPL_API void ImGui_ImplWGPU_UpdateFontsTexture(int x, int y, int width, int height);
+
 // [BETA] Selected render state data shared with callbacks.
 // This is temporarily stored in GetPlatformIO().Renderer_RenderState during the ImGui_ImplWGPU_RenderDrawData() call.
 // (Please open an issue if you feel you need access to more data)
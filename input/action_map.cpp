@@ -0,0 +1,210 @@
+#include "action_map.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <imgui/imgui_internal.h>
+
+namespace input {
+
+action_id action_map::add_action(std::string const &name) {
+  /// Register a new named action, returning its id
+  assert(find_action(name) == invalid_action);
+  assert(action_names.size() < invalid_action);
+  action_names.emplace_back(name);
+  states.emplace_back();
+  rebuild_index();
+  return static_cast<action_id>(action_names.size() - 1);
+}
+
+action_id action_map::find_action(std::string_view name) const {
+  /// Look up an action by name, returning invalid_action if there isn't one
+  auto const it{std::ranges::find(action_names, name)};
+  if(it == action_names.end()) return invalid_action;
+  return static_cast<action_id>(std::distance(action_names.begin(), it));
+}
+
+std::string const &action_map::get_action_name(action_id action) const {
+  /// Return the name an action was registered with
+  return action_names[action];
+}
+
+void action_map::bind(binding const &new_binding) {
+  /// Add a binding from an input to an action
+  assert(new_binding.action < states.size());
+  auto const slot{get_slot(new_binding.source, new_binding.code)};
+  if(slot == invalid_slot) return;
+  auto const it{std::ranges::upper_bound(bindings, slot, {}, [](binding const &this_binding){return get_slot(this_binding.source, this_binding.code);})};
+  binding_values.insert(binding_values.begin() + std::distance(bindings.begin(), it), 0.0f);
+  bindings.insert(it, new_binding);
+  rebuild_index();
+}
+
+void action_map::bind_key(action_id action, ImGuiKey key, float scale) {
+  /// Bind a keyboard key to an action
+  bind({.source{input_source::key}, .code{static_cast<std::uint16_t>(key)}, .action{action}, .scale{scale}});
+}
+
+void action_map::bind_mouse_button(action_id action, ImGuiMouseButton button, float scale) {
+  /// Bind a mouse button to an action
+  bind({.source{input_source::mouse_button}, .code{static_cast<std::uint16_t>(button)}, .action{action}, .scale{scale}});
+}
+
+void action_map::bind_gamepad_button(action_id action, unsigned int button, float scale, float deadzone) {
+  /// Bind a gamepad button to an action - analogue buttons such as triggers pass their full range
+  bind({.source{input_source::gamepad_button}, .code{static_cast<std::uint16_t>(button)}, .action{action}, .scale{scale}, .deadzone{deadzone}});
+}
+
+void action_map::bind_gamepad_axis(action_id action, unsigned int axis, float scale, float deadzone, float exponent) {
+  /// Bind a gamepad axis to an action
+  bind({.source{input_source::gamepad_axis}, .code{static_cast<std::uint16_t>(axis)}, .action{action}, .scale{scale}, .deadzone{deadzone}, .exponent{exponent}});
+}
+
+void action_map::begin_frame() {
+  /// Clear last frame's press and release edges - call before any input for the new frame
+  for(auto const &this_event : events) {
+    states[this_event.action].pressed = false;
+    states[this_event.action].released = false;
+  }
+  events.clear();
+}
+
+void action_map::set_input(input_source source, unsigned int code, float raw_value) {
+  /// Update the actions bound to an input with its new value
+  auto const slot{get_slot(source, code)};
+  if(slot == invalid_slot) return;
+  for(unsigned int i{slot_bindings_begin[slot]}; i != slot_bindings_begin[slot + 1]; ++i) {
+    float const new_value{process(bindings[i], raw_value)};
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wfloat-equal"                              // exact comparison is intended, we're looking for any change
+    if(new_value == binding_values[i]) continue;
+    #pragma GCC diagnostic pop
+    binding_values[i] = new_value;
+    update_action(bindings[i].action);
+  }
+}
+
+void action_map::release_inputs(input_source source) {
+  /// Return every input from a source to rest, i.e. when a device is lost or the page loses focus
+  for(unsigned int i{0}; i != bindings.size(); ++i) {
+    if(bindings[i].source == source) set_input(source, bindings[i].code, 0.0f);
+  }
+}
+
+void action_map::capture_imgui_input() {
+  /// Map keyboard and mouse button input queued for imgui this frame
+  /// Call after the platform backend's NewFrame and before ImGui::NewFrame().  Presses imgui captured last frame are
+  /// left to imgui, but releases always pass through so actions can't get stuck down.
+  auto const &context{*ImGui::GetCurrentContext()};
+  auto const &io{context.IO};
+  for(auto const &imgui_event : context.InputEventsQueue) {
+    if(imgui_event.EventId < next_imgui_event_id) continue;                     // left in the queue by input trickling, and already mapped
+    switch(imgui_event.Type) {
+    case ImGuiInputEventType_Key:
+      if(imgui_event.Source == ImGuiInputSource_Gamepad) break;                 // gamepads are mapped at source
+      if(imgui_event.Key.Down && io.WantCaptureKeyboard) break;
+      set_input(input_source::key, static_cast<unsigned int>(imgui_event.Key.Key), imgui_event.Key.Down ? 1.0f : 0.0f);
+      break;
+    case ImGuiInputEventType_MouseButton:
+      if(imgui_event.MouseButton.Down && io.WantCaptureMouse) break;
+      set_input(input_source::mouse_button, static_cast<unsigned int>(imgui_event.MouseButton.Button), imgui_event.MouseButton.Down ? 1.0f : 0.0f);
+      break;
+    case ImGuiInputEventType_Focus:
+      if(imgui_event.AppFocused.Focused) break;
+      release_inputs(input_source::key);                                        // we won't see the releases of anything held while unfocused
+      release_inputs(input_source::mouse_button);
+      break;
+    default:
+      break;
+    }
+  }
+  next_imgui_event_id = context.InputEventsNextEventId;
+}
+
+action_map::action_state const &action_map::get(action_id action) const {
+  /// Return the full state of an action this frame
+  return states[action];
+}
+
+float action_map::value(action_id action) const {
+  /// Return the current value of an action, -1..1
+  return states[action].value;
+}
+
+bool action_map::down(action_id action) const {
+  /// Return whether an action is currently held
+  return states[action].down;
+}
+
+bool action_map::pressed(action_id action) const {
+  /// Return whether an action was pressed this frame
+  return states[action].pressed;
+}
+
+bool action_map::released(action_id action) const {
+  /// Return whether an action was released this frame
+  return states[action].released;
+}
+
+std::span<action_map::action_event const> action_map::get_events() const {
+  /// Return every press and release this frame, in the order they happened
+  return events;
+}
+
+unsigned int action_map::get_slot(input_source source, unsigned int code) {
+  /// Return the dense index of an input, or invalid_slot for inputs we can't bind
+  switch(source) {
+  case input_source::gamepad_button:
+    return code < max_gamepad_inputs ? gamepad_button_slots_begin + code : invalid_slot;
+  case input_source::gamepad_axis:
+    return code < max_gamepad_inputs ? gamepad_axis_slots_begin + code : invalid_slot;
+  case input_source::mouse_button:
+    return code < ImGuiMouseButton_COUNT ? mouse_button_slots_begin + code : invalid_slot;
+  case input_source::key:
+    if(code < ImGuiKey_NamedKey_BEGIN || code >= ImGuiKey_NamedKey_END) return invalid_slot;
+    return key_slots_begin + code - ImGuiKey_NamedKey_BEGIN;
+  }
+  return invalid_slot;
+}
+
+float action_map::process(binding const &this_binding, float raw_value) {
+  /// Apply a binding's deadzone, response curve and scale to a raw input value
+  float magnitude{std::abs(raw_value)};
+  if(magnitude <= this_binding.deadzone) return 0.0f;
+  magnitude = std::min((magnitude - this_binding.deadzone) / (1.0f - this_binding.deadzone), 1.0f);
+  magnitude = std::pow(magnitude, this_binding.exponent);
+  return std::copysign(magnitude, raw_value) * this_binding.scale;
+}
+
+void action_map::rebuild_index() {
+  /// Rebuild the lookups from input slots and actions to their bindings, after bindings or actions change
+  assert(bindings.size() < std::numeric_limits<std::uint16_t>::max());
+  slot_bindings_begin.assign(slot_count + 1, 0);
+  for(auto const &this_binding : bindings) ++slot_bindings_begin[get_slot(this_binding.source, this_binding.code) + 1];
+  for(unsigned int slot{0}; slot != slot_count; ++slot) slot_bindings_begin[slot + 1] = static_cast<std::uint16_t>(slot_bindings_begin[slot + 1] + slot_bindings_begin[slot]);
+
+  action_bindings_begin.assign(states.size() + 1, 0);
+  for(auto const &this_binding : bindings) ++action_bindings_begin[this_binding.action + 1u];
+  for(unsigned int action{0}; action != states.size(); ++action) action_bindings_begin[action + 1] = static_cast<std::uint16_t>(action_bindings_begin[action + 1] + action_bindings_begin[action]);
+  action_bindings.resize(bindings.size());
+  auto next{action_bindings_begin};
+  for(unsigned int i{0}; i != bindings.size(); ++i) action_bindings[next[bindings[i].action]++] = static_cast<std::uint16_t>(i);
+}
+
+void action_map::update_action(action_id action) {
+  /// Recombine an action's value from its bindings, generating an event if it crossed the press threshold
+  float total{0.0f};
+  for(unsigned int i{action_bindings_begin[action]}; i != action_bindings_begin[action + 1u]; ++i) total += binding_values[action_bindings[i]];
+  auto &state{states[action]};
+  state.value = std::clamp(total, -1.0f, 1.0f);
+  bool const now_down{std::abs(state.value) >= press_threshold};
+  if(now_down == state.down) return;
+  state.down = now_down;
+  if(now_down) {
+    state.pressed = true;
+  } else {
+    state.released = true;
+  }
+  events.emplace_back(action_event{action, now_down});
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <imgui/imgui.h>
+
+namespace input {
+
+using action_id = std::uint16_t;
+
+class action_map {
+  /// Maps gamepad, keyboard and mouse input onto named actions, so game logic can query a compact per-frame
+  /// action state rather than handling devices directly.  Work is only done for inputs that change.
+public:
+  enum class input_source : std::uint8_t {
+    gamepad_button,
+    gamepad_axis,
+    key,
+    mouse_button,
+  };
+
+  struct binding {
+    input_source source{input_source::key};
+    std::uint16_t code{0};                                                      // gamepad button or axis index, ImGuiKey, or ImGuiMouseButton
+    action_id action{0};
+    float scale{1.0f};                                                          // applied after processing, negative to invert
+    float deadzone{0.0f};                                                       // magnitudes below this are ignored, and the rest rescaled to 0..1
+    float exponent{1.0f};                                                       // response curve, the magnitude is raised to this power
+  };
+
+  struct action_state {
+    float value{0.0f};                                                          // combined value of all bindings, -1..1
+    bool down{false};                                                           // the value's magnitude is past press_threshold
+    bool pressed{false};                                                        // became down this frame
+    bool released{false};                                                       // stopped being down this frame
+  };
+
+  struct action_event {
+    action_id action{0};
+    bool down{false};                                                           // true for a press, false for a release
+  };
+
+  static constexpr float press_threshold{0.5f};
+  static constexpr action_id invalid_action{std::numeric_limits<action_id>::max()};
+
+private:
+  static constexpr unsigned int max_gamepad_inputs{64};
+  static constexpr unsigned int gamepad_button_slots_begin{0};
+  static constexpr unsigned int gamepad_axis_slots_begin{gamepad_button_slots_begin + max_gamepad_inputs};
+  static constexpr unsigned int mouse_button_slots_begin{gamepad_axis_slots_begin + max_gamepad_inputs};
+  static constexpr unsigned int key_slots_begin{mouse_button_slots_begin + ImGuiMouseButton_COUNT};
+  static constexpr unsigned int slot_count{key_slots_begin + ImGuiKey_NamedKey_COUNT};
+  static constexpr unsigned int invalid_slot{slot_count};
+
+  std::vector<std::string> action_names;
+  std::vector<action_state> states;                                             // indexed by action id
+  std::vector<action_event> events;                                             // edges this frame, in order
+
+  std::vector<binding> bindings;                                                // sorted by input slot
+  std::vector<float> binding_values;                                            // current processed value of each binding
+  std::vector<std::uint16_t> slot_bindings_begin;                               // index of the first binding for each input slot, plus one past the end
+  std::vector<std::uint16_t> action_bindings;                                   // binding indices grouped by action
+  std::vector<std::uint16_t> action_bindings_begin;                             // index into action_bindings of each action's first binding, plus one past the end
+
+  ImU32 next_imgui_event_id{0};                                                 // imgui input events before this were already mapped
+
+public:
+  action_id add_action(std::string const &name);
+  action_id find_action(std::string_view name) const;
+  std::string const &get_action_name(action_id action) const;
+
+  void bind(binding const &new_binding);
+  void bind_key(action_id action, ImGuiKey key, float scale = 1.0f);
+  void bind_mouse_button(action_id action, ImGuiMouseButton button, float scale = 1.0f);
+  void bind_gamepad_button(action_id action, unsigned int button, float scale = 1.0f, float deadzone = 0.0f);
+  void bind_gamepad_axis(action_id action, unsigned int axis, float scale = 1.0f, float deadzone = 0.0f, float exponent = 1.0f);
+
+  void begin_frame();
+  void set_input(input_source source, unsigned int code, float raw_value);
+  void release_inputs(input_source source);
+  void capture_imgui_input();
+
+  action_state const &get(action_id action) const;
+  float value(action_id action) const;
+  bool down(action_id action) const;
+  bool pressed(action_id action) const;
+  bool released(action_id action) const;
+  std::span<action_event const> get_events() const;
+
+private:
+  static unsigned int get_slot(input_source source, unsigned int code);
+  static float process(binding const &this_binding, float raw_value);
+
+  void rebuild_index();
+  void update_action(action_id action);
+};
+
+}
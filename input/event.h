@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace input {
+
+enum class event_type : std::uint8_t {
+  end_frame,                                                                    // code: frame number, x: measured frame time in seconds
+  display_size,                                                                 // x, y: imgui display size
+  mouse_pos,                                                                    // device: imgui mouse source, x, y: position
+  mouse_wheel,                                                                  // device: imgui mouse source, x, y: wheel movement
+  mouse_button,                                                                 // device: imgui mouse source, index: button, down
+  key,                                                                          // code: imgui key, down, x: analogue value
+  text,                                                                         // code: character
+  focus,                                                                        // down: focused
+  gamepad_connected,                                                            // device: gamepad index, code: button count, index: axis count
+  gamepad_disconnected,                                                         // device: gamepad index
+  gamepad_button,                                                               // device: gamepad index, index: button, down, x: analogue value
+  gamepad_axis,                                                                 // device: gamepad index, index: axis, x: value
+};
+
+struct event {
+  /// A single recorded input event, in the compact form written to input logs
+  event_type type{event_type::end_frame};
+  std::uint8_t device{0};
+  std::uint8_t index{0};
+  bool down{false};
+  std::uint32_t code{0};
+  float x{0.0f};
+  float y{0.0f};
+};
+static_assert(sizeof(event) == 16);
+static_assert(std::is_trivially_copyable_v<event>);
+
+struct log_header {
+  /// Header at the start of an input log, followed by event_count events in native (little endian on wasm) byte order
+  static constexpr std::array<char, 4> expected_magic{'W', 'I', 'N', 'P'};
+  static constexpr std::uint32_t current_version{1};
+
+  std::array<char, 4> magic{expected_magic};
+  std::uint32_t version{current_version};
+  std::uint32_t event_count{0};
+  std::uint32_t frame_count{0};
+};
+static_assert(std::is_trivially_copyable_v<log_header>);
+
+}
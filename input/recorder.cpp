@@ -0,0 +1,184 @@
+#include "recorder.h"
+#include <cstring>
+#include <fstream>
+#ifdef __EMSCRIPTEN__
+  #include <emscripten.h>
+#endif // __EMSCRIPTEN__
+#include <imgui/imgui_internal.h>
+#include "logstorm/logstorm.h"
+
+namespace input {
+
+recorder::recorder(logstorm::manager &this_logger)
+  : logger{this_logger} {
+  /// Start recording from the next imgui input event onwards
+  if(ImGui::GetCurrentContext()) next_imgui_event_id = ImGui::GetCurrentContext()->InputEventsNextEventId;
+  logger << "Input: Recording started";
+}
+
+void recorder::record_gamepad_connected(int gamepad_index, int num_buttons, int num_axes) {
+  /// Record a gamepad being connected, along with its layout
+  events.emplace_back(event{
+    .type{event_type::gamepad_connected},
+    .device{static_cast<std::uint8_t>(gamepad_index)},
+    .index{static_cast<std::uint8_t>(num_axes)},
+    .code{static_cast<std::uint32_t>(num_buttons)},
+  });
+}
+
+void recorder::record_gamepad_disconnected(int gamepad_index) {
+  /// Record a gamepad being disconnected
+  events.emplace_back(event{
+    .type{event_type::gamepad_disconnected},
+    .device{static_cast<std::uint8_t>(gamepad_index)},
+  });
+}
+
+void recorder::record_gamepad_button(int gamepad_index, unsigned int button, float value, bool down) {
+  /// Record a change in a gamepad button's state
+  events.emplace_back(event{
+    .type{event_type::gamepad_button},
+    .device{static_cast<std::uint8_t>(gamepad_index)},
+    .index{static_cast<std::uint8_t>(button)},
+    .down{down},
+    .x{value},
+  });
+}
+
+void recorder::record_gamepad_axis(int gamepad_index, unsigned int axis, float value) {
+  /// Record a change in a gamepad axis
+  events.emplace_back(event{
+    .type{event_type::gamepad_axis},
+    .device{static_cast<std::uint8_t>(gamepad_index)},
+    .index{static_cast<std::uint8_t>(axis)},
+    .x{value},
+  });
+}
+
+void recorder::capture_imgui_input() {
+  /// Record mouse, keyboard, text, focus and display size input queued for imgui this frame
+  /// Call after the platform backend's NewFrame and before ImGui::NewFrame()
+  auto const &context{*ImGui::GetCurrentContext()};
+  auto const &io{context.IO};
+  if(vec2f{io.DisplaySize} != display_size) {
+    display_size = io.DisplaySize;
+    events.emplace_back(event{
+      .type{event_type::display_size},
+      .x{display_size.x},
+      .y{display_size.y},
+    });
+  }
+
+  for(auto const &imgui_event : context.InputEventsQueue) {
+    if(imgui_event.EventId < next_imgui_event_id) continue;                     // left in the queue by input trickling, and already recorded
+    if(imgui_event.Source == ImGuiInputSource_Gamepad) continue;                // gamepad input is recorded at source, and regenerated by replaying it
+    switch(imgui_event.Type) {
+    case ImGuiInputEventType_MousePos:
+      events.emplace_back(event{
+        .type{event_type::mouse_pos},
+        .device{static_cast<std::uint8_t>(imgui_event.MousePos.MouseSource)},
+        .x{imgui_event.MousePos.PosX},
+        .y{imgui_event.MousePos.PosY},
+      });
+      break;
+    case ImGuiInputEventType_MouseWheel:
+      events.emplace_back(event{
+        .type{event_type::mouse_wheel},
+        .device{static_cast<std::uint8_t>(imgui_event.MouseWheel.MouseSource)},
+        .x{imgui_event.MouseWheel.WheelX},
+        .y{imgui_event.MouseWheel.WheelY},
+      });
+      break;
+    case ImGuiInputEventType_MouseButton:
+      events.emplace_back(event{
+        .type{event_type::mouse_button},
+        .device{static_cast<std::uint8_t>(imgui_event.MouseButton.MouseSource)},
+        .index{static_cast<std::uint8_t>(imgui_event.MouseButton.Button)},
+        .down{imgui_event.MouseButton.Down},
+      });
+      break;
+    case ImGuiInputEventType_Key:
+      events.emplace_back(event{
+        .type{event_type::key},
+        .down{imgui_event.Key.Down},
+        .code{static_cast<std::uint32_t>(imgui_event.Key.Key)},
+        .x{imgui_event.Key.AnalogValue},
+      });
+      break;
+    case ImGuiInputEventType_Text:
+      events.emplace_back(event{
+        .type{event_type::text},
+        .code{imgui_event.Text.Char},
+      });
+      break;
+    case ImGuiInputEventType_Focus:
+      events.emplace_back(event{
+        .type{event_type::focus},
+        .down{imgui_event.AppFocused.Focused},
+      });
+      break;
+    default:                                                                    // nothing else affects a single viewport application
+      break;
+    }
+  }
+  next_imgui_event_id = context.InputEventsNextEventId;
+}
+
+void recorder::end_frame() {
+  /// Stamp the end of a frame - everything recorded since the previous stamp is replayed together
+  auto const now{std::chrono::steady_clock::now()};
+  events.emplace_back(event{
+    .type{event_type::end_frame},
+    .code{frame},
+    .x{std::chrono::duration<float>(now - frame_start).count()},
+  });
+  frame_start = now;
+  ++frame;
+}
+
+unsigned int recorder::get_frame_count() const {
+  /// Return the number of complete frames recorded so far
+  return frame;
+}
+
+std::vector<std::byte> recorder::serialise() const {
+  /// Write the recording in the input log format
+  log_header const header{
+    .event_count{static_cast<std::uint32_t>(events.size())},
+    .frame_count{frame},
+  };
+  std::vector<std::byte> data(sizeof(header) + events.size() * sizeof(event));
+  std::memcpy(data.data(), &header, sizeof(header));
+  std::memcpy(data.data() + sizeof(header), events.data(), events.size() * sizeof(event));
+  return data;
+}
+
+bool recorder::save(std::string const &filename) const {
+  /// Save the recording to a file
+  auto const data{serialise()};
+  std::ofstream file{filename, std::ios::binary};
+  file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+  if(!file) {
+    logger << "ERROR: Input: Could not write recording to " << filename;
+    return false;
+  }
+  logger << "Input: Saved " << frame << " frames, " << events.size() << " events to " << filename;
+  return true;
+}
+
+#ifdef __EMSCRIPTEN__
+void recorder::download(std::string const &filename) const {
+  /// Offer the recording to the user as a file download from the browser
+  auto const data{serialise()};
+  EM_ASM({
+    const link = document.createElement('a');
+    link.href = URL.createObjectURL(new Blob([HEAPU8.slice($0, $0 + $1)], {type: 'application/octet-stream'}));
+    link.download = UTF8ToString($2);
+    link.click();
+    URL.revokeObjectURL(link.href);
+  }, data.data(), data.size(), filename.c_str());
+  logger << "Input: Offered " << frame << " frames, " << events.size() << " events for download as " << filename;
+}
+#endif // __EMSCRIPTEN__
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <imgui/imgui.h>
+#include "logstorm/logstorm_forward.h"
+#include "vectorstorm/vector/vector2.h"
+#include "event.h"
+
+namespace input {
+
+class recorder {
+  /// Captures input with frame stamps, so a session can be replayed deterministically by input::replayer
+  logstorm::manager &logger;
+
+  std::vector<event> events;
+  unsigned int frame{0};                                                        // frame currently being recorded
+  ImU32 next_imgui_event_id{0};                                                 // imgui input events before this were already recorded
+  vec2f display_size;                                                           // last display size recorded
+  std::chrono::steady_clock::time_point frame_start{std::chrono::steady_clock::now()};
+
+public:
+  recorder(logstorm::manager &logger);
+
+  void record_gamepad_connected(int gamepad_index, int num_buttons, int num_axes);
+  void record_gamepad_disconnected(int gamepad_index);
+  void record_gamepad_button(int gamepad_index, unsigned int button, float value, bool down);
+  void record_gamepad_axis(int gamepad_index, unsigned int axis, float value);
+
+  void capture_imgui_input();
+  void end_frame();
+
+  unsigned int get_frame_count() const;
+
+  std::vector<std::byte> serialise() const;
+  bool save(std::string const &filename) const;
+  #ifdef __EMSCRIPTEN__
+    void download(std::string const &filename) const;
+  #endif // __EMSCRIPTEN__
+};
+
+}
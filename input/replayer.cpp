@@ -0,0 +1,126 @@
+#include "replayer.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <imgui/imgui_internal.h>
+#include "logstorm/logstorm.h"
+
+namespace input {
+
+replayer::replayer(logstorm::manager &this_logger)
+  : logger{this_logger} {
+  /// Default constructor
+}
+
+bool replayer::load(std::string const &filename) {
+  /// Load an input log made by input::recorder, returning false if it can't be replayed
+  std::ifstream file{filename, std::ios::binary};
+  if(!file) {
+    logger << "ERROR: Input: Could not open recording " << filename;
+    return false;
+  }
+  std::vector<char> const data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  log_header header;
+  if(data.size() < sizeof(header)) {
+    logger << "ERROR: Input: Recording " << filename << " is too short to be an input log";
+    return false;
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  if(header.magic != log_header::expected_magic) {
+    logger << "ERROR: Input: " << filename << " is not an input log";
+    return false;
+  }
+  if(header.version != log_header::current_version) {
+    logger << "ERROR: Input: Recording " << filename << " is version " << header.version << ", expected " << log_header::current_version;
+    return false;
+  }
+  if(data.size() != sizeof(header) + header.event_count * sizeof(event)) {
+    logger << "ERROR: Input: Recording " << filename << " is truncated, expected " << header.event_count << " events";
+    return false;
+  }
+  events.resize(header.event_count);
+  std::memcpy(events.data(), data.data() + sizeof(header), events.size() * sizeof(event));
+  position = 0;
+  frame_count = header.frame_count;
+  logger << "Input: Loaded " << frame_count << " frames, " << events.size() << " events from " << filename;
+  return true;
+}
+
+std::span<event const> replayer::next_frame() {
+  /// Return the events recorded in the next frame, not including its end of frame stamp
+  auto const begin{position};
+  while(position != events.size() && events[position].type != event_type::end_frame) ++position;
+  std::span<event const> const frame_events{events.data() + begin, position - begin};
+  if(position != events.size()) ++position;                                     // skip the end of frame stamp
+  return frame_events;
+}
+
+void replayer::inject_imgui_input(std::span<event const> frame_events) {
+  /// Replace this frame's live mouse, keyboard, text, focus and display size input for imgui with the recorded input
+  /// Call after the platform backend's NewFrame and before ImGui::NewFrame()
+  auto &context{*ImGui::GetCurrentContext()};
+  auto &io{context.IO};
+  auto &queue{context.InputEventsQueue};
+  for(int i{queue.Size - 1}; i >= 0; --i) {                                     // drop live input, but keep replayed events left over by input trickling, and replayed gamepad input
+    if(queue[i].EventId >= next_live_event_id && queue[i].Source != ImGuiInputSource_Gamepad) queue.erase(queue.Data + i);
+  }
+
+  io.DeltaTime = fixed_timestep;
+  for(auto const &this_event : frame_events) {
+    switch(this_event.type) {
+    case event_type::display_size:
+      if(!warned_display_size && (std::abs(io.DisplaySize.x - this_event.x) > 0.5f || std::abs(io.DisplaySize.y - this_event.y) > 0.5f)) { // live size from the platform backend, in whole pixels
+        logger << "WARNING: Input: Replaying a display size of " << this_event.x << "x" << this_event.y << " in a " << io.DisplaySize.x << "x" << io.DisplaySize.y << " window - only the GUI follows the recorded size, so the replay may not match the recording";
+        warned_display_size = true;
+      }
+      io.DisplaySize = ImVec2{this_event.x, this_event.y};
+      break;
+    case event_type::mouse_pos:
+      io.AddMouseSourceEvent(static_cast<ImGuiMouseSource>(this_event.device));
+      io.AddMousePosEvent(this_event.x, this_event.y);
+      break;
+    case event_type::mouse_wheel:
+      io.AddMouseSourceEvent(static_cast<ImGuiMouseSource>(this_event.device));
+      io.AddMouseWheelEvent(this_event.x, this_event.y);
+      break;
+    case event_type::mouse_button:
+      io.AddMouseSourceEvent(static_cast<ImGuiMouseSource>(this_event.device));
+      io.AddMouseButtonEvent(this_event.index, this_event.down);
+      break;
+    case event_type::key:
+      io.AddKeyAnalogEvent(static_cast<ImGuiKey>(this_event.code), this_event.down, this_event.x);
+      break;
+    case event_type::text:
+      io.AddInputCharacter(this_event.code);
+      break;
+    case event_type::focus:
+      io.AddFocusEvent(this_event.down);
+      break;
+    case event_type::end_frame:
+    case event_type::gamepad_connected:
+    case event_type::gamepad_disconnected:
+    case event_type::gamepad_button:
+    case event_type::gamepad_axis:
+      break;                                                                    // not imgui input, handled by the caller
+    }
+  }
+  next_live_event_id = context.InputEventsNextEventId;
+}
+
+bool replayer::finished() const {
+  /// Return true once every recorded frame has been replayed
+  return position == events.size();
+}
+
+unsigned int replayer::get_frame_count() const {
+  /// Return the number of frames in the loaded recording
+  return frame_count;
+}
+
+void replayer::set_fixed_timestep(float new_fixed_timestep) {
+  /// Set the imgui delta time used for each replayed frame, in seconds
+  fixed_timestep = new_fixed_timestep;
+}
+
+}
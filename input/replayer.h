@@ -0,0 +1,38 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <imgui/imgui.h>
+#include "logstorm/logstorm_forward.h"
+#include "event.h"
+
+namespace input {
+
+class replayer {
+  /// Feeds an input log made by input::recorder back in, one recorded frame per frame at a fixed timestep
+  /// Recorded display sizes only reach imgui - the renderer keeps following the live window, so replays are only deterministic at the recorded window size
+  logstorm::manager &logger;
+
+  std::vector<event> events;
+  size_t position{0};                                                           // start of the next frame's events
+  unsigned int frame_count{0};
+  float fixed_timestep{1.0f / 60.0f};
+  ImU32 next_live_event_id{0};                                                  // imgui input events from here on arrived live and are discarded
+  bool warned_display_size{false};                                              // so a window size differing from the recording is only reported once
+
+public:
+  replayer(logstorm::manager &logger);
+
+  bool load(std::string const &filename);
+
+  std::span<event const> next_frame();
+  void inject_imgui_input(std::span<event const> frame_events);
+
+  bool finished() const;
+  unsigned int get_frame_count() const;
+
+  void set_fixed_timestep(float new_fixed_timestep);
+};
+
+}
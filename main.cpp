@@ -1,11 +1,23 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
-#include <functional>
 #include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
 #include <boost/throw_exception.hpp>
+#include <emscripten.h>
 #include <emscripten/html5.h>
 #include <imgui/imgui_impl_wgpu.h>
 #include "logstorm/logstorm.h"
+#include "benchmark/runner.h"
 #include "gui/gui_renderer.h"
+#include "input/action_map.h"
+#include "input/recorder.h"
+#include "input/replayer.h"
 #include "render/webgpu_renderer.h"
 
 using namespace std::string_literals;
@@ -19,17 +31,127 @@ void boost::throw_exception(std::exception const & e) {
 }
 #endif // BOOST_NO_EXCEPTIONS
 
+namespace {
+
+std::optional<std::string> get_url_parameter(char const *name) {
+  /// Return the value of a query parameter in the page URL, if present
+  auto *value{reinterpret_cast<char*>(EM_ASM_PTR({
+    const value = new URLSearchParams(window.location.search).get(UTF8ToString($0));
+    return value === null ? 0 : stringToNewUTF8(value);
+  }, name))};
+  if(!value) return std::nullopt;
+  std::string result{value};
+  free(value);
+  return result;
+}
+
+ImGui_ImplWGPU_InitInfo make_imgui_wgpu_info(render::webgpu_renderer &renderer, render::webgpu_renderer::webgpu_data const& webgpu) {
+  /// Describe the device and formats the GUI renders with, and have the renderer account for the GPU memory the GUI backend allocates
+  ImGui_ImplWGPU_InitInfo imgui_wgpu_info;
+  imgui_wgpu_info.Device = webgpu.device.Get();
+  imgui_wgpu_info.RenderTargetFormat = static_cast<WGPUTextureFormat>(webgpu.surface_preferred_format);
+  imgui_wgpu_info.DepthStencilFormat = static_cast<WGPUTextureFormat>(webgpu.depth_texture_format);
+  imgui_wgpu_info.MemoryCallback = [](void const *resource, size_t size, void *user_data){
+    static_cast<render::webgpu_renderer*>(user_data)->report_gui_memory(resource, size);
+  };
+  imgui_wgpu_info.MemoryCallbackUserData = &renderer;
+  return imgui_wgpu_info;
+}
+
+}
+
 
 struct gamepad {
-  using analogue_button_callback = std::function<void(float)>;                  // callback for analogue button values
-  using digital_button_callback = std::function<void(bool)>;                    // callback for digital button values
-  using axis_callback = std::function<void(float)>;                             // callback for analogue axis values
+  static constexpr unsigned int max_inputs{64};                                 // size of the button and axis arrays in EmscriptenGamepadEvent
+  static constexpr float deadzone{0.1f};
+
+  struct action {
+    using function_type = void(*)(action const&, float);                        // called with the new value when an input changes
+
+    function_type function{nullptr};                                            // nullptr for unbound inputs
+    ImGuiKey key{ImGuiKey_None};                                                // imgui key for a button, or the positive direction of an axis
+    ImGuiKey key_negative{ImGuiKey_None};                                       // imgui key for the negative direction of an axis
+  };
+  static_assert(std::is_trivially_copyable_v<action>);
+
+  std::array<action, max_inputs> analogue_buttons{};
+  std::array<action, max_inputs> digital_buttons{};
+  std::array<action, max_inputs> axes{};
+
+  EmscriptenGamepadEvent previous_state{};                                      // last state dispatched, so only changes are acted on
+  EmscriptenGamepadEvent replay_state{};                                        // state built up from recorded input when replaying
+
+  input::action_map *mapped_actions{nullptr};                                   // game actions, also fed every changed input
 
-  std::map<unsigned int, analogue_button_callback> analogue_buttons;
-  std::map<unsigned int, digital_button_callback> digital_buttons;
-  std::map<unsigned int, axis_callback> axes;
+  void dispatch(EmscriptenGamepadEvent const &state);
+  void record_changes(input::recorder &recorder, int gamepad_index, EmscriptenGamepadEvent const &state) const;
+
+  static void imgui_key(action const &this_action, float value);
+  static void imgui_analogue_key(action const &this_action, float value);
+  static void imgui_stick(action const &this_action, float value);
 };
 
+void gamepad::dispatch(EmscriptenGamepadEvent const &state) {
+  /// Call the imgui actions and update the game actions bound to any buttons and axes that changed since the last state
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wfloat-equal"                                // exact comparison is intended, we're looking for any change
+  if(state.timestamp == previous_state.timestamp) return;                       // the browser only updates the timestamp when something changes
+  auto const num_buttons{std::min(static_cast<unsigned int>(state.numButtons), max_inputs)};
+  for(unsigned int i{0}; i != num_buttons; ++i) {
+    if(state.analogButton[i] != previous_state.analogButton[i]) {
+      if(analogue_buttons[i].function) analogue_buttons[i].function(analogue_buttons[i], static_cast<float>(state.analogButton[i]));
+      if(mapped_actions) mapped_actions->set_input(input::action_map::input_source::gamepad_button, i, static_cast<float>(state.analogButton[i]));
+    }
+    if(state.digitalButton[i] != previous_state.digitalButton[i] && digital_buttons[i].function) {
+      digital_buttons[i].function(digital_buttons[i], state.digitalButton[i] ? 1.0f : 0.0f);
+    }
+  }
+  auto const num_axes{std::min(static_cast<unsigned int>(state.numAxes), max_inputs)};
+  for(unsigned int i{0}; i != num_axes; ++i) {
+    if(state.axis[i] != previous_state.axis[i]) {
+      if(axes[i].function) axes[i].function(axes[i], static_cast<float>(state.axis[i]));
+      if(mapped_actions) mapped_actions->set_input(input::action_map::input_source::gamepad_axis, i, static_cast<float>(state.axis[i]));
+    }
+  }
+  #pragma GCC diagnostic pop
+  previous_state = state;
+}
+
+void gamepad::record_changes(input::recorder &recorder, int gamepad_index, EmscriptenGamepadEvent const &state) const {
+  /// Record any buttons and axes that changed since the last state, as dispatch() will see them
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wfloat-equal"                                // exact comparison is intended, we're looking for any change
+  if(state.timestamp == previous_state.timestamp) return;
+  auto const num_buttons{std::min(static_cast<unsigned int>(state.numButtons), max_inputs)};
+  for(unsigned int i{0}; i != num_buttons; ++i) {
+    if(state.analogButton[i] != previous_state.analogButton[i] || state.digitalButton[i] != previous_state.digitalButton[i]) {
+      recorder.record_gamepad_button(gamepad_index, i, static_cast<float>(state.analogButton[i]), state.digitalButton[i]);
+    }
+  }
+  auto const num_axes{std::min(static_cast<unsigned int>(state.numAxes), max_inputs)};
+  for(unsigned int i{0}; i != num_axes; ++i) {
+    if(state.axis[i] != previous_state.axis[i]) recorder.record_gamepad_axis(gamepad_index, i, static_cast<float>(state.axis[i]));
+  }
+  #pragma GCC diagnostic pop
+}
+
+void gamepad::imgui_key(action const &this_action, float value) {
+  /// Pass a digital button to imgui
+  ImGui::GetIO().AddKeyEvent(this_action.key, value > 0.0f);
+}
+
+void gamepad::imgui_analogue_key(action const &this_action, float value) {
+  /// Pass an analogue button to imgui
+  ImGui::GetIO().AddKeyAnalogEvent(this_action.key, value > deadzone, value);
+}
+
+void gamepad::imgui_stick(action const &this_action, float value) {
+  /// Pass a stick axis to imgui as a pair of analogue keys, releasing the opposite direction
+  auto &io{ImGui::GetIO()};
+  io.AddKeyAnalogEvent(this_action.key_negative, value < -deadzone, std::max(-value, 0.0f));
+  io.AddKeyAnalogEvent(this_action.key,          value >  deadzone, std::max( value, 0.0f));
+}
+
 
 class game_manager {
   logstorm::manager logger{logstorm::manager::build_with_sink<logstorm::sink::emscripten_out>()}; // logging system
@@ -38,12 +160,30 @@ class game_manager {
 
   std::map<int, gamepad> gamepads;
 
+  std::optional<input::recorder> recorder;                                      // records input when the page is loaded with ?record=<frames>
+  unsigned int record_frames{0};                                                // number of frames to record before offering the recording for download
+  std::optional<input::replayer> replayer;                                      // replays recorded input when the page is loaded with ?replay=<filename>
+  std::optional<benchmark::runner> benchmark_runner;                            // runs a benchmark scene when the page is loaded with ?benchmark=<scene>
+
+  input::action_map actions;                                                    // game actions mapped from all input devices
+  input::action_id action_rotate_x{};
+  input::action_id action_rotate_y{};
+  input::action_id action_pause_rotation{};
+
   vec2f cube_rotation;
+  bool rotation_paused{false};
 
+  void init_actions();
   void register_gamepad_events();
   void set_gamepad_callbacks(gamepad& this_gamepad);
   void handle_gamepad_events();
 
+  void init_input_recording();
+  void init_benchmark();
+  void replay_gamepad_events(std::span<input::event const> frame_events);
+  void update_input_recording();
+
+  void update_game();
   void loop_main();
 
 public:
@@ -52,15 +192,32 @@ public:
 
 game_manager::game_manager() {
   /// Run the game
+  init_actions();
   register_gamepad_events();
+  init_input_recording();
+  init_benchmark();
+
+  gui.add_window([&]{
+    if(ImGui::Begin("Renderer")) renderer.draw_settings_gui();
+    ImGui::End();
+  });
+  renderer.set_gui_image_callback([&](wgpu::Texture const &texture, wgpu::TextureView const &view, vec2f const &size){
+    gui.get_image_cache().image(texture, view, {size.x, size.y});
+  });
+  renderer.add_texture_destroyed_callback([&](wgpu::Texture const &texture){
+    gui.get_image_cache().invalidate(texture);                                  // so a destroyed texture's memory isn't held by a cached bind group
+  });
+  gui.get_image_cache().set_drawn_callback([&]{
+    renderer.invalidate_gui_layer();                                            // so textures shown in the GUI stay live when the GUI layer is cached
+  });
 
+  renderer.set_device_recovered_callback([&](render::webgpu_renderer::webgpu_data const& webgpu){
+    auto imgui_wgpu_info{make_imgui_wgpu_info(renderer, webgpu)};
+    gui.reinit_device(imgui_wgpu_info);
+  });
   renderer.init(
     [&](render::webgpu_renderer::webgpu_data const& webgpu){
-      ImGui_ImplWGPU_InitInfo imgui_wgpu_info;
-      imgui_wgpu_info.Device = webgpu.device.Get();
-      imgui_wgpu_info.RenderTargetFormat = static_cast<WGPUTextureFormat>(webgpu.surface_preferred_format);
-      imgui_wgpu_info.DepthStencilFormat = static_cast<WGPUTextureFormat>(webgpu.depth_texture_format);
-
+      auto imgui_wgpu_info{make_imgui_wgpu_info(renderer, webgpu)};
       gui.init(imgui_wgpu_info);
     },
     [&]{
@@ -70,6 +227,27 @@ game_manager::game_manager() {
   std::unreachable();
 }
 
+void game_manager::init_actions() {
+  /// Set up game actions and their default bindings
+  constexpr float stick_deadzone{0.1f};
+  constexpr float stick_exponent{1.5f};                                         // finer control near the centre of the stick
+
+  action_rotate_x = actions.add_action("rotate_x");
+  actions.bind_gamepad_axis(action_rotate_x, 0, 1.0f, stick_deadzone, stick_exponent);
+  actions.bind_key(action_rotate_x, ImGuiKey_A, -1.0f);
+  actions.bind_key(action_rotate_x, ImGuiKey_D);
+
+  action_rotate_y = actions.add_action("rotate_y");
+  actions.bind_gamepad_axis(action_rotate_y, 1, 1.0f, stick_deadzone, stick_exponent);
+  actions.bind_key(action_rotate_y, ImGuiKey_W, -1.0f);
+  actions.bind_key(action_rotate_y, ImGuiKey_S);
+
+  action_pause_rotation = actions.add_action("pause_rotation");
+  actions.bind_gamepad_button(action_pause_rotation, 9);                        // start
+  actions.bind_key(action_pause_rotation, ImGuiKey_P);
+  actions.bind_mouse_button(action_pause_rotation, ImGuiMouseButton_Middle);
+}
+
 void game_manager::register_gamepad_events() {
   /// Register gamepad event callbacks
   emscripten_set_gamepadconnected_callback(
@@ -87,6 +265,8 @@ void game_manager::register_gamepad_events() {
       logger << "DEBUG: gamepad connected, id " << event->id;
       logger << "DEBUG: gamepad connected, mapping " << event->mapping;
 
+      if(game.replayer) return true;                                            // gamepads are replayed from the recording instead
+      if(game.recorder) game.recorder->record_gamepad_connected(event->index, event->numButtons, event->numAxes);
       auto [new_gamepad_it, success]{game.gamepads.emplace(event->index, gamepad{})};
       assert(success);
       game.set_gamepad_callbacks(new_gamepad_it->second);
@@ -104,7 +284,11 @@ void game_manager::register_gamepad_events() {
 
       logger << "DEBUG: gamepad " << event->index << " disconnected";
 
+      if(game.replayer) return true;                                            // gamepads are replayed from the recording instead
+      if(game.recorder) game.recorder->record_gamepad_disconnected(event->index);
       game.gamepads.erase(event->index);
+      game.actions.release_inputs(input::action_map::input_source::gamepad_button);
+      game.actions.release_inputs(input::action_map::input_source::gamepad_axis);
       if(game.gamepads.empty()) ImGui::GetIO().BackendFlags &= ~ImGuiBackendFlags_HasGamepad;
 
       return true;                                                              // the event was consumed
@@ -113,93 +297,198 @@ void game_manager::register_gamepad_events() {
 }
 
 void game_manager::set_gamepad_callbacks(gamepad& this_gamepad) {
-  /// Set up gamepad button and axis callbacks on the given gamepad
-  constexpr float deadzone{0.1f};
-
-  // set up button and axis callbacks for imgui
-  this_gamepad.digital_buttons.emplace(  0u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadFaceDown,  down                   );});
-  this_gamepad.digital_buttons.emplace(  1u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadFaceRight, down                   );});
-  this_gamepad.digital_buttons.emplace(  2u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadFaceLeft,  down                   );});
-  this_gamepad.digital_buttons.emplace(  3u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadFaceUp,    down                   );});
-  this_gamepad.digital_buttons.emplace(  4u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadL1,        down                   );});
-  this_gamepad.digital_buttons.emplace(  5u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadR1,        down                   );});
-  this_gamepad.analogue_buttons.emplace( 6u, [&](float value){ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadL2,        value > deadzone, value);});
-  this_gamepad.analogue_buttons.emplace( 7u, [&](float value){ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadR2,        value > deadzone, value);});
-  this_gamepad.digital_buttons.emplace(  8u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadBack,      down                   );});
-  this_gamepad.digital_buttons.emplace(  9u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadStart,     down                   );});
-  this_gamepad.digital_buttons.emplace( 10u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadL3,        down                   );});
-  this_gamepad.digital_buttons.emplace( 11u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadR3,        down                   );});
-  this_gamepad.digital_buttons.emplace( 12u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadDpadUp,    down                   );});
-  this_gamepad.digital_buttons.emplace( 13u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadDpadDown,  down                   );});
-  this_gamepad.digital_buttons.emplace( 14u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadDpadLeft,  down                   );});
-  this_gamepad.digital_buttons.emplace( 15u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      ImGuiKey_GamepadDpadRight, down                   );});
-  //this_gamepad.digital_buttons.emplace( 16u, [&](bool down  ){ImGui::GetIO().AddKeyEvent(      /* guide button */,        down                   );});
-
-  // spin the cube with the first two axes
-  this_gamepad.axes.emplace(0u, [&](float value){
-    cube_rotation.x = value * 0.05f;
-    if(std::signbit(value)) {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadLStickLeft, value < -deadzone, -value);
-    } else {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadLStickRight, value > deadzone, value);
-    }
-  });
-  this_gamepad.axes.emplace(1u, [&](float value){
-    cube_rotation.y = value * 0.05f;
-    if(std::signbit(value)) {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadLStickUp, value < -deadzone, -value);
-    } else {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadLStickDown, value > deadzone, value);
-    }
-  });
-
-  this_gamepad.axes.emplace(2u, [&](float value){
-    if(std::signbit(value)) {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadRStickLeft, value < -deadzone, -value);
-    } else {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadRStickRight, value > deadzone, value);
-    }
-  });
-  this_gamepad.axes.emplace(3u, [&](float value){
-    if(std::signbit(value)) {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadRStickUp, value < -deadzone, -value);
-    } else {
-      ImGui::GetIO().AddKeyAnalogEvent(ImGuiKey_GamepadRStickDown, value > deadzone, value);
-    }
-  });
+  /// Set up gamepad button and axis actions on the given gamepad
+  this_gamepad.mapped_actions = &actions;
+
+  // set up button and axis actions for imgui
+  this_gamepad.digital_buttons[  0] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadFaceDown}};
+  this_gamepad.digital_buttons[  1] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadFaceRight}};
+  this_gamepad.digital_buttons[  2] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadFaceLeft}};
+  this_gamepad.digital_buttons[  3] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadFaceUp}};
+  this_gamepad.digital_buttons[  4] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadL1}};
+  this_gamepad.digital_buttons[  5] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadR1}};
+  this_gamepad.analogue_buttons[ 6] = {.function{gamepad::imgui_analogue_key}, .key{ImGuiKey_GamepadL2}};
+  this_gamepad.analogue_buttons[ 7] = {.function{gamepad::imgui_analogue_key}, .key{ImGuiKey_GamepadR2}};
+  this_gamepad.digital_buttons[  8] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadBack}};
+  this_gamepad.digital_buttons[  9] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadStart}};
+  this_gamepad.digital_buttons[ 10] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadL3}};
+  this_gamepad.digital_buttons[ 11] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadR3}};
+  this_gamepad.digital_buttons[ 12] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadDpadUp}};
+  this_gamepad.digital_buttons[ 13] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadDpadDown}};
+  this_gamepad.digital_buttons[ 14] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadDpadLeft}};
+  this_gamepad.digital_buttons[ 15] = {.function{gamepad::imgui_key},          .key{ImGuiKey_GamepadDpadRight}};
+  //this_gamepad.digital_buttons[ 16] = {.function{gamepad::imgui_key},          .key{/* guide button */}};
+
+  this_gamepad.axes[0] = {.function{gamepad::imgui_stick}, .key{ImGuiKey_GamepadLStickRight}, .key_negative{ImGuiKey_GamepadLStickLeft}};
+  this_gamepad.axes[1] = {.function{gamepad::imgui_stick}, .key{ImGuiKey_GamepadLStickDown},  .key_negative{ImGuiKey_GamepadLStickUp}};
+  this_gamepad.axes[2] = {.function{gamepad::imgui_stick}, .key{ImGuiKey_GamepadRStickRight}, .key_negative{ImGuiKey_GamepadRStickLeft}};
+  this_gamepad.axes[3] = {.function{gamepad::imgui_stick}, .key{ImGuiKey_GamepadRStickDown},  .key_negative{ImGuiKey_GamepadRStickUp}};
 }
 
 void game_manager::handle_gamepad_events() {
-  /// Handle gamepad events, calling any callbacks that have been set
+  /// Handle gamepad events, dispatching any changed inputs to their actions
   if(gamepads.empty()) return;
   if(emscripten_sample_gamepad_data() != EMSCRIPTEN_RESULT_SUCCESS) return;
 
-  for(auto [gamepad_index, this_gamepad] : gamepads) {
+  for(auto &[gamepad_index, this_gamepad] : gamepads) {
     EmscriptenGamepadEvent gamepad_state;
     if(emscripten_get_gamepad_status(gamepad_index, &gamepad_state) != EMSCRIPTEN_RESULT_SUCCESS) continue;
-    for(auto const &[button_index, button] : this_gamepad.analogue_buttons) {
-      assert(button_index < static_cast<unsigned int>(gamepad_state.numButtons));
-      assert(button);
-      button(static_cast<float>(gamepad_state.analogButton[button_index]));
+    if(recorder) this_gamepad.record_changes(*recorder, gamepad_index, gamepad_state);
+    this_gamepad.dispatch(gamepad_state);
+  }
+}
+
+void game_manager::init_input_recording() {
+  /// Start recording or replaying input if requested in the page URL, i.e. ?record=3600 or ?replay=session.input
+  if(auto const replay_filename{get_url_parameter("replay")}; replay_filename) {
+    replayer.emplace(logger);
+    if(!replayer->load(*replay_filename)) replayer.reset();
+    return;
+  }
+  if(auto const record_frames_string{get_url_parameter("record")}; record_frames_string) {
+    constexpr unsigned int default_record_frames{3600};
+    record_frames = default_record_frames;
+    if(!record_frames_string->empty()) {
+      auto const [end, error]{std::from_chars(record_frames_string->data(), record_frames_string->data() + record_frames_string->size(), record_frames)};
+      if(error != std::errc{} || record_frames == 0) {
+        logger << "ERROR: Input: Could not parse record frame count \"" << *record_frames_string << "\" as a number above zero, using " << default_record_frames;
+        record_frames = default_record_frames;
+      }
     }
-    for(auto const &[button_index, button] : this_gamepad.digital_buttons) {
-      assert(button_index < static_cast<unsigned int>(gamepad_state.numButtons));
-      assert(button);
-      button(gamepad_state.digitalButton[button_index]);
+    logger << "Input: Recording " << record_frames << " frames";
+    recorder.emplace(logger);
+  }
+}
+
+void game_manager::init_benchmark() {
+  /// Start a benchmark scene if requested in the page URL, i.e. ?benchmark=instances&benchmark_frames=1200
+  auto const scene_name{get_url_parameter("benchmark")};
+  if(!scene_name) return;
+  auto const *scene{benchmark::runner::find_scene(*scene_name)};
+  if(!scene) {
+    logger << "ERROR: Benchmark: Unknown scene \"" << *scene_name << "\"";
+    return;
+  }
+  auto this_scene{*scene};
+  if(auto const frames_string{get_url_parameter("benchmark_frames")}; frames_string) {
+    auto const [end, error]{std::from_chars(frames_string->data(), frames_string->data() + frames_string->size(), this_scene.frame_count)};
+    if(error != std::errc{} || this_scene.frame_count == 0) {
+      logger << "ERROR: Benchmark: Could not parse frame count \"" << *frames_string << "\", using " << scene->frame_count;
+      this_scene.frame_count = scene->frame_count;
     }
-    for(auto const &[axis_index, axis] : this_gamepad.axes) {
-      assert(axis_index < static_cast<unsigned int>(gamepad_state.numAxes));
-      assert(axis);
-      axis(static_cast<float>(gamepad_state.axis[axis_index]));
+  }
+
+  benchmark_runner.emplace(logger);
+  benchmark_runner->start(this_scene, renderer.get_frame_number());
+  renderer.set_scene_instances(this_scene.instance_count);
+  renderer.set_gpu_time_callback([&](uint64_t frame_number, double milliseconds){
+    if(benchmark_runner) benchmark_runner->add_gpu_time(frame_number, milliseconds);
+  });
+  gui.add_window([&]{
+    if(benchmark_runner) benchmark_runner->draw_gui();
+  });
+}
+
+void game_manager::replay_gamepad_events(std::span<input::event const> frame_events) {
+  /// Apply a frame of recorded gamepad events, as if they had been read from the browser
+  for(auto const &this_event : frame_events) {
+    switch(this_event.type) {
+    case input::event_type::gamepad_connected: {
+      auto [new_gamepad_it, success]{gamepads.emplace(this_event.device, gamepad{})};
+      if(!success) break;
+      set_gamepad_callbacks(new_gamepad_it->second);
+      new_gamepad_it->second.replay_state.numButtons = static_cast<int>(this_event.code);
+      new_gamepad_it->second.replay_state.numAxes = this_event.index;
+      ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_HasGamepad;
+      break;
+    }
+    case input::event_type::gamepad_disconnected:
+      gamepads.erase(this_event.device);
+      actions.release_inputs(input::action_map::input_source::gamepad_button);
+      actions.release_inputs(input::action_map::input_source::gamepad_axis);
+      if(gamepads.empty()) ImGui::GetIO().BackendFlags &= ~ImGuiBackendFlags_HasGamepad;
+      break;
+    case input::event_type::gamepad_button:
+      if(auto it{gamepads.find(this_event.device)}; it != gamepads.end() && this_event.index < gamepad::max_inputs) {
+        it->second.replay_state.analogButton[this_event.index] = static_cast<double>(this_event.x);
+        it->second.replay_state.digitalButton[this_event.index] = this_event.down;
+      }
+      break;
+    case input::event_type::gamepad_axis:
+      if(auto it{gamepads.find(this_event.device)}; it != gamepads.end() && this_event.index < gamepad::max_inputs) {
+        it->second.replay_state.axis[this_event.index] = static_cast<double>(this_event.x);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  for(auto &[gamepad_index, this_gamepad] : gamepads) {
+    this_gamepad.replay_state.timestamp += 1.0;                                 // dispatch() ignores states with an unchanged timestamp
+    this_gamepad.dispatch(this_gamepad.replay_state);
+  }
+}
+
+void game_manager::update_input_recording() {
+  /// Finish the frame for input recording or replay, ending either once all the frames are done
+  if(recorder) {
+    recorder->end_frame();
+    if(recorder->get_frame_count() >= record_frames) {
+      recorder->download("session.input");
+      recorder.reset();
     }
   }
+  if(replayer && replayer->finished()) {
+    logger << "Input: Replay of " << replayer->get_frame_count() << " frames finished";
+    replayer.reset();
+  }
+}
+
+void game_manager::update_game() {
+  /// Apply this frame's actions to the game state
+  if(actions.pressed(action_pause_rotation)) rotation_paused = !rotation_paused;
+  constexpr float rotation_speed{0.05f};
+  if(benchmark_runner) {
+    cube_rotation = benchmark_runner->get_camera_rotation();                    // input is ignored, so every run follows the same path
+  } else if(rotation_paused) {
+    cube_rotation = {};
+  } else {
+    cube_rotation = vec2f{actions.value(action_rotate_x), actions.value(action_rotate_y)} * rotation_speed;
+  }
 }
 
 void game_manager::loop_main() {
   /// Main pseudo-loop
-  handle_gamepad_events();
+  if(benchmark_runner) benchmark_runner->begin_frame();
+  actions.begin_frame();
+  std::span<input::event const> replay_events;
+  if(replayer) {
+    replay_events = replayer->next_frame();
+    replay_gamepad_events(replay_events);
+  } else {
+    handle_gamepad_events();
+  }
+
+  gui.begin_frame();
+  if(replayer) {
+    replayer->inject_imgui_input(replay_events);
+  } else if(recorder) {
+    recorder->capture_imgui_input();
+  }
+  actions.capture_imgui_input();
+  update_game();
   gui.draw();
   renderer.draw(cube_rotation);
+
+  update_input_recording();
+
+  if(benchmark_runner) {
+    benchmark_runner->end_frame();
+    if(benchmark_runner->finished()) {
+      benchmark_runner.reset();
+      renderer.set_gpu_time_callback({});
+    }
+  }
 }
 
 auto main()->int {
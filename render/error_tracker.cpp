@@ -0,0 +1,119 @@
+#include "error_tracker.h"
+#include <imgui/imgui.h>
+#include <magic_enum/magic_enum.hpp>
+#include "logstorm/logstorm.h"
+
+namespace render {
+
+#ifndef NDEBUG
+error_tracker::scope::scope(error_tracker::site &this_site)
+  : scope_site{&this_site} {
+  /// Push a scope for each error filter we capture
+  auto const &device{scope_site->tracker.device};
+  device.PushErrorScope(wgpu::ErrorFilter::OutOfMemory);
+  device.PushErrorScope(wgpu::ErrorFilter::Validation);
+}
+
+error_tracker::scope::~scope() {
+  /// Pop our scopes in reverse order, recording any errors asynchronously as their results arrive
+  auto const callback{[](WGPUErrorType type, char const *message, void *data){
+    auto &this_site{*static_cast<error_tracker::site*>(data)};
+    this_site.tracker.record(this_site, static_cast<wgpu::ErrorType>(type), message);
+  }};
+  auto const &device{scope_site->tracker.device};
+  device.PopErrorScope(callback, scope_site);                                   // validation
+  device.PopErrorScope(callback, scope_site);                                   // out of memory
+}
+#endif // NDEBUG
+
+error_tracker::error_tracker(logstorm::manager &this_logger)
+  : logger{this_logger} {
+  /// Default constructor
+}
+
+void error_tracker::init([[maybe_unused]] wgpu::Device const &this_device) {
+  /// Set the device scopes are pushed on, keeping counts from any previous device
+  #ifndef NDEBUG
+    device = this_device;
+  #endif // NDEBUG
+}
+
+#ifndef NDEBUG
+error_tracker::scope error_tracker::capture(char const *label, std::source_location const &location) {
+  /// Open a scope capturing errors from the calls made while it exists, attributed to the label and caller
+  return scope{get_site(label, std::string{location.file_name()} + ":" + std::to_string(location.line()))};
+}
+
+error_tracker::site &error_tracker::get_site(char const *label, std::string const &location) {
+  /// Find or create the record for a call site
+  std::string site_key{std::string{label} + "@" + location};
+  if(auto it{sites.find(site_key)}; it != sites.end()) return it->second;
+  auto [it, success]{sites.emplace(std::move(site_key), site{
+    .tracker{*this},
+    .label{label},
+    .location{location},
+  })};
+  return it->second;
+}
+
+bool error_tracker::count(site &this_site, wgpu::ErrorType type, char const *message) {
+  /// Count an error against a site, returning whether it's the first of its type there
+  ++total;
+  this_site.last_message = message ? message : "";
+  return ++this_site.counts[type] == 1;
+}
+
+void error_tracker::record(site &this_site, wgpu::ErrorType type, char const *message) {
+  /// Count an error caught by a scope, logging only the first of each type from each site to avoid flooding the log every frame
+  if(type == wgpu::ErrorType::NoError) return;
+  if(!count(this_site, type, message)) return;
+  logger << "ERROR: WebGPU " << magic_enum::enum_name(type) << " error in " << this_site.label << " (" << this_site.location << "): " << this_site.last_message;
+}
+#endif // NDEBUG
+
+void error_tracker::record_uncaptured(wgpu::ErrorType type, char const *message) {
+  /// Log an error that occurred outside any scope, also counting it in debug builds
+  logger << "ERROR: WebGPU uncaptured error " << magic_enum::enum_name(type) << ": " << (message ? message : "");
+  #ifndef NDEBUG
+    count(get_site("Uncaptured", "outside any scope"), type, message);
+  #endif // NDEBUG
+}
+
+#ifndef NDEBUG
+unsigned int error_tracker::get_total() const {
+  /// Return the number of errors seen so far
+  return total;
+}
+
+void error_tracker::draw_gui() {
+  /// Show the error counts by site and type, within the current ImGui window
+  if(total == 0) {
+    ImGui::TextDisabled("No errors");
+    return;
+  }
+  if(!ImGui::BeginTable("WebGPU errors", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) return;
+  ImGui::TableSetupColumn("Site");
+  ImGui::TableSetupColumn("Type");
+  ImGui::TableSetupColumn("Count");
+  ImGui::TableSetupColumn("Last message");
+  ImGui::TableHeadersRow();
+  for(auto const &[site_key, this_site] : sites) {
+    for(auto const &[type, error_count] : this_site.counts) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(this_site.label.c_str());
+      ImGui::SetItemTooltip("%s", this_site.location.c_str());
+      ImGui::TableNextColumn();
+      auto const type_name{magic_enum::enum_name(type)};
+      ImGui::TextUnformatted(type_name.data(), type_name.data() + type_name.size());
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", error_count);
+      ImGui::TableNextColumn();
+      ImGui::TextWrapped("%s", this_site.last_message.c_str());
+    }
+  }
+  ImGui::EndTable();
+}
+#endif // NDEBUG
+
+}
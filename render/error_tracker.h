@@ -0,0 +1,69 @@
+#pragma once
+
+#include <map>
+#include <source_location>
+#include <string>
+#include <webgpu/webgpu_cpp.h>
+#include "logstorm/logstorm_forward.h"
+
+namespace render {
+
+class error_tracker {
+  /// Captures WebGPU errors in scopes around groups of calls, and counts them by type and call site
+  /// Scopes only exist in debug builds - in release builds they compile to nothing, and only uncaptured errors are logged
+  logstorm::manager &logger;
+
+  #ifndef NDEBUG
+    struct site {
+      error_tracker &tracker;
+      std::string label;
+      std::string location;                                                     // source file and line where the scope was opened
+      std::map<wgpu::ErrorType, unsigned int> counts;
+      std::string last_message;
+    };
+    std::map<std::string, site> sites;                                          // by label and location - nodes are stable, so sites can be passed as callback userdata
+    unsigned int total{0};                                                      // errors captured in all scopes, plus uncaptured errors
+
+    wgpu::Device device;
+
+    site &get_site(char const *label, std::string const &location);
+    bool count(site &this_site, wgpu::ErrorType type, char const *message);
+    void record(site &this_site, wgpu::ErrorType type, char const *message);
+  #endif // NDEBUG
+
+public:
+  class scope {
+    /// Pushes error scopes when created and pops them when destroyed, recording anything they caught against their call site
+    #ifndef NDEBUG
+      error_tracker::site *scope_site{nullptr};
+
+    public:
+      scope(error_tracker::site &scope_site);
+      ~scope();
+    #else
+    public:
+      scope() {}                                                                // user-provided, so unused scopes aren't warned about
+    #endif // NDEBUG
+    scope(scope const&) = delete;
+    scope &operator=(scope const&) = delete;
+  };
+
+  error_tracker(logstorm::manager &logger);
+
+  void init(wgpu::Device const &device);
+
+  #ifndef NDEBUG
+    [[nodiscard]] scope capture(char const *label, std::source_location const &location = std::source_location::current());
+  #else
+    [[nodiscard]] scope capture(char const */*label*/) {return {};}
+  #endif // NDEBUG
+
+  void record_uncaptured(wgpu::ErrorType type, char const *message);
+
+  #ifndef NDEBUG
+    unsigned int get_total() const;
+    void draw_gui();
+  #endif // NDEBUG
+};
+
+}
@@ -0,0 +1,274 @@
+#include "memory_tracker.h"
+#include <algorithm>
+#include <imgui/imgui.h>
+#include <magic_enum/magic_enum.hpp>
+#include "logstorm/logstorm.h"
+
+namespace render {
+
+namespace {
+
+struct texel_block {
+  uint32_t bytes{4};
+  uint32_t size{1};                                                             // width and height in texels of each block, for compressed formats
+};
+
+texel_block get_texel_block(wgpu::TextureFormat format) {
+  /// Return the storage size of a texel, or of a block of texels for block compressed formats
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wswitch-enum"                                // only the sizes that differ from the default are listed
+  switch(format) {
+  case wgpu::TextureFormat::R8Unorm:
+  case wgpu::TextureFormat::R8Snorm:
+  case wgpu::TextureFormat::R8Uint:
+  case wgpu::TextureFormat::R8Sint:
+  case wgpu::TextureFormat::Stencil8:
+    return {.bytes{1}};
+  case wgpu::TextureFormat::R16Uint:
+  case wgpu::TextureFormat::R16Sint:
+  case wgpu::TextureFormat::R16Float:
+  case wgpu::TextureFormat::RG8Unorm:
+  case wgpu::TextureFormat::RG8Snorm:
+  case wgpu::TextureFormat::RG8Uint:
+  case wgpu::TextureFormat::RG8Sint:
+  case wgpu::TextureFormat::Depth16Unorm:
+    return {.bytes{2}};
+  case wgpu::TextureFormat::RG32Float:
+  case wgpu::TextureFormat::RG32Uint:
+  case wgpu::TextureFormat::RG32Sint:
+  case wgpu::TextureFormat::RGBA16Uint:
+  case wgpu::TextureFormat::RGBA16Sint:
+  case wgpu::TextureFormat::RGBA16Float:
+  case wgpu::TextureFormat::Depth32FloatStencil8:                               // typically padded
+    return {.bytes{8}};
+  case wgpu::TextureFormat::RGBA32Float:
+  case wgpu::TextureFormat::RGBA32Uint:
+  case wgpu::TextureFormat::RGBA32Sint:
+    return {.bytes{16}};
+  case wgpu::TextureFormat::BC1RGBAUnorm:
+  case wgpu::TextureFormat::BC1RGBAUnormSrgb:
+  case wgpu::TextureFormat::BC4RUnorm:
+  case wgpu::TextureFormat::BC4RSnorm:
+    return {.bytes{8}, .size{4}};
+  case wgpu::TextureFormat::BC2RGBAUnorm:
+  case wgpu::TextureFormat::BC2RGBAUnormSrgb:
+  case wgpu::TextureFormat::BC3RGBAUnorm:
+  case wgpu::TextureFormat::BC3RGBAUnormSrgb:
+  case wgpu::TextureFormat::BC5RGUnorm:
+  case wgpu::TextureFormat::BC5RGSnorm:
+  case wgpu::TextureFormat::BC6HRGBUfloat:
+  case wgpu::TextureFormat::BC6HRGBFloat:
+  case wgpu::TextureFormat::BC7RGBAUnorm:
+  case wgpu::TextureFormat::BC7RGBAUnormSrgb:
+    return {.bytes{16}, .size{4}};
+  default:                                                                      // most formats in use are four bytes per texel
+    return {};
+  }
+  #pragma GCC diagnostic pop
+}
+
+uint64_t get_texture_bytes(wgpu::TextureDescriptor const &descriptor) {
+  /// Estimate the memory used by a texture, including all its mip levels and samples
+  auto const block{get_texel_block(descriptor.format)};
+  bool const is_3d{descriptor.dimension == wgpu::TextureDimension::e3D};
+  uint64_t bytes{0};
+  for(uint32_t level{0}; level != std::max(descriptor.mipLevelCount, 1u); ++level) {
+    uint64_t const width {std::max(descriptor.size.width  >> level, 1u)};
+    uint64_t const height{std::max(descriptor.size.height >> level, 1u)};
+    uint64_t const depth {is_3d ? std::max(descriptor.size.depthOrArrayLayers >> level, 1u) : descriptor.size.depthOrArrayLayers};
+    bytes += ((width + block.size - 1) / block.size) * ((height + block.size - 1) / block.size) * depth * block.bytes;
+  }
+  return bytes * std::max(descriptor.sampleCount, 1u);
+}
+
+}
+
+memory_tracker::memory_tracker(logstorm::manager &this_logger)
+  : logger{this_logger} {
+  /// Default constructor
+}
+
+void memory_tracker::clear() {
+  /// Forget all allocations, when the device they were made on has gone - peaks are kept
+  buffers.clear();
+  textures.clear();
+  externals.clear();
+  pending_textures.clear();
+  for(auto &this_usage : categories) this_usage.current = 0;
+  total.current = 0;
+  over_budget = false;
+}
+
+wgpu::Buffer memory_tracker::create_buffer(wgpu::Device const &device, wgpu::BufferDescriptor const &descriptor, category allocation_category) {
+  /// Create a buffer, accounting for its size
+  make_room(descriptor.size);
+  auto buffer{device.CreateBuffer(&descriptor)};
+  buffers.emplace(buffer.Get(), allocation{allocation_category, descriptor.size});
+  add(allocation_category, descriptor.size);
+  return buffer;
+}
+
+wgpu::Texture memory_tracker::create_texture(wgpu::Device const &device, wgpu::TextureDescriptor const &descriptor, category allocation_category) {
+  /// Create a texture, accounting for its estimated size
+  auto const bytes{get_texture_bytes(descriptor)};
+  make_room(bytes);
+  auto texture{device.CreateTexture(&descriptor)};
+  textures.emplace(texture.Get(), allocation{allocation_category, bytes});
+  add(allocation_category, bytes);
+  return texture;
+}
+
+void memory_tracker::destroy(wgpu::Buffer &buffer) {
+  /// Destroy a buffer now, rather than whenever the handle is collected, and stop accounting for it
+  if(!buffer) return;
+  if(auto it{buffers.find(buffer.Get())}; it != buffers.end()) {
+    remove(it->second);
+    buffers.erase(it);
+  }
+  buffer.Destroy();
+  buffer = nullptr;
+}
+
+void memory_tracker::destroy(wgpu::Texture &texture) {
+  /// Destroy a texture now, rather than whenever the handle is collected, and stop accounting for it
+  if(!texture) return;
+  forget(texture);
+  for(auto const &function : texture_destroyed_functions) function(texture);
+  texture.Destroy();
+  texture = nullptr;
+}
+
+void memory_tracker::destroy_later(wgpu::Texture &texture) {
+  /// Stop accounting for a texture now, but only destroy it in destroy_pending(), as commands being recorded may still use it
+  if(!texture) return;
+  forget(texture);
+  pending_textures.emplace_back(std::move(texture));
+  texture = nullptr;
+}
+
+void memory_tracker::destroy_pending() {
+  /// Destroy the textures passed to destroy_later() - call once the commands recorded before then have been submitted
+  for(auto &texture : pending_textures) {
+    for(auto const &function : texture_destroyed_functions) function(texture);
+    texture.Destroy();
+  }
+  pending_textures.clear();
+}
+
+void memory_tracker::add_external(void const *resource, category allocation_category, uint64_t bytes) {
+  /// Account for a resource we didn't create, such as one made by a library - it can't be evicted for, but counts towards the budget
+  remove_external(resource);
+  make_room(bytes);
+  externals.emplace(resource, allocation{allocation_category, bytes});
+  add(allocation_category, bytes);
+}
+
+void memory_tracker::remove_external(void const *resource) {
+  /// Stop accounting for a resource reported with add_external, ignoring any we don't know, such as those forgotten when the device was lost
+  if(auto it{externals.find(resource)}; it != externals.end()) {
+    remove(it->second);
+    externals.erase(it);
+  }
+}
+
+void memory_tracker::set_budget(uint64_t new_budget) {
+  /// Set the number of bytes we aim to stay within, or 0 for no limit, evicting straight away if we're already over it
+  budget = new_budget;
+  over_budget = false;
+  make_room(0);
+}
+
+void memory_tracker::add_eviction_function(eviction_function &&function) {
+  /// Add a function able to free memory when the budget would be exceeded, such as by dropping cached resources
+  eviction_functions.emplace_back(std::move(function));
+}
+
+void memory_tracker::add_texture_destroyed_function(texture_destroyed_function &&function) {
+  /// Add a function to be told about each texture destroyed through here, before it goes
+  texture_destroyed_functions.emplace_back(std::move(function));
+}
+
+uint64_t memory_tracker::get_total() const {
+  /// Return the estimated bytes currently allocated
+  return total.current;
+}
+
+uint64_t memory_tracker::get_peak() const {
+  /// Return the most bytes allocated at any one time
+  return total.peak;
+}
+
+void memory_tracker::add(category allocation_category, uint64_t bytes) {
+  /// Account for a new allocation
+  auto &this_usage{categories[static_cast<size_t>(allocation_category)]};
+  this_usage.current += bytes;
+  this_usage.peak = std::max(this_usage.peak, this_usage.current);
+  total.current += bytes;
+  total.peak = std::max(total.peak, total.current);
+}
+
+void memory_tracker::remove(allocation const &this_allocation) {
+  /// Stop accounting for a freed allocation
+  categories[static_cast<size_t>(this_allocation.allocation_category)].current -= this_allocation.bytes;
+  total.current -= this_allocation.bytes;
+  if(budget == 0 || total.current <= budget) over_budget = false;
+}
+
+void memory_tracker::forget(wgpu::Texture const &texture) {
+  /// Stop accounting for a texture, if it was created through here
+  if(auto it{textures.find(texture.Get())}; it != textures.end()) {
+    remove(it->second);
+    textures.erase(it);
+  }
+}
+
+void memory_tracker::make_room(uint64_t bytes) {
+  /// Ask each eviction function in turn to free memory, until an allocation of this size fits within the budget
+  if(budget == 0) return;
+  for(auto const &function : eviction_functions) {
+    if(total.current + bytes <= budget) return;
+    function(total.current + bytes - budget);
+  }
+  if(total.current + bytes <= budget || over_budget) return;
+  over_budget = true;
+  logger << "WARNING: GPU memory: Allocation of " << bytes << " bytes exceeds the budget of " << budget << " by " << total.current + bytes - budget << " bytes after eviction";
+  for(size_t i{0}; i != category_count; ++i) {
+    logger << "WARNING: GPU memory: " << magic_enum::enum_name(static_cast<category>(i)) << ": " << categories[i].current << " bytes";
+  }
+}
+
+void memory_tracker::draw_gui() {
+  /// Show usage by category against the budget, within the current ImGui window
+  constexpr float mebibyte{1024.0f * 1024.0f};
+  auto const to_mebibytes{[](uint64_t bytes){return static_cast<float>(bytes) / mebibyte;}};
+  if(ImGui::BeginTable("GPU memory", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+    ImGui::TableSetupColumn("Category");
+    ImGui::TableSetupColumn("Current");
+    ImGui::TableSetupColumn("Peak");
+    ImGui::TableHeadersRow();
+    auto const row{[&](std::string_view name, usage const &this_usage){
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(name.data(), name.data() + name.size());
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f MiB", static_cast<double>(to_mebibytes(this_usage.current)));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f MiB", static_cast<double>(to_mebibytes(this_usage.peak)));
+    }};
+    for(size_t i{0}; i != category_count; ++i) {
+      row(magic_enum::enum_name(static_cast<category>(i)), categories[i]);
+    }
+    row("total", total);
+    ImGui::EndTable();
+  }
+
+  auto budget_mebibytes{static_cast<uint32_t>(budget / (1024 * 1024))};
+  if(ImGui::InputScalar("Budget (MiB, 0 for none)", ImGuiDataType_U32, &budget_mebibytes, nullptr, nullptr, "%u", ImGuiInputTextFlags_EnterReturnsTrue)) {
+    set_budget(uint64_t{budget_mebibytes} * 1024 * 1024);
+  }
+  if(budget != 0) {
+    ImGui::ProgressBar(std::min(static_cast<float>(total.current) / static_cast<float>(budget), 1.0f), {-1.0f, 0.0f});
+  }
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <webgpu/webgpu_cpp.h>
+#include "logstorm/logstorm_forward.h"
+
+namespace render {
+
+class memory_tracker {
+  /// Accounts for the GPU memory of buffers and textures created through it, by category, against an optional budget
+  /// WebGPU has no way to query actual usage, so sizes are estimated from descriptors, and resources must be destroyed through here to be accounted as freed
+  logstorm::manager &logger;
+
+public:
+  enum class category : uint32_t {
+    mesh,
+    texture,
+    uniform,
+    staging,
+    gui,
+    render_target,
+  };
+  static constexpr size_t category_count{static_cast<size_t>(category::render_target) + 1};
+
+  using eviction_function = std::function<void(uint64_t bytes_over)>;          // asked to free at least this much if it can
+  using texture_destroyed_function = std::function<void(wgpu::Texture const &texture)>; // told when a texture is destroyed, so anything holding views of it can let go
+
+private:
+  struct allocation {
+    category allocation_category{category::mesh};
+    uint64_t bytes{0};
+  };
+  std::unordered_map<WGPUBuffer, allocation> buffers;
+  std::unordered_map<WGPUTexture, allocation> textures;
+  std::unordered_map<void const*, allocation> externals;                       // resources created elsewhere, such as by the ImGui backend, and reported to us
+
+  struct usage {
+    uint64_t current{0};
+    uint64_t peak{0};
+  };
+  std::array<usage, category_count> categories{};
+  usage total;
+
+  uint64_t budget{0};                                                           // 0 for unlimited
+  std::vector<eviction_function> eviction_functions;                            // called in order when an allocation would exceed the budget
+  std::vector<texture_destroyed_function> texture_destroyed_functions;
+  std::vector<wgpu::Texture> pending_textures;                                  // no longer accounted for, but possibly used by commands not yet submitted
+  bool over_budget{false};                                                      // so we only warn once each time the budget is exceeded
+
+public:
+  memory_tracker(logstorm::manager &logger);
+
+  void clear();
+
+  wgpu::Buffer create_buffer(wgpu::Device const &device, wgpu::BufferDescriptor const &descriptor, category allocation_category);
+  wgpu::Texture create_texture(wgpu::Device const &device, wgpu::TextureDescriptor const &descriptor, category allocation_category);
+  void destroy(wgpu::Buffer &buffer);
+  void destroy(wgpu::Texture &texture);
+  void destroy_later(wgpu::Texture &texture);
+  void destroy_pending();
+  void add_external(void const *resource, category allocation_category, uint64_t bytes);
+  void remove_external(void const *resource);
+
+  void set_budget(uint64_t new_budget);
+  void add_eviction_function(eviction_function &&function);
+  void add_texture_destroyed_function(texture_destroyed_function &&function);
+
+  uint64_t get_total() const;
+  uint64_t get_peak() const;
+
+  void draw_gui();
+
+private:
+  void add(category allocation_category, uint64_t bytes);
+  void remove(allocation const &this_allocation);
+  void forget(wgpu::Texture const &texture);
+  void make_room(uint64_t bytes);
+};
+
+}
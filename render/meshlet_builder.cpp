@@ -0,0 +1,93 @@
+#include "meshlet_builder.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include "vectorstorm/aabb/aabb3.h"
+#include "vectorstorm/epsilon.h"
+
+namespace render {
+
+meshlet_data meshlet_builder::build(std::span<vertex const> vertices, std::span<triangle_index const> triangles) {
+  /// Greedily add triangles in order to the current meshlet, starting a new one whenever the next triangle won't fit
+  /// Meshes whose triangles are ordered for vertex cache locality make compact meshlets this way
+  meshlet_data data;
+  std::unordered_map<uint32_t, uint8_t> local_indices;                          // of the vertices in the current meshlet
+
+  auto const finish_meshlet{[&]{
+    if(data.meshlets.empty() || data.meshlets.back().triangle_count == 0) return;
+    compute_bounds(data.meshlets.back(), data, vertices);
+  }};
+  auto const start_meshlet{[&]{
+    finish_meshlet();
+    data.meshlets.emplace_back(meshlet{
+      .vertex_offset{static_cast<uint32_t>(data.vertices.size())},
+      .triangle_offset{static_cast<uint32_t>(data.triangles.size())},
+    });
+    local_indices.clear();
+  }};
+
+  start_meshlet();
+  for(auto const &triangle : triangles) {
+    auto const new_vertices{static_cast<uint32_t>(std::count_if(triangle.begin(), triangle.end(), [&](uint16_t index){
+      return !local_indices.contains(index);
+    }))};
+    auto const &current{data.meshlets.back()};
+    if(current.vertex_count + new_vertices > max_vertices || current.triangle_count == max_triangles) start_meshlet();
+
+    auto &this_meshlet{data.meshlets.back()};
+    uint32_t packed{0};
+    for(uint32_t corner{0}; corner != 3; ++corner) {
+      auto [it, inserted]{local_indices.try_emplace(triangle[corner], static_cast<uint8_t>(this_meshlet.vertex_count))};
+      if(inserted) {
+        data.vertices.emplace_back(triangle[corner]);
+        ++this_meshlet.vertex_count;
+      }
+      packed |= uint32_t{it->second} << (corner * 8);
+    }
+    data.triangles.emplace_back(packed);
+    ++this_meshlet.triangle_count;
+  }
+  finish_meshlet();
+  if(data.meshlets.back().triangle_count == 0) data.meshlets.pop_back();        // the mesh had no triangles
+  return data;
+}
+
+void meshlet_builder::compute_bounds(meshlet &this_meshlet, meshlet_data const &data, std::span<vertex const> vertices) {
+  /// Find a bounding sphere for frustum culling, and a cone containing the triangles' normals for backface culling the whole meshlet
+  auto const get_position{[&](uint32_t local_index) -> vec3f const& {
+    return vertices[data.vertices[this_meshlet.vertex_offset + local_index]].position;
+  }};
+
+  aabb3f bounds;
+  for(uint32_t i{0}; i != this_meshlet.vertex_count; ++i) bounds.extend(get_position(i));
+  this_meshlet.centre = bounds.centre();
+  this_meshlet.radius = 0.0f;
+  for(uint32_t i{0}; i != this_meshlet.vertex_count; ++i) {
+    this_meshlet.radius = std::max(this_meshlet.radius, (get_position(i) - this_meshlet.centre).length());
+  }
+
+  std::vector<vec3f> normals;                                                   // facing of each triangle, from its winding
+  normals.reserve(this_meshlet.triangle_count);
+  vec3f normal_sum;
+  for(uint32_t t{0}; t != this_meshlet.triangle_count; ++t) {
+    auto const packed{data.triangles[this_meshlet.triangle_offset + t]};
+    auto const &a{get_position(packed & 0xff)};
+    auto const &b{get_position((packed >> 8) & 0xff)};
+    auto const &c{get_position((packed >> 16) & 0xff)};
+    auto const normal{(b - a).cross(c - a)};
+    if(normal.length() < epsilon<float>) continue;                              // degenerate triangles face nowhere
+    normals.emplace_back(normal.normalise_copy());
+    normal_sum += normals.back();
+  }
+
+  this_meshlet.cone_cutoff = 1.0f;                                              // never culled by cone unless we find a usable one
+  if(normals.empty() || normal_sum.length() < epsilon<float>) return;
+  this_meshlet.cone_axis = normal_sum.normalise_copy();
+  float min_dot{1.0f};
+  for(auto const &normal : normals) min_dot = std::min(min_dot, normal.dot(this_meshlet.cone_axis));
+  constexpr float min_usable_dot{0.1f};                                         // cones wider than about 84 degrees either side almost never cull
+  if(min_dot < min_usable_dot) return;
+  this_meshlet.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+}
+
+}
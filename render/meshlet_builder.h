@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "vectorstorm/vector/vector3.h"
+#include "vertex.h"
+#include "triangle_index.h"
+
+namespace render {
+
+struct alignas(16) meshlet {                                                    // matches meshlet in meshlet_cull.wgsl
+  vec3f centre;                                                                 // bounding sphere
+  float radius{0.0f};
+  vec3f cone_axis;                                                              // average facing of the triangles
+  float cone_cutoff{1.0f};                                                      // sine of the cone's half-angle, or 1 if the triangles face too many ways to cull by cone
+  uint32_t vertex_offset{0};                                                    // first entry in meshlet_data::vertices
+  uint32_t triangle_offset{0};                                                  // first entry in meshlet_data::triangles
+  uint32_t vertex_count{0};
+  uint32_t triangle_count{0};
+};
+static_assert(sizeof(meshlet) == 48);
+
+struct meshlet_data {
+  std::vector<meshlet> meshlets;
+  std::vector<uint32_t> vertices;                                               // index into the mesh's vertices of each vertex each meshlet uses
+  std::vector<uint32_t> triangles;                                              // three 8-bit indices into the meshlet's vertices, packed into each word
+};
+
+class meshlet_builder {
+  /// Splits an indexed mesh into small clusters of triangles, each with the bounds needed to cull it on the GPU
+  /// Pure CPU code with no WebGPU dependency, so it can equally run offline to bake meshlets alongside a mesh
+public:
+  static constexpr uint32_t max_vertices{64};
+  static constexpr uint32_t max_triangles{124};
+
+  static meshlet_data build(std::span<vertex const> vertices, std::span<triangle_index const> triangles);
+
+private:
+  static void compute_bounds(meshlet &this_meshlet, meshlet_data const &data, std::span<vertex const> vertices);
+};
+
+}
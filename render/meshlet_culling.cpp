@@ -0,0 +1,283 @@
+#include "meshlet_culling.h"
+#include <array>
+#include <imgui/imgui.h>
+#include "logstorm/logstorm.h"
+#include "embedded/resources.h"
+
+namespace render {
+
+meshlet_culling::meshlet_culling(logstorm::manager &this_logger, memory_tracker &this_memory)
+  : logger{this_logger},
+    memory{this_memory},
+    uniform_buffer{this_memory} {
+  /// Default constructor
+}
+
+void meshlet_culling::init(wgpu::Device const &this_device, wgpu::Queue const &this_queue, wgpu::BindGroupLayout const &scene_bind_group_layout) {
+  /// Create the culling shader, bind group layouts and compute pipeline - geometry is set separately
+  device = this_device;
+  queue = this_queue;
+  bind_group = nullptr;
+  draw_bind_group = nullptr;
+
+  {
+    wgpu::ShaderModuleWGSLDescriptor shader_module_wgsl_decriptor;
+    shader_module_wgsl_decriptor.code = embedded::get("render/shaders/meshlet_cull.wgsl").c_str();
+    wgpu::ShaderModuleDescriptor shader_module_descriptor{
+      .nextInChain{&shader_module_wgsl_decriptor},
+      .label{"Meshlet culling shader module 1"},
+    };
+    shader_module = device.CreateShaderModule(&shader_module_descriptor);
+  }
+  {
+    auto const storage_binding_layout{[](uint32_t binding, wgpu::BufferBindingType type){
+      return wgpu::BindGroupLayoutEntry{
+        .binding{binding},
+        .visibility{wgpu::ShaderStage::Compute},
+        .buffer{                                                                // BufferBindingLayout
+          .type{type},
+        },
+      };
+    }};
+    std::array binding_layouts{
+      wgpu::BindGroupLayoutEntry{
+        .binding{0},
+        .visibility{wgpu::ShaderStage::Compute},
+        .buffer{                                                                // BufferBindingLayout
+          .type{wgpu::BufferBindingType::Uniform},
+          .minBindingSize{sizeof(uniforms)},
+        },
+      },
+      storage_binding_layout(1, wgpu::BufferBindingType::ReadOnlyStorage),      // meshlets
+      storage_binding_layout(2, wgpu::BufferBindingType::ReadOnlyStorage),      // meshlet vertices
+      storage_binding_layout(3, wgpu::BufferBindingType::ReadOnlyStorage),      // meshlet triangles
+      storage_binding_layout(4, wgpu::BufferBindingType::ReadOnlyStorage),      // instance offsets
+      storage_binding_layout(5, wgpu::BufferBindingType::Storage),              // visible vertices
+      storage_binding_layout(6, wgpu::BufferBindingType::Storage),              // draw arguments
+    };
+    wgpu::BindGroupLayoutDescriptor bind_group_layout_descriptor{
+      .label{"Meshlet culling bind group layout 1"},
+      .entryCount{binding_layouts.size()},
+      .entries{binding_layouts.data()},
+    };
+    bind_group_layout = device.CreateBindGroupLayout(&bind_group_layout_descriptor);
+  }
+  {
+    auto const storage_binding_layout{[](uint32_t binding){
+      return wgpu::BindGroupLayoutEntry{
+        .binding{binding},
+        .visibility{wgpu::ShaderStage::Vertex},
+        .buffer{                                                                // BufferBindingLayout
+          .type{wgpu::BufferBindingType::ReadOnlyStorage},
+        },
+      };
+    }};
+    std::array binding_layouts{                                                 // binding numbers match those of the vertex pulling path in default.wgsl
+      storage_binding_layout(0),                                                // vertices
+      storage_binding_layout(2),                                                // instance offsets
+      storage_binding_layout(3),                                                // visible vertices
+    };
+    wgpu::BindGroupLayoutDescriptor bind_group_layout_descriptor{
+      .label{"Meshlet draw bind group layout 1"},
+      .entryCount{binding_layouts.size()},
+      .entries{binding_layouts.data()},
+    };
+    draw_bind_group_layout = device.CreateBindGroupLayout(&bind_group_layout_descriptor);
+  }
+  {
+    std::array bind_group_layouts{
+      scene_bind_group_layout,
+      bind_group_layout,
+    };
+    wgpu::PipelineLayoutDescriptor pipeline_layout_descriptor{
+      .label{"Meshlet culling pipeline layout 1"},
+      .bindGroupLayoutCount{bind_group_layouts.size()},
+      .bindGroupLayouts{bind_group_layouts.data()},
+    };
+    wgpu::ComputePipelineDescriptor compute_pipeline_descriptor{
+      .label{"Meshlet culling pipeline 1"},
+      .layout{device.CreatePipelineLayout(&pipeline_layout_descriptor)},
+      .compute{                                                                 // ProgrammableStageDescriptor
+        .module{shader_module},
+        .entryPoint{"cs_main"},
+        .constantCount{0},
+        .constants{nullptr},
+      },
+    };
+    pipeline = device.CreateComputePipeline(&compute_pipeline_descriptor);
+  }
+
+  uniform_buffer.init(device, "Meshlet culling uniform buffer 1", sizeof(uniforms));
+  memory.destroy(draw_arguments_buffer);
+  {
+    wgpu::BufferDescriptor buffer_descriptor{
+      .label{"Meshlet draw arguments buffer 1"},
+      .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Storage | wgpu::BufferUsage::Indirect},
+      .size{4 * sizeof(uint32_t)},
+    };
+    draw_arguments_buffer = memory.create_buffer(device, buffer_descriptor, memory_tracker::category::mesh);
+  }
+}
+
+wgpu::Buffer meshlet_culling::create_storage_buffer(char const *label, void const *data, uint64_t size) {
+  /// Create a read-only storage buffer holding some meshlet data
+  wgpu::BufferDescriptor buffer_descriptor{
+    .label{label},
+    .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Storage},
+    .size{(size + 3) / 4 * 4},                                                  // storage bindings must be a multiple of four bytes
+  };
+  auto buffer{memory.create_buffer(device, buffer_descriptor, memory_tracker::category::mesh)};
+  queue.WriteBuffer(buffer, 0, data, size);
+  return buffer;
+}
+
+void meshlet_culling::set_geometry(meshlet_data const &data, wgpu::Buffer const &this_vertex_buffer) {
+  /// Upload the meshlets of a mesh, whose vertices are already in the given buffer
+  memory.destroy(meshlet_buffer);
+  memory.destroy(meshlet_vertex_buffer);
+  memory.destroy(meshlet_triangle_buffer);
+  meshlet_buffer          = create_storage_buffer("Meshlet buffer 1",          data.meshlets.data(),  data.meshlets.size()  * sizeof(data.meshlets[0]));
+  meshlet_vertex_buffer   = create_storage_buffer("Meshlet vertex buffer 1",   data.vertices.data(),  data.vertices.size()  * sizeof(data.vertices[0]));
+  meshlet_triangle_buffer = create_storage_buffer("Meshlet triangle buffer 1", data.triangles.data(), data.triangles.size() * sizeof(data.triangles[0]));
+  vertex_buffer = this_vertex_buffer;
+  meshlet_count = static_cast<uint32_t>(data.meshlets.size());
+  triangle_count = static_cast<uint32_t>(data.triangles.size());
+  bind_group = nullptr;                                                         // rebuilt when the instances are set
+  draw_bind_group = nullptr;
+  logger << "Meshlets: " << meshlet_count << " meshlets from " << triangle_count << " triangles";
+}
+
+void meshlet_culling::set_instances(wgpu::Buffer const &instance_buffer, uint32_t this_instance_count) {
+  /// Size the output for the instances to be culled, and bind everything together - geometry must already be set
+  instance_count = this_instance_count;
+  memory.destroy(visible_vertex_buffer);
+  wgpu::BufferDescriptor buffer_descriptor{
+    .label{"Meshlet visible vertex buffer 1"},
+    .usage{wgpu::BufferUsage::Storage},
+    .size{uint64_t{triangle_count} * instance_count * 3 * 2 * sizeof(uint32_t)},
+  };
+  visible_vertex_buffer = memory.create_buffer(device, buffer_descriptor, memory_tracker::category::mesh);
+
+  {
+    std::array bind_group_entries{
+      wgpu::BindGroupEntry{
+        .binding{0},
+        .buffer{uniform_buffer.get_buffer()},
+        .size{uniform_buffer.get_size()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{1},
+        .buffer{meshlet_buffer},
+        .size{meshlet_buffer.GetSize()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{2},
+        .buffer{meshlet_vertex_buffer},
+        .size{meshlet_vertex_buffer.GetSize()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{3},
+        .buffer{meshlet_triangle_buffer},
+        .size{meshlet_triangle_buffer.GetSize()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{4},
+        .buffer{instance_buffer},
+        .size{instance_buffer.GetSize()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{5},
+        .buffer{visible_vertex_buffer},
+        .size{visible_vertex_buffer.GetSize()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{6},
+        .buffer{draw_arguments_buffer},
+        .size{draw_arguments_buffer.GetSize()},
+      },
+    };
+    wgpu::BindGroupDescriptor bind_group_descriptor{
+      .label{"Meshlet culling bind group 1"},
+      .layout{bind_group_layout},
+      .entryCount{bind_group_entries.size()},
+      .entries{bind_group_entries.data()},
+    };
+    bind_group = device.CreateBindGroup(&bind_group_descriptor);
+  }
+  {
+    std::array bind_group_entries{
+      wgpu::BindGroupEntry{
+        .binding{0},
+        .buffer{vertex_buffer},
+        .size{vertex_buffer.GetSize()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{2},
+        .buffer{instance_buffer},
+        .size{instance_buffer.GetSize()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{3},
+        .buffer{visible_vertex_buffer},
+        .size{visible_vertex_buffer.GetSize()},
+      },
+    };
+    wgpu::BindGroupDescriptor bind_group_descriptor{
+      .label{"Meshlet draw bind group 1"},
+      .layout{draw_bind_group_layout},
+      .entryCount{bind_group_entries.size()},
+      .entries{bind_group_entries.data()},
+    };
+    draw_bind_group = device.CreateBindGroup(&bind_group_descriptor);
+  }
+}
+
+wgpu::BindGroupLayout const &meshlet_culling::get_draw_bind_group_layout() const {
+  /// Return the layout of the bind group the draw pipeline pulls vertices through, as its second group
+  return draw_bind_group_layout;
+}
+
+void meshlet_culling::cull(wgpu::CommandEncoder &command_encoder, wgpu::BindGroup const &scene_bind_group, vec3f const &camera_position) {
+  /// Encode a compute pass culling every meshlet of every instance, which must come before the pass that draws them
+  if(!bind_group) return;
+  uniforms uniform_data{
+    .meshlet_count{meshlet_count},
+    .instance_count{instance_count},
+  };
+  uniform_data.camera_position = camera_position;                               // vectorstorm's copy constructor is explicit
+  uniform_buffer.write(uniform_data);
+  uniform_buffer.upload(queue);
+
+  std::array<uint32_t, 4> const reset_arguments{
+    0,                                                                          // vertexCount, counted up by the shader
+    1,                                                                          // instanceCount - instances are already expanded into the vertices
+    0,                                                                          // firstVertex
+    0,                                                                          // firstInstance
+  };
+  queue.WriteBuffer(draw_arguments_buffer, 0, reset_arguments.data(), sizeof(reset_arguments));
+
+  wgpu::ComputePassDescriptor compute_pass_descriptor{
+    .label{"Meshlet culling pass 1"},
+  };
+  wgpu::ComputePassEncoder compute_pass_encoder{command_encoder.BeginComputePass(&compute_pass_descriptor)};
+  compute_pass_encoder.SetPipeline(pipeline);
+  compute_pass_encoder.SetBindGroup(0, scene_bind_group);
+  compute_pass_encoder.SetBindGroup(1, bind_group);
+  compute_pass_encoder.DispatchWorkgroups((meshlet_count * instance_count + workgroup_size - 1) / workgroup_size);
+  compute_pass_encoder.End();
+}
+
+void meshlet_culling::draw(wgpu::RenderPassEncoder &render_pass_encoder) const {
+  /// Draw the triangles that survived culling, with the pipeline and scene bind group already set
+  if(!draw_bind_group) return;
+  render_pass_encoder.SetBindGroup(1, draw_bind_group);
+  render_pass_encoder.DrawIndirect(draw_arguments_buffer, 0);                   // indirectBuffer, indirectOffset
+}
+
+void meshlet_culling::draw_gui() const {
+  /// Show the size of the culling workload, within the current ImGui window
+  ImGui::Text("%u meshlets, %u triangles, %u instances", meshlet_count, triangle_count, instance_count);
+  ImGui::Text("%u clusters tested per frame", meshlet_count * instance_count);
+}
+
+}
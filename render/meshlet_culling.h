@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <webgpu/webgpu_cpp.h>
+#include "logstorm/logstorm_forward.h"
+#include "vectorstorm/vector/vector3.h"
+#include "memory_tracker.h"
+#include "meshlet_builder.h"
+#include "uniform_block.h"
+
+namespace render {
+
+class meshlet_culling {
+  /// Culls each meshlet of each instance on the GPU, by frustum and normal cone, writing the surviving triangles out to be drawn indirectly
+  /// Triangles are written as a vertex and instance index for each corner, for a vertex pulling shader to fetch from
+  logstorm::manager &logger;
+  memory_tracker &memory;
+
+  wgpu::Device device;
+  wgpu::Queue queue;
+  wgpu::ShaderModule shader_module;
+  wgpu::BindGroupLayout bind_group_layout;                                      // culling inputs and outputs
+  wgpu::BindGroupLayout draw_bind_group_layout;                                 // what the draw pipeline pulls its vertices from
+  wgpu::ComputePipeline pipeline;
+
+  struct alignas(16) uniforms {                                                 // matches cull_uniform_struct in the shader
+    vec3f camera_position;
+    uint32_t meshlet_count{0};
+    uint32_t instance_count{0};
+  };
+  uniform_block uniform_buffer;
+
+  wgpu::Buffer meshlet_buffer;
+  wgpu::Buffer meshlet_vertex_buffer;
+  wgpu::Buffer meshlet_triangle_buffer;
+  wgpu::Buffer visible_vertex_buffer;                                           // sized for every triangle of every instance surviving
+  wgpu::Buffer draw_arguments_buffer;
+  wgpu::Buffer vertex_buffer;                                                   // the mesh the meshlets were built from
+  wgpu::BindGroup bind_group;
+  wgpu::BindGroup draw_bind_group;
+
+  uint32_t meshlet_count{0};
+  uint32_t triangle_count{0};
+  uint32_t instance_count{0};
+
+public:
+  static constexpr uint32_t workgroup_size{64};                                 // matches @workgroup_size in the shader
+
+  meshlet_culling(logstorm::manager &logger, memory_tracker &memory);
+
+  void init(wgpu::Device const &device, wgpu::Queue const &queue, wgpu::BindGroupLayout const &scene_bind_group_layout);
+  void set_geometry(meshlet_data const &data, wgpu::Buffer const &vertex_buffer);
+  void set_instances(wgpu::Buffer const &instance_buffer, uint32_t instance_count);
+
+  wgpu::BindGroupLayout const &get_draw_bind_group_layout() const;
+
+  void cull(wgpu::CommandEncoder &command_encoder, wgpu::BindGroup const &scene_bind_group, vec3f const &camera_position);
+  void draw(wgpu::RenderPassEncoder &render_pass_encoder) const;
+
+  void draw_gui() const;
+
+private:
+  wgpu::Buffer create_storage_buffer(char const *label, void const *data, uint64_t size);
+};
+
+}
@@ -0,0 +1,194 @@
+#include "pipeline_cache.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <emscripten.h>
+#include <magic_enum/magic_enum.hpp>
+#include "logstorm/logstorm.h"
+
+namespace render {
+
+namespace {
+
+struct manifest_header {
+  std::array<char, 4> magic{'W', 'P', 'M', 'F'};
+  uint32_t version{0};
+  uint32_t entry_count{0};
+};
+
+}
+
+pipeline_cache::pipeline_cache(logstorm::manager &this_logger)
+  : logger{this_logger} {
+  /// Default constructor
+}
+
+void pipeline_cache::init(wgpu::Device const &this_device, describe_function &&this_describe) {
+  /// Set the device to create pipelines on, and how to describe each permutation
+  device = this_device;
+  describe = std::move(this_describe);
+  entries.clear();
+  pending_count = 0;
+  ++generation;
+}
+
+void pipeline_cache::warm_up() {
+  /// Load the manifest of permutations used in previous sessions, and start creating them asynchronously in the order they were first needed
+  manifest_loading = true;
+  emscripten_idb_async_load(
+    manifest_db_name,
+    manifest_file_id,
+    this,
+    [](void *data, void *buffer, int size){
+      /// Manifest loaded callback
+      auto &cache{*static_cast<pipeline_cache*>(data)};
+      cache.manifest_loading = false;
+      cache.load_manifest({static_cast<std::byte const*>(buffer), static_cast<size_t>(size)});
+      for(auto const &previous_entry : cache.previous_manifest) {
+        cache.create_async(previous_entry.key);
+      }
+      if(cache.manifest_dirty) cache.save_manifest();
+    },
+    [](void *data){
+      /// Manifest load error callback - normal on the first session
+      auto &cache{*static_cast<pipeline_cache*>(data)};
+      cache.manifest_loading = false;
+      cache.logger << "WebGPU: No pipeline warm-up manifest available, pipelines will be created on first use";
+      if(cache.manifest_dirty) cache.save_manifest();
+    }
+  );
+}
+
+bool pipeline_cache::is_warming_up() const {
+  /// Whether the manifest is still loading or any of its pipelines are still being created
+  return manifest_loading || pending_count != 0;
+}
+
+wgpu::RenderPipeline const &pipeline_cache::get(pipeline_key const &key) {
+  /// Return the pipeline for this permutation, creating it synchronously if it hasn't been warmed up
+  auto &this_entry{entries[key]};
+  if(this_entry.first_use == 0) {
+    this_entry.first_use = ++use_count;
+    save_manifest();                                                            // record it straight away, so it's warmed up next session even if this one ends abruptly
+  }
+  if(!this_entry.pipeline) {
+    if(this_entry.pending) {
+      logger << "WebGPU: Pipeline " << magic_enum::enum_name(key.type) << " still compiling when first used, creating synchronously";
+    } else {
+      logger << "WebGPU: Pipeline " << magic_enum::enum_name(key.type) << " was not warmed up, creating on first use";
+    }
+    describe(key, [&](wgpu::RenderPipelineDescriptor const &descriptor){
+      this_entry.pipeline = device.CreateRenderPipeline(&descriptor);
+    });
+  }
+  return this_entry.pipeline;
+}
+
+void pipeline_cache::load_manifest(std::span<std::byte const> data) {
+  /// Parse a manifest, ignoring it entirely if it's not one we understand
+  previous_manifest.clear();
+  manifest_header header;
+  if(data.size() < sizeof(header)) {
+    logger << "ERROR: WebGPU: Pipeline warm-up manifest is truncated, ignoring it";
+    return;
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  if(header.magic != manifest_header{}.magic || header.version != manifest_version) {
+    logger << "WebGPU: Pipeline warm-up manifest is from a different version, ignoring it";
+    return;
+  }
+  if(data.size() != sizeof(header) + header.entry_count * sizeof(manifest_entry)) {
+    logger << "ERROR: WebGPU: Pipeline warm-up manifest size doesn't match its entry count, ignoring it";
+    return;
+  }
+  previous_manifest.resize(header.entry_count);
+  std::memcpy(previous_manifest.data(), data.data() + sizeof(header), header.entry_count * sizeof(manifest_entry));
+  std::erase_if(previous_manifest, [](manifest_entry const &previous_entry){
+    return !magic_enum::enum_contains(previous_entry.key.type);                 // a permutation type that no longer exists
+  });
+  logger << "WebGPU: Loaded pipeline warm-up manifest with " << previous_manifest.size() << " permutations";
+}
+
+void pipeline_cache::save_manifest() {
+  /// Store the permutations used this session in the order they were first used, followed by those from previous sessions not used yet
+  if(manifest_loading) {
+    manifest_dirty = true;                                                      // saving now would overwrite the entries we haven't read yet
+    return;
+  }
+  manifest_dirty = false;
+
+  std::vector<manifest_entry> manifest;
+  for(auto const &[key, this_entry] : entries) {
+    if(this_entry.first_use != 0) manifest.emplace_back(manifest_entry{.key{key}});
+  }
+  std::ranges::sort(manifest, {}, [&](manifest_entry const &used_entry){
+    return entries.at(used_entry.key).first_use;
+  });
+  for(auto const &previous_entry : previous_manifest) {
+    if(auto it{entries.find(previous_entry.key)}; it != entries.end() && it->second.first_use != 0) continue; // already listed above
+    if(previous_entry.sessions_unused + 1 >= max_sessions_unused) continue;     // no longer used, stop warming it up
+    manifest.emplace_back(manifest_entry{
+      .key{previous_entry.key},
+      .sessions_unused{previous_entry.sessions_unused + 1},
+    });
+  }
+
+  manifest_header const header{
+    .version{manifest_version},
+    .entry_count{static_cast<uint32_t>(manifest.size())},
+  };
+  std::vector<std::byte> serialised(sizeof(header) + manifest.size() * sizeof(manifest_entry));
+  std::memcpy(serialised.data(), &header, sizeof(header));
+  std::memcpy(serialised.data() + sizeof(header), manifest.data(), manifest.size() * sizeof(manifest_entry));
+  emscripten_idb_async_store(                                                   // the data is copied before this returns
+    manifest_db_name,
+    manifest_file_id,
+    serialised.data(),
+    static_cast<int>(serialised.size()),
+    this,
+    nullptr,
+    [](void *data){
+      /// Manifest store error callback
+      auto &cache{*static_cast<pipeline_cache*>(data)};
+      cache.logger << "ERROR: WebGPU: Could not store the pipeline warm-up manifest";
+    }
+  );
+}
+
+void pipeline_cache::create_async(pipeline_key const &key) {
+  /// Start creating a pipeline in the background, unless it already exists
+  auto &this_entry{entries[key]};
+  if(this_entry.pipeline || this_entry.pending) return;
+  this_entry.pending = true;
+  ++pending_count;
+
+  struct request {
+    pipeline_cache &cache;
+    pipeline_key key;
+    unsigned int generation;
+  };
+  describe(key, [&](wgpu::RenderPipelineDescriptor const &descriptor){
+    device.CreateRenderPipelineAsync(
+      &descriptor,
+      [](WGPUCreatePipelineAsyncStatus status_c, WGPURenderPipeline pipeline_ptr, char const *message, void *data){
+        /// Create pipeline async callback
+        std::unique_ptr<request> const this_request{static_cast<request*>(data)};
+        auto pipeline{wgpu::RenderPipeline::Acquire(pipeline_ptr)};             // take ownership straight away, so it's released on every early return
+        auto &cache{this_request->cache};
+        if(this_request->generation != cache.generation) return;                // created for a device we've since replaced
+        auto &requested_entry{cache.entries[this_request->key]};
+        requested_entry.pending = false;
+        --cache.pending_count;
+        if(auto status{static_cast<wgpu::CreatePipelineAsyncStatus>(status_c)}; status != wgpu::CreatePipelineAsyncStatus::Success) {
+          cache.logger << "ERROR: WebGPU: Could not warm up pipeline " << magic_enum::enum_name(this_request->key.type) << ", status " << magic_enum::enum_name(status) << ": " << (message ? message : "");
+          return;
+        }
+        if(!requested_entry.pipeline) requested_entry.pipeline = std::move(pipeline); // otherwise it was needed before it was ready, and already created synchronously
+      },
+      new request{*this, key, generation}
+    );
+  });
+}
+
+}
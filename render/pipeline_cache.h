@@ -0,0 +1,87 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <vector>
+#include <webgpu/webgpu_cpp.h>
+#include "logstorm/logstorm_forward.h"
+
+namespace render {
+
+enum class pipeline_type : uint32_t {
+  scene,
+  scene_pulled,                                                                 // the scene, with vertices fetched from storage buffers in the shader
+  gui_composite,
+  post_process,
+  scene_meshlets,                                                               // the scene, drawn indirectly from the triangles surviving meshlet culling
+  terrain,                                                                      // the clipmap terrain, its grid generated in the vertex shader
+};
+
+struct pipeline_key {
+  /// Identifies one permutation of a render pipeline, as recorded in the warm-up manifest
+  pipeline_type type{pipeline_type::scene};
+  wgpu::TextureFormat colour_format{wgpu::TextureFormat::Undefined};
+  wgpu::TextureFormat depth_format{wgpu::TextureFormat::Undefined};
+  uint32_t sample_count{1};
+  uint32_t variant{0};                                                          // type-specific permutation, such as which post-processing effects are enabled
+
+  auto operator<=>(pipeline_key const&) const = default;
+};
+
+class pipeline_cache {
+  /// Render pipelines by permutation, precreated asynchronously at startup from a manifest of those used in previous sessions
+  /// Browsers recompile WGSL to native shaders every session, so this moves the cost to loading rather than first use
+public:
+  using create_function = std::function<void(wgpu::RenderPipelineDescriptor const&)>;
+  using describe_function = std::function<void(pipeline_key const&, create_function const&)>; // fills in a descriptor for a permutation and passes it on
+
+private:
+  logstorm::manager &logger;
+
+  wgpu::Device device;
+  describe_function describe;
+
+  struct entry {
+    wgpu::RenderPipeline pipeline;
+    bool pending{false};                                                        // asynchronous creation is in progress
+    unsigned int first_use{0};                                                  // order in which this permutation was first used this session, 0 if not yet used
+  };
+  std::map<pipeline_key, entry> entries;
+  unsigned int use_count{0};                                                    // number of permutations used so far this session
+  unsigned int pending_count{0};                                                // asynchronous creations still in progress
+  unsigned int generation{0};                                                   // incremented on each init, so creations still in progress for a previous device are ignored
+
+  struct manifest_entry {
+    pipeline_key key;
+    uint32_t sessions_unused{0};                                                // permutations not used for too many sessions are dropped
+  };
+  std::vector<manifest_entry> previous_manifest;                                // as loaded at startup, carried forward when saving
+  bool manifest_loading{false};
+  bool manifest_dirty{false};                                                   // a save was requested while the manifest was still loading
+
+  static constexpr char const *manifest_db_name{"pipeline_cache"};               // IndexedDB database
+  static constexpr char const *manifest_file_id{"manifest"};
+  static constexpr uint32_t manifest_version{3};
+  static constexpr uint32_t max_sessions_unused{8};
+
+public:
+  pipeline_cache(logstorm::manager &logger);
+
+  void init(wgpu::Device const &device, describe_function &&describe);
+
+  void warm_up();
+  bool is_warming_up() const;
+
+  wgpu::RenderPipeline const &get(pipeline_key const &key);
+
+private:
+  void load_manifest(std::span<std::byte const> data);
+  void save_manifest();
+
+  void create_async(pipeline_key const &key);
+};
+
+}
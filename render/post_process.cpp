@@ -0,0 +1,283 @@
+#include "post_process.h"
+#include <array>
+#include <vector>
+#include <imgui/imgui.h>
+#include "logstorm/logstorm.h"
+#include "embedded/resources.h"
+
+namespace render {
+
+post_process::post_process(logstorm::manager &this_logger, memory_tracker &this_memory)
+  : logger{this_logger},
+    memory{this_memory},
+    uniform_buffer{this_memory} {
+  /// Default constructor
+}
+
+void post_process::init(wgpu::Device const &this_device, wgpu::Queue const &this_queue) {
+  /// Create the shader, bind group layout, sampler, uniform buffer and an identity colour grading table
+  device = this_device;
+  queue = this_queue;
+  bind_group = nullptr;
+  bind_group_input = nullptr;
+
+  {
+    wgpu::ShaderModuleWGSLDescriptor shader_module_wgsl_decriptor;
+    shader_module_wgsl_decriptor.code = embedded::get("render/shaders/post_process.wgsl").c_str();
+    wgpu::ShaderModuleDescriptor shader_module_descriptor{
+      .nextInChain{&shader_module_wgsl_decriptor},
+      .label{"Post-process shader module 1"},
+    };
+    shader_module = device.CreateShaderModule(&shader_module_descriptor);
+  }
+  {
+    std::array binding_layouts{
+      wgpu::BindGroupLayoutEntry{
+        .binding{0},
+        .visibility{wgpu::ShaderStage::Fragment},
+        .texture{                                                               // TextureBindingLayout
+          .sampleType{wgpu::TextureSampleType::Float},
+          .viewDimension{wgpu::TextureViewDimension::e2D},
+        },
+      },
+      wgpu::BindGroupLayoutEntry{
+        .binding{1},
+        .visibility{wgpu::ShaderStage::Fragment},
+        .sampler{                                                               // SamplerBindingLayout
+          .type{wgpu::SamplerBindingType::Filtering},
+        },
+      },
+      wgpu::BindGroupLayoutEntry{
+        .binding{2},
+        .visibility{wgpu::ShaderStage::Fragment},
+        .texture{                                                               // TextureBindingLayout
+          .sampleType{wgpu::TextureSampleType::Float},
+          .viewDimension{wgpu::TextureViewDimension::e3D},
+        },
+      },
+      wgpu::BindGroupLayoutEntry{
+        .binding{3},
+        .visibility{wgpu::ShaderStage::Fragment},
+        .buffer{                                                                // BufferBindingLayout
+          .type{wgpu::BufferBindingType::Uniform},
+          .minBindingSize{sizeof(uniforms)},
+        },
+      },
+    };
+    wgpu::BindGroupLayoutDescriptor bind_group_layout_descriptor{
+      .label{"Post-process bind group layout 1"},
+      .entryCount{binding_layouts.size()},
+      .entries{binding_layouts.data()},
+    };
+    bind_group_layout = device.CreateBindGroupLayout(&bind_group_layout_descriptor);
+  }
+  {
+    wgpu::SamplerDescriptor sampler_descriptor{
+      .label{"Post-process sampler 1"},
+      .addressModeU{wgpu::AddressMode::ClampToEdge},
+      .addressModeV{wgpu::AddressMode::ClampToEdge},
+      .addressModeW{wgpu::AddressMode::ClampToEdge},
+      .magFilter{wgpu::FilterMode::Linear},
+      .minFilter{wgpu::FilterMode::Linear},
+    };
+    sampler = device.CreateSampler(&sampler_descriptor);
+  }
+  uniform_buffer.init(device, "Post-process uniform buffer 1", sizeof(uniforms));
+
+  if(colour_grade_lut_data.empty()) {                                           // otherwise we're recreating resources on a new device, and keep the table we had
+    colour_grade_lut_size = identity_lut_size;
+    colour_grade_lut_data.reserve(identity_lut_size * identity_lut_size * identity_lut_size);
+    for(uint32_t b{0}; b != identity_lut_size; ++b) {
+      for(uint32_t g{0}; g != identity_lut_size; ++g) {
+        for(uint32_t r{0}; r != identity_lut_size; ++r) {
+          auto const scale{[](uint32_t value){return value * 255u / (identity_lut_size - 1);}};
+          colour_grade_lut_data.emplace_back(scale(r) | scale(g) << 8u | scale(b) << 16u | 0xff000000u);
+        }
+      }
+    }
+  }
+  upload_colour_grade_lut();
+}
+
+uint32_t post_process::get_variant() const {
+  /// Return the permutation for the currently enabled effects, as a mask of effect bits - zero means post-processing is off entirely
+  uint32_t variant{0};
+  auto const enable{[&](effect this_effect, bool enabled){
+    if(enabled) variant |= 1u << static_cast<uint32_t>(this_effect);
+  }};
+  enable(effect::tonemap, settings.tonemap);
+  enable(effect::fxaa, settings.fxaa);
+  enable(effect::colour_grade, settings.colour_grade);
+  enable(effect::vignette, settings.vignette);
+  return variant;
+}
+
+void post_process::describe_pipeline(pipeline_key const &key, pipeline_cache::create_function const &create) const {
+  /// Describe the fused pipeline for one permutation of effects, and pass the descriptor on to be created
+  auto const constant{[&](char const *name, effect this_effect){
+    return wgpu::ConstantEntry{
+      .key{name},
+      .value{(key.variant & 1u << static_cast<uint32_t>(this_effect)) ? 1.0 : 0.0},
+    };
+  }};
+  std::array constants{                                                         // specialise the shader, so disabled effects are compiled out
+    constant("tonemap_enabled", effect::tonemap),
+    constant("fxaa_enabled", effect::fxaa),
+    constant("colour_grade_enabled", effect::colour_grade),
+    constant("vignette_enabled", effect::vignette),
+  };
+
+  wgpu::ColorTargetState colour_target_state{
+    .format{key.colour_format},
+  };
+  wgpu::FragmentState fragment_state{
+    .module{shader_module},
+    .entryPoint{"fs_main"},
+    .constantCount{constants.size()},
+    .constants{constants.data()},
+    .targetCount{1},
+    .targets{&colour_target_state},
+  };
+
+  wgpu::DepthStencilState depth_stencil_state{                                  // shares its pass with the GUI, whose pipeline needs a depth attachment
+    .format{key.depth_format},
+    .depthWriteEnabled{false},
+    .depthCompare{wgpu::CompareFunction::Always},
+    .stencilFront{},                                                            // StencilFaceState
+    .stencilBack{},                                                             // StencilFaceState
+    .stencilReadMask{0},
+    .stencilWriteMask{0},
+  };
+
+  wgpu::PipelineLayoutDescriptor pipeline_layout_descriptor{
+    .label{"Post-process pipeline layout 1"},
+    .bindGroupLayoutCount{1},
+    .bindGroupLayouts{&bind_group_layout},
+  };
+
+  wgpu::RenderPipelineDescriptor render_pipeline_descriptor{
+    .label{"Post-process pipeline 1"},
+    .layout{device.CreatePipelineLayout(&pipeline_layout_descriptor)},
+    .vertex{                                                                    // VertexState
+      .module{shader_module},
+      .entryPoint{"vs_main"},
+      .constantCount{0},
+      .constants{nullptr},
+      .bufferCount{0},
+      .buffers{nullptr},
+    },
+    .primitive{                                                                 // PrimitiveState
+      .cullMode{wgpu::CullMode::None},
+    },
+    .depthStencil{&depth_stencil_state},
+    .multisample{
+      .count{key.sample_count},
+    },
+    .fragment{&fragment_state},
+  };
+  create(render_pipeline_descriptor);
+}
+
+void post_process::set_colour_grade_lut(std::span<uint32_t const> rgba, uint32_t size) {
+  /// Replace the colour grading table with a size³ cube of RGBA8 texels, red varying fastest
+  if(rgba.size() != size * size * size) {
+    logger << "ERROR: Post-process: Colour grading table has " << rgba.size() << " texels, expected " << size * size * size;
+    return;
+  }
+  colour_grade_lut_data.assign(rgba.begin(), rgba.end());                       // kept, so it can be uploaded again if the device is lost
+  colour_grade_lut_size = size;
+  if(device) upload_colour_grade_lut();
+}
+
+void post_process::upload_colour_grade_lut() {
+  /// Create the colour grading texture and upload the current table to it
+  {
+    wgpu::TextureDescriptor texture_descriptor{
+      .label{"Colour grading table 1"},
+      .usage{wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst},
+      .dimension{wgpu::TextureDimension::e3D},
+      .size{colour_grade_lut_size, colour_grade_lut_size, colour_grade_lut_size},
+      .format{wgpu::TextureFormat::RGBA8Unorm},
+    };
+    memory.destroy(colour_grade_lut);                                           // any previous table
+    colour_grade_lut = memory.create_texture(device, texture_descriptor, memory_tracker::category::texture);
+    colour_grade_lut_view = colour_grade_lut.CreateView();
+  }
+  wgpu::ImageCopyTexture destination{
+    .texture{colour_grade_lut},
+  };
+  wgpu::TextureDataLayout data_layout{
+    .bytesPerRow{colour_grade_lut_size * static_cast<uint32_t>(sizeof(uint32_t))},
+    .rowsPerImage{colour_grade_lut_size},
+  };
+  wgpu::Extent3D const extent{colour_grade_lut_size, colour_grade_lut_size, colour_grade_lut_size};
+  queue.WriteTexture(&destination, colour_grade_lut_data.data(), colour_grade_lut_data.size() * sizeof(uint32_t), &data_layout, &extent);
+  bind_group = nullptr;                                                         // rebuilt with the new table next time we draw
+}
+
+void post_process::draw(wgpu::RenderPassEncoder &render_pass_encoder, wgpu::RenderPipeline const &pipeline, wgpu::TextureView const &input, vec2ui const &input_size) {
+  /// Draw the fused effects full-screen from the input texture into the current pass
+  uniforms const uniform_data{
+    .inverse_size{vec2f{1.0f, 1.0f} / static_cast<vec2f>(input_size)},
+    .exposure{settings.exposure},
+    .colour_grade_strength{settings.colour_grade_strength},
+    .vignette_strength{settings.vignette_strength},
+    .vignette_radius{settings.vignette_radius},
+  };
+  uniform_buffer.write(uniform_data);
+  uniform_buffer.upload(queue);
+
+  if(!bind_group || bind_group_input != input.Get()) {                          // the input comes from the texture pool, so is usually the same texture each frame
+    std::array bind_group_entries{
+      wgpu::BindGroupEntry{
+        .binding{0},
+        .textureView{input},
+      },
+      wgpu::BindGroupEntry{
+        .binding{1},
+        .sampler{sampler},
+      },
+      wgpu::BindGroupEntry{
+        .binding{2},
+        .textureView{colour_grade_lut_view},
+      },
+      wgpu::BindGroupEntry{
+        .binding{3},
+        .buffer{uniform_buffer.get_buffer()},
+        .size{sizeof(uniforms)},
+      },
+    };
+    wgpu::BindGroupDescriptor bind_group_descriptor{
+      .label{"Post-process bind group 1"},
+      .layout{bind_group_layout},
+      .entryCount{bind_group_entries.size()},
+      .entries{bind_group_entries.data()},
+    };
+    bind_group = device.CreateBindGroup(&bind_group_descriptor);
+    bind_group_input = input.Get();
+  }
+
+  render_pass_encoder.SetPipeline(pipeline);
+  render_pass_encoder.SetBindGroup(0, bind_group);
+  render_pass_encoder.Draw(3);                                                  // vertexCount, instanceCount = 1, firstVertex = 0, firstInstance = 0
+}
+
+void post_process::draw_settings_gui() {
+  /// Show controls for each effect
+  ImGui::Checkbox("Tonemapping", &settings.tonemap);
+  ImGui::BeginDisabled(!settings.tonemap);
+  ImGui::SliderFloat("Exposure", &settings.exposure, 0.1f, 4.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+  ImGui::EndDisabled();
+  ImGui::Checkbox("FXAA", &settings.fxaa);
+  ImGui::Checkbox("Colour grading", &settings.colour_grade);
+  ImGui::BeginDisabled(!settings.colour_grade);
+  ImGui::SliderFloat("Grading strength", &settings.colour_grade_strength, 0.0f, 1.0f);
+  ImGui::EndDisabled();
+  ImGui::Checkbox("Vignette", &settings.vignette);
+  ImGui::BeginDisabled(!settings.vignette);
+  ImGui::SliderFloat("Vignette strength", &settings.vignette_strength, 0.0f, 1.0f);
+  ImGui::SliderFloat("Vignette radius", &settings.vignette_radius, 0.0f, 1.0f);
+  ImGui::EndDisabled();
+}
+
+}
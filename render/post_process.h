@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <webgpu/webgpu_cpp.h>
+#include "logstorm/logstorm_forward.h"
+#include "vectorstorm/vector/vector2.h"
+#include "memory_tracker.h"
+#include "pipeline_cache.h"
+#include "uniform_block.h"
+
+namespace render {
+
+class post_process {
+  /// Tonemapping, colour grading, FXAA and vignette applied to the scene in a single fused full-screen pass
+  /// Each combination of enabled effects is its own pipeline permutation, specialised through override constants
+  logstorm::manager &logger;
+  memory_tracker &memory;
+
+public:
+  enum class effect : uint32_t {                                                // in the order they're applied
+    tonemap,
+    fxaa,
+    colour_grade,
+    vignette,
+  };
+
+  struct settings_data {
+    bool tonemap{true};
+    float exposure{1.0f};
+    bool fxaa{true};
+    bool colour_grade{false};
+    float colour_grade_strength{1.0f};
+    bool vignette{true};
+    float vignette_strength{0.35f};
+    float vignette_radius{0.6f};
+  } settings;
+
+  static constexpr wgpu::TextureFormat input_format{wgpu::TextureFormat::RGBA16Float}; // scene colour is rendered in HDR when post-processing
+
+private:
+  struct alignas(16) uniforms {                                                 // matches post_process_uniforms in the shader
+    vec2f inverse_size;
+    float exposure;
+    float colour_grade_strength;
+    float vignette_strength;
+    float vignette_radius;
+  };
+
+  wgpu::Device device;
+  wgpu::Queue queue;
+  wgpu::ShaderModule shader_module;
+  wgpu::BindGroupLayout bind_group_layout;
+  wgpu::Sampler sampler;
+  wgpu::Texture colour_grade_lut;
+  wgpu::TextureView colour_grade_lut_view;
+  std::vector<uint32_t> colour_grade_lut_data;                                  // RGBA8 texels of the current colour grading table
+  uint32_t colour_grade_lut_size{0};
+  uniform_block uniform_buffer;                                                 // unchanged settings aren't uploaded again
+  wgpu::BindGroup bind_group;
+  WGPUTextureView bind_group_input{nullptr};                                    // the input view the bind group was created for
+
+  static constexpr uint32_t identity_lut_size{16};
+
+public:
+  post_process(logstorm::manager &logger, memory_tracker &memory);
+
+  void init(wgpu::Device const &device, wgpu::Queue const &queue);
+
+  uint32_t get_variant() const;
+  void describe_pipeline(pipeline_key const &key, pipeline_cache::create_function const &create) const;
+
+  void set_colour_grade_lut(std::span<uint32_t const> rgba, uint32_t size);
+
+private:
+  void upload_colour_grade_lut();
+
+public:
+
+  void draw(wgpu::RenderPassEncoder &render_pass_encoder, wgpu::RenderPipeline const &pipeline, wgpu::TextureView const &input, vec2ui const &input_size);
+
+  void draw_settings_gui();
+};
+
+}
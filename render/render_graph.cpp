@@ -0,0 +1,180 @@
+#include "render_graph.h"
+#include <algorithm>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+namespace render {
+
+render_graph::render_graph(texture_pool &this_textures)
+  : textures{this_textures} {
+  /// Default constructor
+}
+
+void render_graph::reset() {
+  /// Discard the passes and resources declared for the last frame, ready to declare the next
+  resources.clear();
+  passes.clear();
+}
+
+render_graph::resource_id render_graph::import_texture(char const *name, wgpu::TextureView const &view) {
+  /// Declare a texture owned outside the graph, such as the swapchain's current texture or a cache persisting between frames
+  resources.emplace_back(resource{
+    .name{name},
+    .imported{true},
+    .view{view},
+  });
+  return static_cast<resource_id>(resources.size() - 1);
+}
+
+render_graph::resource_id render_graph::create_texture(char const *name, texture_description const &description) {
+  /// Declare a transient texture, whose contents only need to last between the passes using it this frame
+  resources.emplace_back(resource{
+    .name{name},
+    .description{description},
+  });
+  return static_cast<resource_id>(resources.size() - 1);
+}
+
+void render_graph::mark_output(resource_id id) {
+  /// Mark a resource as a result of the frame, keeping every pass that contributes to it
+  resources[id].output = true;
+}
+
+void render_graph::add_pass(char const *name, std::vector<resource_id> &&reads, std::vector<resource_id> &&writes, execute_function &&execute) {
+  /// Declare a pass and the resources it reads and writes - the execute function records its commands when the graph runs
+  passes.emplace_back(pass{
+    .name{name},
+    .reads{std::move(reads)},
+    .writes{std::move(writes)},
+    .execute{std::move(execute)},
+  });
+}
+
+wgpu::TextureView const &render_graph::get_view(resource_id id) const {
+  /// Return the view for a resource, valid only while the passes using it are executing
+  return resources[id].view;
+}
+
+void render_graph::execute(wgpu::CommandEncoder &command_encoder) {
+  /// Order the passes, cull those not contributing to an output, back transient textures as they come into use, and record every remaining pass
+  sort();
+  cull();
+  find_lifetimes();
+
+  for(unsigned int pass_index{0}; pass_index != passes.size(); ++pass_index) {
+    auto &this_pass{passes[pass_index]};
+    if(this_pass.culled) continue;
+    for(auto &this_resource : resources) {
+      if(!this_resource.imported && this_resource.first_use == pass_index) acquire_backing(this_resource);
+    }
+    command_encoder.PushDebugGroup(this_pass.name);
+    this_pass.execute(command_encoder);
+    command_encoder.PopDebugGroup();
+    for(auto &this_resource : resources) {
+      if(!this_resource.imported && this_resource.last_use == pass_index) release_backing(this_resource);
+    }
+  }
+}
+
+void render_graph::sort() {
+  /// Order the passes by the resources they read and write, keeping the order they were added in wherever that's already valid
+  std::vector<std::vector<unsigned int>> writers(resources.size());             // passes writing each resource, in the order they were added
+  for(unsigned int pass_index{0}; pass_index != passes.size(); ++pass_index) {
+    for(auto const id : passes[pass_index].writes) {
+      writers[id].emplace_back(pass_index);
+    }
+  }
+
+  std::vector<std::vector<unsigned int>> dependencies(passes.size());           // passes each pass must run after
+  for(unsigned int pass_index{0}; pass_index != passes.size(); ++pass_index) {
+    auto const &this_pass{passes[pass_index]};
+    for(auto const id : this_pass.reads) {
+      bool written{false};
+      for(auto const writer : writers[id]) {
+        if(writer == pass_index) continue;
+        dependencies[pass_index].emplace_back(writer);
+        written = true;
+      }
+      if(!written && !resources[id].imported) {                                 // imported textures hold whatever they held before the frame, but a transient's contents would be undefined
+        throw std::runtime_error{std::string{"Render graph: Pass \""} + this_pass.name + "\" reads transient texture \"" + resources[id].name + "\", which no other pass writes"};
+      }
+    }
+    for(auto const id : this_pass.writes) {
+      for(auto const writer : writers[id]) {
+        if(writer == pass_index) break;
+        dependencies[pass_index].emplace_back(writer);
+      }
+    }
+  }
+
+  std::vector<unsigned int> order;
+  order.reserve(passes.size());
+  std::vector<bool> placed(passes.size());
+  while(order.size() != passes.size()) {
+    unsigned int next{0};                                                       // the earliest added pass whose dependencies have all been placed
+    while(next != passes.size() && (placed[next] || !std::ranges::all_of(dependencies[next], [&](unsigned int dependency){return placed[dependency];}))) {
+      ++next;
+    }
+    if(next == passes.size()) {
+      auto const unplaced{static_cast<size_t>(std::ranges::find(placed, false) - placed.begin())};
+      throw std::runtime_error{std::string{"Render graph: Passes depend on each other in a cycle, including \""} + passes[unplaced].name + "\""};
+    }
+    placed[next] = true;
+    order.emplace_back(next);
+  }
+
+  std::vector<pass> sorted_passes;
+  sorted_passes.reserve(passes.size());
+  for(auto const pass_index : order) {
+    sorted_passes.emplace_back(std::move(passes[pass_index]));
+  }
+  passes = std::move(sorted_passes);
+}
+
+void render_graph::cull() {
+  /// Walk back from the outputs, keeping only passes that write something a kept pass or an output needs
+  std::vector<bool> needed(resources.size());
+  for(resource_id id{0}; id != resources.size(); ++id) {
+    needed[id] = resources[id].output;
+  }
+  for(auto &this_pass : passes | std::views::reverse) {
+    this_pass.culled = std::ranges::none_of(this_pass.writes, [&](resource_id id){return needed[id];});
+    if(this_pass.culled) continue;
+    for(auto const id : this_pass.reads) {
+      needed[id] = true;
+    }
+  }
+}
+
+void render_graph::find_lifetimes() {
+  /// Find the first and last pass using each transient, so its backing texture can be shared outside that range
+  for(auto &this_resource : resources) {
+    this_resource.first_use = static_cast<unsigned int>(passes.size());         // unused transients are never backed
+    this_resource.last_use = 0;
+  }
+  for(unsigned int pass_index{0}; pass_index != passes.size(); ++pass_index) {
+    auto const &this_pass{passes[pass_index]};
+    if(this_pass.culled) continue;
+    for(auto const &ids : {std::cref(this_pass.reads), std::cref(this_pass.writes)}) {
+      for(auto const id : ids.get()) {
+        auto &this_resource{resources[id]};
+        this_resource.first_use = std::min(this_resource.first_use, pass_index);
+        this_resource.last_use = std::max(this_resource.last_use, pass_index);
+      }
+    }
+  }
+}
+
+void render_graph::acquire_backing(resource &this_resource) {
+  /// Back a transient with a texture from the pool
+  this_resource.view = textures.acquire(this_resource.description, this_resource.name);
+}
+
+void render_graph::release_backing(resource &this_resource) {
+  /// Return a transient's texture to the pool, for a later transient to share
+  textures.release(this_resource.view);
+  this_resource.view = nullptr;
+}
+
+}
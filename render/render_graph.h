@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <webgpu/webgpu_cpp.h>
+#include "texture_pool.h"
+
+namespace render {
+
+class render_graph {
+  /// Frame graph of render passes declaring the textures they read and write
+  /// Passes that contribute nothing to an output are culled, and transient textures are only taken from the pool while in use, so transients whose lifetimes don't overlap share textures
+  /// Passes are ordered so each runs after every other pass writing what it reads, with passes writing the same resource kept in the order they were added
+  /// Reading a transient texture no other pass writes, or passes depending on each other in a cycle, is an error rather than a read of undefined contents
+public:
+  using resource_id = uint32_t;
+  using execute_function = std::function<void(wgpu::CommandEncoder&)>;
+
+  using texture_description = texture_pool::description;
+
+private:
+  texture_pool &textures;                                                       // transient textures are drawn from here
+
+  struct resource {
+    char const *name{nullptr};
+    texture_description description;                                            // transient textures only
+    bool imported{false};                                                       // owned outside the graph, rather than transient
+    bool output{false};                                                         // the graph exists to produce this, so passes writing it are never culled
+    wgpu::TextureView view;                                                     // the imported view, or the pooled view backing a transient while it's in use
+    unsigned int first_use{0};                                                  // first and last passes using a transient, in execution order
+    unsigned int last_use{0};
+  };
+  std::vector<resource> resources;
+
+  struct pass {
+    char const *name{nullptr};
+    std::vector<resource_id> reads;
+    std::vector<resource_id> writes;
+    execute_function execute;
+    bool culled{false};
+  };
+  std::vector<pass> passes;
+
+public:
+  render_graph(texture_pool &textures);
+
+  void reset();
+
+  resource_id import_texture(char const *name, wgpu::TextureView const &view);
+  resource_id create_texture(char const *name, texture_description const &description);
+  void mark_output(resource_id id);
+
+  void add_pass(char const *name, std::vector<resource_id> &&reads, std::vector<resource_id> &&writes, execute_function &&execute);
+
+  wgpu::TextureView const &get_view(resource_id id) const;
+
+  void execute(wgpu::CommandEncoder &command_encoder);
+
+private:
+  void sort();
+  void cull();
+  void find_lifetimes();
+  void acquire_backing(resource &this_resource);
+  void release_backing(resource &this_resource);
+};
+
+}
@@ -2,6 +2,7 @@ struct vertex_input {
   @location(0) position: vec3f,
   @location(1) normal: vec3f,
   @location(2) colour: vec4f,
+  @location(3) instance_offset: vec3f,
 };
 
 struct vertex_output {
@@ -17,13 +18,23 @@ struct uniform_struct {
 
 @group(0) @binding(0) var<uniform> uniforms: uniform_struct;
 
+// storage buffers for vertex pulling, with the vertex layout given in 32-bit words by override constants
+@group(1) @binding(0) var<storage, read> vertex_words: array<f32>;
+@group(1) @binding(1) var<storage, read> index_words: array<u32>;             // 16-bit indices, packed two to a word
+@group(1) @binding(2) var<storage, read> instance_offsets: array<f32>;        // three floats per instance
+@group(1) @binding(3) var<storage, read> visible_vertices: array<vec2u>;      // vertex and instance of each corner of the triangles surviving meshlet culling
+
+override vertex_stride: u32 = 10u;
+override position_offset: u32 = 0u;
+override normal_offset: u32 = 3u;
+override colour_offset: u32 = 6u;
+
 const light_dir = vec3f(0.872872, 0.218218, -0.436436); // manually normalised (1.0, 0.25, -0.5)
 const ambient = 0.5f;
 
-@vertex
-fn vs_main(in: vertex_input) -> vertex_output {
+fn shade_vertex(in: vertex_input) -> vertex_output {
   var out: vertex_output;
-  out.position = uniforms.model_view_projection_matrix * vec4f(in.position, 1.0);
+  out.position = uniforms.model_view_projection_matrix * vec4f(in.position + in.instance_offset, 1.0);
   //out.normal = uniforms.normal_matrix * in.normal;
   let transformed_normal = uniforms.normal_matrix * in.normal;
 
@@ -33,6 +44,38 @@ fn vs_main(in: vertex_input) -> vertex_output {
   return out;
 }
 
+fn read_vec3f(base: u32) -> vec3f {
+  return vec3f(vertex_words[base], vertex_words[base + 1u], vertex_words[base + 2u]);
+}
+
+@vertex
+fn vs_main(in: vertex_input) -> vertex_output {
+  return shade_vertex(in);
+}
+
+fn pull_vertex(index: u32, instance_index: u32) -> vertex_input {
+  let base = index * vertex_stride;
+  var in: vertex_input;
+  in.position = read_vec3f(base + position_offset);
+  in.normal = read_vec3f(base + normal_offset);
+  in.colour = vec4f(read_vec3f(base + colour_offset), vertex_words[base + colour_offset + 3u]);
+  in.instance_offset = vec3f(instance_offsets[instance_index * 3u], instance_offsets[instance_index * 3u + 1u], instance_offsets[instance_index * 3u + 2u]);
+  return in;
+}
+
+@vertex
+fn vs_pulled(@builtin(vertex_index) vertex_index: u32, @builtin(instance_index) instance_index: u32) -> vertex_output {
+  let index_word = index_words[vertex_index / 2u];
+  let index = select(index_word & 0xffffu, index_word >> 16u, (vertex_index & 1u) == 1u);
+  return shade_vertex(pull_vertex(index, instance_index));
+}
+
+@vertex
+fn vs_meshlet(@builtin(vertex_index) vertex_index: u32) -> vertex_output {
+  let visible = visible_vertices[vertex_index];
+  return shade_vertex(pull_vertex(visible.x, visible.y));
+}
+
 @fragment
 fn fs_main(in: vertex_output) -> @location(0) vec4f {
   return in.colour;
@@ -0,0 +1,13 @@
+@group(0) @binding(0) var gui_texture: texture_2d<f32>;
+
+@vertex
+fn vs_main(@builtin(vertex_index) vertex_index: u32) -> @builtin(position) vec4f {
+  // single triangle covering the whole viewport
+  let uv = vec2f(f32((vertex_index << 1u) & 2u), f32(vertex_index & 2u));
+  return vec4f(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+
+@fragment
+fn fs_main(@builtin(position) position: vec4f) -> @location(0) vec4f {
+  return textureLoad(gui_texture, vec2i(position.xy), 0);                       // texture is the same size as the viewport, so no sampling is needed
+}
@@ -0,0 +1,93 @@
+struct uniform_struct {                                                         // the scene's uniforms, as in default.wgsl
+  model_view_projection_matrix: mat4x4f,
+  normal_matrix: mat3x3f,
+};
+
+struct meshlet {
+  centre: vec3f,
+  radius: f32,
+  cone_axis: vec3f,
+  cone_cutoff: f32,
+  vertex_offset: u32,
+  triangle_offset: u32,
+  vertex_count: u32,
+  triangle_count: u32,
+};
+
+struct cull_uniform_struct {
+  camera_position: vec3f,                                                       // in model space
+  meshlet_count: u32,
+  instance_count: u32,
+};
+
+struct draw_arguments {                                                         // as read by DrawIndirect
+  vertex_count: atomic<u32>,
+  instance_count: u32,
+  first_vertex: u32,
+  first_instance: u32,
+};
+
+@group(0) @binding(0) var<uniform> uniforms: uniform_struct;
+
+@group(1) @binding(0) var<uniform> cull_uniforms: cull_uniform_struct;
+@group(1) @binding(1) var<storage, read> meshlets: array<meshlet>;
+@group(1) @binding(2) var<storage, read> meshlet_vertices: array<u32>;
+@group(1) @binding(3) var<storage, read> meshlet_triangles: array<u32>;         // three 8-bit local vertex indices per word
+@group(1) @binding(4) var<storage, read> instance_offsets: array<f32>;          // three floats per instance
+@group(1) @binding(5) var<storage, read_write> visible_vertices: array<vec2u>;  // vertex and instance of each corner of each surviving triangle
+@group(1) @binding(6) var<storage, read_write> draw_args: draw_arguments;
+
+fn get_row(row: u32) -> vec4f {
+  let m = uniforms.model_view_projection_matrix;
+  return vec4f(m[0][row], m[1][row], m[2][row], m[3][row]);
+}
+
+fn outside_plane(plane: vec4f, centre: vec3f, radius: f32) -> bool {
+  return dot(plane.xyz, centre) + plane.w < -radius * length(plane.xyz);
+}
+
+fn outside_frustum(centre: vec3f, radius: f32) -> bool {
+  // planes from the rows of the model view projection matrix, with WebGPU's depth range of 0 to w
+  let row_x = get_row(0u);
+  let row_y = get_row(1u);
+  let row_z = get_row(2u);
+  let row_w = get_row(3u);
+  return outside_plane(row_w + row_x, centre, radius)                           // left
+      || outside_plane(row_w - row_x, centre, radius)                           // right
+      || outside_plane(row_w + row_y, centre, radius)                           // bottom
+      || outside_plane(row_w - row_y, centre, radius)                           // top
+      || outside_plane(row_z,         centre, radius)                           // near
+      || outside_plane(row_w - row_z, centre, radius);                          // far
+}
+
+@compute @workgroup_size(64)
+fn cs_main(@builtin(global_invocation_id) id: vec3u) {
+  // one invocation per meshlet of each instance
+  let cluster = id.x;
+  if(cluster >= cull_uniforms.meshlet_count * cull_uniforms.instance_count) {
+    return;
+  }
+  let instance = cluster / cull_uniforms.meshlet_count;
+  let this_meshlet = meshlets[cluster % cull_uniforms.meshlet_count];
+  let offset = vec3f(instance_offsets[instance * 3u], instance_offsets[instance * 3u + 1u], instance_offsets[instance * 3u + 2u]);
+  let centre = this_meshlet.centre + offset;
+
+  if(outside_frustum(centre, this_meshlet.radius)) {
+    return;
+  }
+
+  // every triangle faces away from the camera if it's outside the cone of their normals, allowing for the meshlet's extent
+  let to_centre = centre - cull_uniforms.camera_position;
+  if(dot(to_centre, this_meshlet.cone_axis) >= this_meshlet.cone_cutoff * length(to_centre) + this_meshlet.radius) {
+    return;
+  }
+
+  let first = atomicAdd(&draw_args.vertex_count, this_meshlet.triangle_count * 3u);
+  for(var triangle = 0u; triangle < this_meshlet.triangle_count; triangle++) {
+    let packed = meshlet_triangles[this_meshlet.triangle_offset + triangle];
+    for(var corner = 0u; corner < 3u; corner++) {
+      let local_index = (packed >> (corner * 8u)) & 0xffu;
+      visible_vertices[first + triangle * 3u + corner] = vec2u(meshlet_vertices[this_meshlet.vertex_offset + local_index], instance);
+    }
+  }
+}
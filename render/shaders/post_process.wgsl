@@ -0,0 +1,111 @@
+// All post-processing effects fused into a single full-screen pass
+// Each pipeline enables a subset of effects through override constants, so disabled effects are compiled out of that permutation
+
+override tonemap_enabled: bool = true;
+override fxaa_enabled: bool = true;
+override colour_grade_enabled: bool = false;
+override vignette_enabled: bool = true;
+
+struct post_process_uniforms {
+  inverse_size: vec2f,                                                          // size of one texel of the input, in UV units
+  exposure: f32,
+  colour_grade_strength: f32,
+  vignette_strength: f32,
+  vignette_radius: f32,                                                         // distance from the centre where darkening starts, 1.0 being the corners
+};
+
+@group(0) @binding(0) var input_texture: texture_2d<f32>;
+@group(0) @binding(1) var input_sampler: sampler;
+@group(0) @binding(2) var colour_grade_lut: texture_3d<f32>;
+@group(0) @binding(3) var<uniform> uniforms: post_process_uniforms;
+
+const fxaa_edge_threshold = 0.125;
+const fxaa_edge_threshold_min = 0.0312;
+const fxaa_reduce_multiplier = 0.125;
+const fxaa_reduce_min = 0.0078125;
+const fxaa_span_max = 8.0;
+
+@vertex
+fn vs_main(@builtin(vertex_index) vertex_index: u32) -> @builtin(position) vec4f {
+  // single triangle covering the whole viewport
+  let uv = vec2f(f32((vertex_index << 1u) & 2u), f32(vertex_index & 2u));
+  return vec4f(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+
+fn tonemap(colour: vec3f) -> vec3f {
+  // ACES filmic curve, as fitted by Krzysztof Narkowicz
+  let exposed = colour * uniforms.exposure;
+  return saturate((exposed * (2.51 * exposed + 0.03)) / (exposed * (2.43 * exposed + 0.59) + 0.14));
+}
+
+fn source(uv: vec2f) -> vec3f {
+  // sample the input with the per-pixel effects preceding FXAA applied, so FXAA can sample its neighbourhood without a pass of its own
+  let colour = textureSampleLevel(input_texture, input_sampler, uv, 0.0).rgb;
+  if tonemap_enabled {
+    return tonemap(colour);
+  }
+  return saturate(colour);
+}
+
+fn luma(colour: vec3f) -> f32 {
+  return dot(colour, vec3f(0.299, 0.587, 0.114));
+}
+
+fn fxaa(uv: vec2f) -> vec3f {
+  // FXAA after Timothy Lottes: find edges from the contrast of the diagonal neighbours, and blend along them
+  let texel = uniforms.inverse_size;
+  let centre = source(uv);
+  let luma_centre = luma(centre);
+  let luma_nw = luma(source(uv + vec2f(-1.0, -1.0) * texel));
+  let luma_ne = luma(source(uv + vec2f( 1.0, -1.0) * texel));
+  let luma_sw = luma(source(uv + vec2f(-1.0,  1.0) * texel));
+  let luma_se = luma(source(uv + vec2f( 1.0,  1.0) * texel));
+  let luma_min = min(luma_centre, min(min(luma_nw, luma_ne), min(luma_sw, luma_se)));
+  let luma_max = max(luma_centre, max(max(luma_nw, luma_ne), max(luma_sw, luma_se)));
+  if luma_max - luma_min < max(fxaa_edge_threshold_min, luma_max * fxaa_edge_threshold) {
+    return centre;                                                              // not an edge
+  }
+
+  let direction_unscaled = vec2f(-((luma_nw + luma_ne) - (luma_sw + luma_se)), (luma_nw + luma_sw) - (luma_ne + luma_se));
+  let direction_reduce = max((luma_nw + luma_ne + luma_sw + luma_se) * 0.25 * fxaa_reduce_multiplier, fxaa_reduce_min);
+  let direction_scale = 1.0 / (min(abs(direction_unscaled.x), abs(direction_unscaled.y)) + direction_reduce);
+  let direction = clamp(direction_unscaled * direction_scale, vec2f(-fxaa_span_max), vec2f(fxaa_span_max)) * texel;
+
+  let near = 0.5 * (source(uv + direction * (1.0 / 3.0 - 0.5)) + source(uv + direction * (2.0 / 3.0 - 0.5)));
+  let far = near * 0.5 + 0.25 * (source(uv - direction * 0.5) + source(uv + direction * 0.5));
+  let luma_far = luma(far);
+  if luma_far < luma_min || luma_far > luma_max {
+    return near;                                                                // the wider blend crossed another edge
+  }
+  return far;
+}
+
+fn colour_grade(colour: vec3f) -> vec3f {
+  let lut_size = f32(textureDimensions(colour_grade_lut).x);
+  let uvw = (colour * (lut_size - 1.0) + 0.5) / lut_size;                       // sample between texel centres, so the ends of the range map to the ends of the table
+  let graded = textureSampleLevel(colour_grade_lut, input_sampler, uvw, 0.0).rgb;
+  return mix(colour, graded, uniforms.colour_grade_strength);
+}
+
+fn vignette(colour: vec3f, uv: vec2f) -> vec3f {
+  let corner_distance = length(uv - 0.5) * 1.41421356;                          // 0 at the centre, 1 at the corners
+  return colour * (1.0 - uniforms.vignette_strength * smoothstep(uniforms.vignette_radius, 1.0, corner_distance));
+}
+
+@fragment
+fn fs_main(@builtin(position) position: vec4f) -> @location(0) vec4f {
+  let uv = position.xy * uniforms.inverse_size;
+  var colour: vec3f;
+  if fxaa_enabled {
+    colour = fxaa(uv);
+  } else {
+    colour = source(uv);
+  }
+  if colour_grade_enabled {
+    colour = colour_grade(colour);
+  }
+  if vignette_enabled {
+    colour = vignette(colour, uv);
+  }
+  return vec4f(colour, 1.0);
+}
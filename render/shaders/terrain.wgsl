@@ -0,0 +1,108 @@
+struct uniform_struct {                                                         // the scene's uniforms, as in default.wgsl
+  model_view_projection_matrix: mat4x4f,
+  normal_matrix: mat3x3f,
+};
+
+struct terrain_uniform_struct {
+  translation: vec3f,                                                           // from terrain space to the scene's model space
+  spacing: f32,                                                                 // between vertices of the finest level
+  viewer: vec2f,                                                                // in terrain space
+  windows: array<vec4i, 8>,                                                     // first sample held by each level's layer, in that level's samples
+};
+
+struct terrain_patch {
+  origin: vec2i,                                                                // in samples of its level
+  size: vec2u,                                                                  // in quads
+  level: u32,
+};
+
+struct vertex_output {
+  @builtin(position) position: vec4f,
+  @location(0) normal: vec3f,
+  @location(1) height: f32,
+  @location(2) steepness: f32,
+};
+
+@group(0) @binding(0) var<uniform> uniforms: uniform_struct;
+
+@group(1) @binding(0) var<uniform> terrain: terrain_uniform_struct;
+@group(1) @binding(1) var heightmap: texture_2d_array<f32>;                     // one layer per level, addressed toroidally
+@group(1) @binding(2) var<storage, read> patches: array<terrain_patch>;
+
+override level_count: u32 = 6u;
+override level_size: u32 = 126u;                                                // quads along each side of a level
+override texture_size: u32 = 128u;                                              // texels along each side of a layer, a power of two
+
+const light_dir = vec3f(0.872872, 0.218218, -0.436436);                         // as in default.wgsl
+const ambient = 0.5f;
+
+fn height_at(level: u32, sample: vec2i) -> f32 {
+  // clamp to the samples the level's layer holds, then wrap into the layer
+  let window_first = terrain.windows[level].xy;
+  let texel = clamp(sample, window_first, window_first + i32(texture_size) - 1) & vec2i(i32(texture_size) - 1);
+  return textureLoad(heightmap, texel, i32(level), 0).r;
+}
+
+fn coarser_height_at(level: u32, sample: vec2i) -> f32 {
+  // the next coarser level's surface here, interpolated along its edges and across the diagonal each of its quads is split along
+  let coarser = level + 1u;
+  let half_sample = sample >> vec2u(1u);
+  let odd = (sample & vec2i(1)) != vec2i(0);
+  if(odd.x && odd.y) {
+    return (height_at(coarser, half_sample + vec2i(1, 0)) + height_at(coarser, half_sample + vec2i(0, 1))) * 0.5;
+  }
+  return (height_at(coarser, half_sample) + height_at(coarser, half_sample + vec2i(odd))) * 0.5;
+}
+
+fn morph_factor(level: u32, sample: vec2i) -> f32 {
+  // blend towards the coarser level approaching this level's outer edge, so the vertices there meet it exactly
+  if(level + 1u >= level_count) {
+    return 0.0;
+  }
+  let from_viewer = abs(vec2f(sample) - terrain.viewer / (terrain.spacing * f32(1u << level))); // in this level's quads
+  let half_size = f32(level_size) * 0.5;
+  let width = f32(level_size) * 0.1;
+  let factor = clamp((from_viewer - (half_size - width - 1.0)) / width, vec2f(0.0), vec2f(1.0));
+  return max(factor.x, factor.y);
+}
+
+@vertex
+fn vs_main(@builtin(vertex_index) vertex_index: u32, @builtin(instance_index) instance_index: u32) -> vertex_output {
+  // each instance is a patch, whose grid of quads is generated from the vertex index
+  let this_patch = patches[instance_index];
+  var quad_corners = array(vec2i(0, 0), vec2i(0, 1), vec2i(1, 0), vec2i(1, 0), vec2i(0, 1), vec2i(1, 1)); // two triangles, wound to face up
+  let quad = vertex_index / 6u;
+  let sample = this_patch.origin + vec2i(vec2u(quad % this_patch.size.x, quad / this_patch.size.x)) + quad_corners[vertex_index % 6u];
+  let level = this_patch.level;
+  let spacing = terrain.spacing * f32(1u << level);
+
+  var height = height_at(level, sample);
+  let morph = morph_factor(level, sample);
+  if(morph > 0.0) {
+    height = mix(height, coarser_height_at(level, sample), morph);
+  }
+  let slope = vec2f(
+    height_at(level, sample + vec2i(1, 0)) - height_at(level, sample - vec2i(1, 0)),
+    height_at(level, sample + vec2i(0, 1)) - height_at(level, sample - vec2i(0, 1)),
+  );
+  let normal = normalize(vec3f(-slope.x, 2.0 * spacing, -slope.y));
+
+  var out: vertex_output;
+  out.position = uniforms.model_view_projection_matrix * vec4f(vec3f(f32(sample.x) * spacing, height, f32(sample.y) * spacing) + terrain.translation, 1.0);
+  out.normal = uniforms.normal_matrix * normal;
+  out.height = height;
+  out.steepness = 1.0 - normal.y;
+  return out;
+}
+
+@fragment
+fn fs_main(in: vertex_output) -> @location(0) vec4f {
+  let grass = vec3f(0.25, 0.45, 0.15);
+  let rock = vec3f(0.45, 0.4, 0.35);
+  let snow = vec3f(0.95, 0.95, 1.0);
+  var colour = mix(grass, rock, smoothstep(0.15, 0.4, in.steepness));
+  colour = mix(colour, snow, smoothstep(20.0, 30.0, in.height) * (1.0 - smoothstep(0.3, 0.5, in.steepness)));
+
+  let diffuse_intensity = (max(dot(normalize(in.normal), light_dir), 0.0) * (1.0 - ambient)) + ambient;
+  return vec4f(colour * diffuse_intensity, 1.0);
+}
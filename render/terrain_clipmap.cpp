@@ -0,0 +1,441 @@
+#include "terrain_clipmap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <imgui/imgui.h>
+#include "logstorm/logstorm.h"
+#include "vectorstorm/aabb/aabb3.h"
+#include "embedded/resources.h"
+
+namespace render {
+
+namespace {
+
+float hash_lattice(int32_t x, int32_t z, uint32_t seed) {
+  /// Pseudorandom value in the range 0 to 1 for a lattice point
+  uint32_t hash{static_cast<uint32_t>(x) * 0x8da6b343u ^ static_cast<uint32_t>(z) * 0xd8163841u ^ seed * 0xcb1ab31fu};
+  hash = (hash ^ (hash >> 13)) * 0x85ebca6bu;
+  hash ^= hash >> 16;
+  return static_cast<float>(hash) / 4294967296.0f;
+}
+
+float value_noise(vec2f const &position, uint32_t seed) {
+  /// Smoothly interpolated lattice noise in the range 0 to 1
+  float const floor_x{std::floor(position.x)};
+  float const floor_z{std::floor(position.z)};
+  auto const x{static_cast<int32_t>(floor_x)};
+  auto const z{static_cast<int32_t>(floor_z)};
+  auto const smooth{[](float t){return t * t * (3.0f - 2.0f * t);}};
+  float const tx{smooth(position.x - floor_x)};
+  float const tz{smooth(position.z - floor_z)};
+  float const near_row{std::lerp(hash_lattice(x, z,     seed), hash_lattice(x + 1, z,     seed), tx)};
+  float const far_row{ std::lerp(hash_lattice(x, z + 1, seed), hash_lattice(x + 1, z + 1, seed), tx)};
+  return std::lerp(near_row, far_row, tz);
+}
+
+float default_height(vec2f const &position, float spacing) {
+  /// Fractal noise standing in for streamed height data, leaving out octaves too fine to show at this sample spacing
+  float height{0.0f};
+  float amplitude{32.0f};
+  uint32_t octave{0};
+  for(float wavelength{1024.0f}; wavelength >= spacing * 2.0f; wavelength *= 0.5f) {
+    height += (value_noise(position / wavelength, octave++) * 2.0f - 1.0f) * amplitude;
+    amplitude *= 0.5f;
+  }
+  return height;
+}
+
+bool outside_frustum(aabb3f const &box, mat4f const &model_view_projection) {
+  /// Whether a box lies wholly outside any one plane of the view frustum, testing its corners in clip space
+  std::array<vec4f, 8> corners;
+  for(unsigned int i{0}; i != corners.size(); ++i) corners[i] = model_view_projection * vec4f{box.point(i), 1.0f};
+  auto const all_outside{[&](auto const &outside){
+    return std::ranges::all_of(corners, outside);
+  }};
+  return all_outside([](vec4f const &corner){return corner.x < -corner.w;})     // left
+      || all_outside([](vec4f const &corner){return corner.x >  corner.w;})     // right
+      || all_outside([](vec4f const &corner){return corner.y < -corner.w;})     // bottom
+      || all_outside([](vec4f const &corner){return corner.y >  corner.w;})     // top
+      || all_outside([](vec4f const &corner){return corner.z <  0.0f;})         // near, as WebGPU clips depth below zero
+      || all_outside([](vec4f const &corner){return corner.z >  corner.w;});    // far
+}
+
+}
+
+terrain_clipmap::terrain_clipmap(logstorm::manager &this_logger, memory_tracker &this_memory)
+  : logger{this_logger},
+    memory{this_memory},
+    uniform_buffer{this_memory},
+    source{default_height} {
+  /// Default constructor
+}
+
+void terrain_clipmap::init(wgpu::Device const &this_device, wgpu::Queue const &this_queue, wgpu::BindGroupLayout const &this_scene_bind_group_layout) {
+  /// Create the shader, bind group, heightmap and patch buffer - heights are streamed in by the first update
+  device = this_device;
+  queue = this_queue;
+  scene_bind_group_layout = this_scene_bind_group_layout;
+
+  {
+    wgpu::ShaderModuleWGSLDescriptor shader_module_wgsl_decriptor;
+    shader_module_wgsl_decriptor.code = embedded::get("render/shaders/terrain.wgsl").c_str();
+    wgpu::ShaderModuleDescriptor shader_module_descriptor{
+      .nextInChain{&shader_module_wgsl_decriptor},
+      .label{"Terrain shader module 1"},
+    };
+    shader_module = device.CreateShaderModule(&shader_module_descriptor);
+  }
+  {
+    std::array binding_layouts{
+      wgpu::BindGroupLayoutEntry{
+        .binding{0},
+        .visibility{wgpu::ShaderStage::Vertex},
+        .buffer{                                                                // BufferBindingLayout
+          .type{wgpu::BufferBindingType::Uniform},
+          .minBindingSize{sizeof(uniforms)},
+        },
+      },
+      wgpu::BindGroupLayoutEntry{
+        .binding{1},
+        .visibility{wgpu::ShaderStage::Vertex},
+        .texture{                                                               // TextureBindingLayout
+          .sampleType{wgpu::TextureSampleType::UnfilterableFloat},              // 32-bit float heights are only read with textureLoad
+          .viewDimension{wgpu::TextureViewDimension::e2DArray},
+        },
+      },
+      wgpu::BindGroupLayoutEntry{
+        .binding{2},
+        .visibility{wgpu::ShaderStage::Vertex},
+        .buffer{                                                                // BufferBindingLayout
+          .type{wgpu::BufferBindingType::ReadOnlyStorage},
+        },
+      },
+    };
+    wgpu::BindGroupLayoutDescriptor bind_group_layout_descriptor{
+      .label{"Terrain bind group layout 1"},
+      .entryCount{binding_layouts.size()},
+      .entries{binding_layouts.data()},
+    };
+    bind_group_layout = device.CreateBindGroupLayout(&bind_group_layout_descriptor);
+  }
+  {
+    wgpu::TextureDescriptor texture_descriptor{
+      .label{"Terrain heightmap 1"},
+      .usage{wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst},
+      .dimension{wgpu::TextureDimension::e2D},
+      .size{texture_size, texture_size, level_count},
+      .format{wgpu::TextureFormat::R32Float},
+    };
+    memory.destroy(heightmap);
+    heightmap = memory.create_texture(device, texture_descriptor, memory_tracker::category::texture);
+    wgpu::TextureViewDescriptor texture_view_descriptor{
+      .label{"Terrain heightmap view 1"},
+      .dimension{wgpu::TextureViewDimension::e2DArray},
+    };
+    heightmap_view = heightmap.CreateView(&texture_view_descriptor);
+  }
+  uniform_buffer.init(device, "Terrain uniform buffer 1", sizeof(uniforms));
+  memory.destroy(patch_buffer);
+  {
+    wgpu::BufferDescriptor buffer_descriptor{
+      .label{"Terrain patch buffer 1"},
+      .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Storage},
+      .size{max_patches * sizeof(patch)},
+    };
+    patch_buffer = memory.create_buffer(device, buffer_descriptor, memory_tracker::category::mesh);
+  }
+  {
+    std::array bind_group_entries{
+      wgpu::BindGroupEntry{
+        .binding{0},
+        .buffer{uniform_buffer.get_buffer()},
+        .size{uniform_buffer.get_size()},
+      },
+      wgpu::BindGroupEntry{
+        .binding{1},
+        .textureView{heightmap_view},
+      },
+      wgpu::BindGroupEntry{
+        .binding{2},
+        .buffer{patch_buffer},
+        .size{patch_buffer.GetSize()},
+      },
+    };
+    wgpu::BindGroupDescriptor bind_group_descriptor{
+      .label{"Terrain bind group 1"},
+      .layout{bind_group_layout},
+      .entryCount{bind_group_entries.size()},
+      .entries{bind_group_entries.data()},
+    };
+    bind_group = device.CreateBindGroup(&bind_group_descriptor);
+  }
+
+  logger << "Terrain: " << level_count << " clipmap levels of " << level_size << " quads square, " << texture_size << "x" << texture_size << " heights each";
+  for(auto &this_level : levels) {                                              // the heightmap is new, so every level streams in again
+    this_level.valid = false;
+    this_level.heights.assign(texture_size * texture_size, 0.0f);
+  }
+}
+
+void terrain_clipmap::set_height_function(height_function &&this_source) {
+  /// Replace where heights are streamed from, streaming every level in again from the new source
+  source = std::move(this_source);
+  for(auto &this_level : levels) this_level.valid = false;
+}
+
+void terrain_clipmap::describe_pipeline(pipeline_key const &key, pipeline_cache::create_function const &create) const {
+  /// Describe the terrain pipeline, and pass the descriptor on to be created
+  auto const constant{[](char const *name, uint32_t value){
+    return wgpu::ConstantEntry{
+      .key{name},
+      .value{static_cast<double>(value)},
+    };
+  }};
+  std::array constants{
+    constant("level_count", level_count),
+    constant("level_size", level_size),
+    constant("texture_size", texture_size),
+  };
+
+  wgpu::ColorTargetState colour_target_state{
+    .format{key.colour_format},
+  };
+  wgpu::FragmentState fragment_state{
+    .module{shader_module},
+    .entryPoint{"fs_main"},
+    .constantCount{0},
+    .constants{nullptr},
+    .targetCount{1},
+    .targets{&colour_target_state},
+  };
+
+  wgpu::DepthStencilState depth_stencil_state{
+    .format{key.depth_format},
+    .depthWriteEnabled{true},
+    .depthCompare{wgpu::CompareFunction::Less},
+    .stencilFront{},                                                            // StencilFaceState
+    .stencilBack{},                                                             // StencilFaceState
+    .stencilReadMask{0},
+    .stencilWriteMask{0},
+  };
+
+  std::array bind_group_layouts{
+    scene_bind_group_layout,
+    bind_group_layout,
+  };
+  wgpu::PipelineLayoutDescriptor pipeline_layout_descriptor{
+    .label{"Terrain pipeline layout 1"},
+    .bindGroupLayoutCount{bind_group_layouts.size()},
+    .bindGroupLayouts{bind_group_layouts.data()},
+  };
+
+  wgpu::RenderPipelineDescriptor render_pipeline_descriptor{
+    .label{"Terrain render pipeline 1"},
+    .layout{device.CreatePipelineLayout(&pipeline_layout_descriptor)},
+    .vertex{                                                                    // VertexState
+      .module{shader_module},
+      .entryPoint{"vs_main"},
+      .constantCount{constants.size()},
+      .constants{constants.data()},
+      .bufferCount{0},                                                          // the grid is generated from the vertex and instance index
+      .buffers{nullptr},
+    },
+    .primitive{                                                                 // PrimitiveState
+      .cullMode{wgpu::CullMode::Back},
+    },
+    .depthStencil{&depth_stencil_state},
+    .multisample{
+      .count{key.sample_count},
+    },
+    .fragment{&fragment_state},
+  };
+  create(render_pipeline_descriptor);
+}
+
+void terrain_clipmap::update(vec3f const &camera_position, mat4f const &model_view_projection) {
+  /// Move the viewer over the terrain, stream in the heights each level now needs, and choose the patches to draw this frame
+  /// The camera position and transform are in the scene's model space, which terrain space is translated from
+  patches.clear();
+  draw_calls.clear();
+  stats = {};
+  if(!settings.enabled || !bind_group) return;
+
+  scroll.z += settings.speed;
+  vec2f const viewer{camera_position.x + scroll.x, camera_position.z + scroll.z};
+  vec3f const translation{-scroll.x, settings.base_height, -scroll.z};
+
+  constexpr auto block{static_cast<int32_t>(block_size)};
+  for(uint32_t level{0}; level != level_count; ++level) {
+    float const spacing{sample_spacing * static_cast<float>(1u << level)};
+    stream_level(level, {                                                       // snapped to every other sample, so the level's vertices line up with the next coarser level's
+      static_cast<int32_t>(std::floor(viewer.x / spacing * 0.5f)) * 2 - 2 * block,
+      static_cast<int32_t>(std::floor(viewer.z / spacing * 0.5f)) * 2 - 2 * block,
+    });
+  }
+  for(uint32_t level{0}; level != level_count; ++level) add_patches(level, model_view_projection, translation);
+
+  std::ranges::sort(patches, {}, [](patch const &this_patch){
+    return std::pair{this_patch.size.x, this_patch.size.z};
+  });
+  for(uint32_t i{0}; i != patches.size(); ++i) {
+    if(draw_calls.empty() || patches[draw_calls.back().first_instance].size != patches[i].size) {
+      draw_calls.emplace_back(draw_call{
+        .vertex_count{patches[i].size.x * patches[i].size.z * 6},               // two triangles per quad
+        .first_instance{i},
+      });
+    }
+    ++draw_calls.back().instance_count;
+  }
+  stats.patches_drawn = static_cast<uint32_t>(patches.size());
+  if(!patches.empty()) queue.WriteBuffer(patch_buffer, 0, patches.data(), patches.size() * sizeof(patches[0]));
+
+  uniforms uniform_data;
+  uniform_data.translation = translation;                                       // vectorstorm's copy constructor is explicit
+  uniform_data.viewer = viewer;
+  for(uint32_t level{0}; level != level_count; ++level) {
+    uniform_data.windows[level] = vec4i{levels[level].origin.x, levels[level].origin.z, 0, 0};
+  }
+  uniform_buffer.write(uniform_data);
+  uniform_buffer.upload(queue);
+}
+
+void terrain_clipmap::stream_level(uint32_t level, vec2i const &origin) {
+  /// Move a level's window to a new origin, uploading only the rows and columns of samples it didn't already hold
+  auto &this_level{levels[level]};
+  if(this_level.valid && this_level.origin == origin) return;
+
+  constexpr auto size{static_cast<int32_t>(texture_size)};
+  vec2i const shift{origin - this_level.origin};
+  if(!this_level.valid || std::abs(shift.x) >= size || std::abs(shift.z) >= size) {
+    upload_region(level, origin, {texture_size, texture_size});                 // nothing the layer holds is still wanted
+  } else {
+    if(shift.x != 0) {                                                          // columns entering the window, across all its rows
+      upload_region(level, {shift.x > 0 ? this_level.origin.x + size : origin.x, origin.z}, {static_cast<uint32_t>(std::abs(shift.x)), texture_size});
+    }
+    if(shift.z != 0) {                                                          // rows entering the window, leaving out the columns just uploaded
+      upload_region(level, {std::max(origin.x, this_level.origin.x), shift.z > 0 ? this_level.origin.z + size : origin.z}, {static_cast<uint32_t>(size - std::abs(shift.x)), static_cast<uint32_t>(std::abs(shift.z))});
+    }
+  }
+  this_level.origin = origin;
+  this_level.valid = true;
+
+  auto const [min_height, max_height]{std::ranges::minmax(this_level.heights)};
+  this_level.min_height = min_height;
+  this_level.max_height = max_height;
+}
+
+void terrain_clipmap::upload_region(uint32_t level, vec2i const &first, vec2ui const &size) {
+  /// Fetch and upload the heights of a rectangle of samples, split wherever it wraps around the edges of the level's layer
+  auto &this_level{levels[level]};
+  float const spacing{sample_spacing * static_cast<float>(1u << level)};
+  std::vector<float> data;
+  for(uint32_t rows_done{0}; rows_done != size.z;) {
+    auto const z{first.z + static_cast<int32_t>(rows_done)};
+    auto const texel_z{static_cast<uint32_t>(z) & (texture_size - 1)};          // wraps negative samples too
+    auto const rows{std::min(size.z - rows_done, texture_size - texel_z)};
+    for(uint32_t columns_done{0}; columns_done != size.x;) {
+      auto const x{first.x + static_cast<int32_t>(columns_done)};
+      auto const texel_x{static_cast<uint32_t>(x) & (texture_size - 1)};
+      auto const columns{std::min(size.x - columns_done, texture_size - texel_x)};
+
+      data.clear();
+      data.reserve(rows * columns);
+      for(uint32_t j{0}; j != rows; ++j) {
+        for(uint32_t i{0}; i != columns; ++i) {
+          float const height{source(vec2f{static_cast<float>(x + static_cast<int32_t>(i)), static_cast<float>(z + static_cast<int32_t>(j))} * spacing, spacing)};
+          data.emplace_back(height);
+          this_level.heights[(texel_z + j) * texture_size + texel_x + i] = height;
+        }
+      }
+
+      wgpu::ImageCopyTexture destination{
+        .texture{heightmap},
+        .origin{texel_x, texel_z, level},                                       // Origin3D, with the level's layer as z
+      };
+      wgpu::TextureDataLayout data_layout{
+        .bytesPerRow{columns * static_cast<uint32_t>(sizeof(float))},
+        .rowsPerImage{rows},
+      };
+      wgpu::Extent3D const extent{columns, rows, 1};
+      queue.WriteTexture(&destination, data.data(), data.size() * sizeof(float), &data_layout, &extent);
+      columns_done += columns;
+    }
+    rows_done += rows;
+  }
+  stats.samples_streamed += size.x * size.z;
+}
+
+void terrain_clipmap::add_patches(uint32_t level, mat4f const &model_view_projection, vec3f const &translation) {
+  /// Add the patches making up one level that lie at least partly within the view frustum
+  /// Each level is a ring of 4x4 blocks around a hole for the next finer level, with fix-ups filling the two-quad gaps between the middle blocks
+  /// The finer level sits a quad off centre in the hole, so an L-shaped trim fills the row and column it leaves uncovered
+  auto const &this_level{levels[level]};
+  float const spacing{sample_spacing * static_cast<float>(1u << level)};
+  float min_height{this_level.min_height};
+  float max_height{this_level.max_height};
+  if(level + 1 != level_count) {                                                // the edges morph to the coarser level's heights
+    min_height = std::min(min_height, levels[level + 1].min_height);
+    max_height = std::max(max_height, levels[level + 1].max_height);
+  }
+
+  auto const add{[&](vec2i const &offset, vec2ui const &size){
+    /// Add a patch at an offset in samples from the level's origin, if it's in view
+    ++stats.patches_total;
+    vec2i const first{this_level.origin + offset};
+    aabb3f const bounds{
+      vec3f{static_cast<float>(first.x) * spacing, min_height, static_cast<float>(first.z) * spacing} + translation,
+      vec3f{static_cast<float>(first.x + static_cast<int32_t>(size.x)) * spacing, max_height, static_cast<float>(first.z + static_cast<int32_t>(size.z)) * spacing} + translation,
+    };
+    if(outside_frustum(bounds, model_view_projection)) return;
+    patches.emplace_back(patch{
+      .origin{this_level.origin + offset},
+      .size{size.x, size.z},
+      .level{level},
+    });
+  }};
+
+  constexpr auto block{static_cast<int32_t>(block_size)};
+  constexpr std::array<int32_t, 4> block_offsets{0, block, 2 * block + 2, 3 * block + 2};
+  for(uint32_t j{0}; j != block_offsets.size(); ++j) {
+    for(uint32_t i{0}; i != block_offsets.size(); ++i) {
+      if((i == 1 || i == 2) && (j == 1 || j == 2)) continue;                    // the hole
+      add({block_offsets[i], block_offsets[j]}, {block_size, block_size});
+    }
+  }
+  add({2 * block, 0},             {2, block_size});                             // fix-ups
+  add({2 * block, 3 * block + 2}, {2, block_size});
+  add({0,             2 * block}, {block_size, 2});
+  add({3 * block + 2, 2 * block}, {block_size, 2});
+
+  constexpr int32_t hole_size{2 * block + 2};
+  if(level == 0) {                                                              // nothing finer, so the hole is filled
+    add({block, block}, {hole_size, hole_size});
+    return;
+  }
+  vec2i const gap{levels[level - 1].origin / 2 - (this_level.origin + vec2i{block, block})}; // 1 where the finer level leaves the hole's first row or column uncovered, 0 where it leaves its last
+  add({gap.x != 0 ? block : block + hole_size - 1, block}, {1, hole_size});     // trim column
+  add({gap.x != 0 ? block + 1 : block, gap.z != 0 ? block : block + hole_size - 1}, {hole_size - 1, 1}); // trim row
+}
+
+void terrain_clipmap::draw(wgpu::RenderPassEncoder &render_pass_encoder, wgpu::RenderPipeline const &pipeline) const {
+  /// Draw the patches in view with one instanced draw per patch size, with the scene bind group already set
+  if(draw_calls.empty()) return;
+  render_pass_encoder.SetPipeline(pipeline);
+  render_pass_encoder.SetBindGroup(1, bind_group);
+  for(auto const &call : draw_calls) {
+    render_pass_encoder.Draw(call.vertex_count, call.instance_count, 0, call.first_instance); // vertexCount, instanceCount, firstVertex, firstInstance
+  }
+}
+
+void terrain_clipmap::draw_settings_gui() {
+  /// Show controls for the terrain, and how much of it was drawn and streamed last frame
+  ImGui::Checkbox("Terrain", &settings.enabled);
+  ImGui::BeginDisabled(!settings.enabled);
+  ImGui::SliderFloat("Travel speed", &settings.speed, 0.0f, 20.0f, "%.2f");
+  ImGui::SliderFloat("Terrain height", &settings.base_height, -200.0f, 0.0f, "%.0f");
+  ImGui::Text("%u of %u patches drawn, %u heights streamed", stats.patches_drawn, stats.patches_total, stats.samples_streamed);
+  ImGui::EndDisabled();
+}
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <webgpu/webgpu_cpp.h>
+#include "logstorm/logstorm_forward.h"
+#include "vectorstorm/matrix/matrix4.h"
+#include "vectorstorm/vector/vector2.h"
+#include "vectorstorm/vector/vector3.h"
+#include "vectorstorm/vector/vector4.h"
+#include "memory_tracker.h"
+#include "pipeline_cache.h"
+#include "uniform_block.h"
+
+namespace render {
+
+class terrain_clipmap {
+  /// Terrain drawn as a geometry clipmap: nested square rings of grid, each level twice the spacing of the one inside it, centred on the viewer
+  /// Each level's heights live in one layer of a texture array, addressed toroidally so only the rows and columns the viewer moves into are streamed in
+  /// The grid itself has no vertex buffers - each patch is an instance, and the vertex shader generates its quads from the vertex index
+  logstorm::manager &logger;
+  memory_tracker &memory;
+
+public:
+  using height_function = std::function<float(vec2f const &position, float spacing)>; // height at a position in terrain space, sampled this far apart, so detail finer than the spacing can be left out
+
+  struct settings_data {
+    bool enabled{true};
+    float speed{0.5f};                                                          // how far the viewer travels over the terrain each frame
+    float base_height{-60.0f};                                                  // where the terrain's zero height sits in the scene
+  } settings;
+
+  static constexpr uint32_t level_count{6};
+  static constexpr uint32_t block_size{31};                                     // quads along each side of a block, four blocks and a two-quad fix-up making up each side of a level
+  static constexpr uint32_t level_size{4 * block_size + 2};                     // quads along each side of a level
+  static constexpr uint32_t texture_size{128};                                  // heightmap texels along each side of a level's layer, covering one level with a texel to spare
+  static constexpr float sample_spacing{1.0f};                                  // distance between vertices of the finest level
+
+private:
+  static constexpr uint32_t max_levels{8};                                      // room for level windows in the shader's uniforms
+  static_assert(level_count <= max_levels);
+  static_assert(level_size + 1 <= texture_size);
+  static_assert((texture_size & (texture_size - 1)) == 0, "toroidal addressing wraps with a mask");
+
+  struct alignas(16) uniforms {                                                 // matches terrain_uniform_struct in the shader
+    vec3f translation;                                                          // from terrain space to the scene's model space
+    float spacing{sample_spacing};
+    vec2f viewer;                                                               // in terrain space
+    vec2f padding;                                                              // the shader aligns the array to 16 bytes
+    std::array<vec4i, max_levels> windows;                                      // first sample held by each level's layer, in that level's samples
+  };
+
+  struct alignas(8) patch {                                                     // matches terrain_patch in the shader
+    vec2i origin;                                                               // in samples of its level
+    vec2ui size;                                                                // in quads
+    uint32_t level{0};
+  };
+  static_assert(sizeof(patch) == 24);
+  static constexpr uint32_t max_patches{level_count * 18};                      // a ring of 12 blocks, 4 fix-ups and 2 trims per level, and no more for the filled finest level
+
+  struct draw_call {                                                            // patches of one size, drawn as one instanced draw
+    uint32_t vertex_count{0};
+    uint32_t first_instance{0};
+    uint32_t instance_count{0};
+  };
+
+  struct level_data {
+    vec2i origin;                                                               // first sample of the level's grid, and of its window in the heightmap
+    bool valid{false};                                                          // whether the heightmap layer holds the window at origin
+    float min_height{0.0f};                                                     // bounds of the heights in the window, for culling
+    float max_height{0.0f};
+    std::vector<float> heights;                                                 // CPU copy of the layer, in the same toroidal layout
+  };
+
+  wgpu::Device device;
+  wgpu::Queue queue;
+  wgpu::ShaderModule shader_module;
+  wgpu::BindGroupLayout scene_bind_group_layout;
+  wgpu::BindGroupLayout bind_group_layout;
+  wgpu::Texture heightmap;                                                      // one layer per level
+  wgpu::TextureView heightmap_view;
+  uniform_block uniform_buffer;
+  wgpu::Buffer patch_buffer;
+  wgpu::BindGroup bind_group;
+
+  height_function source;                                                       // where heights are streamed from
+  std::array<level_data, level_count> levels;
+  vec2f scroll;                                                                 // terrain space position of the scene's origin
+  std::vector<patch> patches;                                                   // surviving culling this frame, sorted by size
+  std::vector<draw_call> draw_calls;
+
+  struct stats_data {
+    uint32_t patches_total{0};
+    uint32_t patches_drawn{0};
+    uint32_t samples_streamed{0};                                               // heights uploaded this frame
+  } stats;
+
+public:
+  terrain_clipmap(logstorm::manager &logger, memory_tracker &memory);
+
+  void init(wgpu::Device const &device, wgpu::Queue const &queue, wgpu::BindGroupLayout const &scene_bind_group_layout);
+  void set_height_function(height_function &&source);
+
+  void describe_pipeline(pipeline_key const &key, pipeline_cache::create_function const &create) const;
+
+  void update(vec3f const &camera_position, mat4f const &model_view_projection);
+  void draw(wgpu::RenderPassEncoder &render_pass_encoder, wgpu::RenderPipeline const &pipeline) const;
+
+  void draw_settings_gui();
+
+private:
+  void stream_level(uint32_t level, vec2i const &origin);
+  void upload_region(uint32_t level, vec2i const &first, vec2ui const &size);
+  void add_patches(uint32_t level, mat4f const &model_view_projection, vec3f const &translation);
+};
+
+}
@@ -0,0 +1,118 @@
+#include "texture_pool.h"
+#include <algorithm>
+#include <iterator>
+#include <imgui/imgui.h>
+#include <magic_enum/magic_enum.hpp>
+#include "logstorm/logstorm.h"
+
+namespace render {
+
+texture_pool::texture_pool(logstorm::manager &this_logger, memory_tracker &this_memory)
+  : logger{this_logger},
+    memory{this_memory} {
+  /// Default constructor
+}
+
+void texture_pool::init(wgpu::Device const &this_device) {
+  /// Set the device textures are created on, discarding any made on a previous device
+  device = this_device;
+  entries.clear();
+}
+
+wgpu::TextureView texture_pool::acquire(description const &texture_description, char const *label, memory_tracker::category memory_category) {
+  /// Return a view of a free texture matching the description, creating one only if there isn't one
+  /// Contents are undefined, so the first pass using it should clear it
+  entry *best{nullptr};
+  for(auto &this_entry : entries) {
+    if(this_entry.in_use || this_entry.texture_description != texture_description) continue;
+    if(!best || this_entry.last_used_frame > best->last_used_frame) best = &this_entry; // prefer the most recently used, to let the rest age out
+  }
+  if(!best) {
+    wgpu::TextureDescriptor texture_descriptor{
+      .label{label},
+      .usage{texture_description.usage},
+      .dimension{wgpu::TextureDimension::e2D},
+      .size{
+        texture_description.size.x,
+        texture_description.size.y,
+        1
+      },
+      .format{texture_description.format},
+      .sampleCount{texture_description.sample_count},
+    };
+    auto texture{memory.create_texture(device, texture_descriptor, memory_category)};
+    auto view{texture.CreateView()};
+    best = &entries.emplace_back(entry{
+      .texture_description{texture_description},
+      .label{label},
+      .texture{std::move(texture)},
+      .view{std::move(view)},
+    });
+    logger << "WebGPU: Texture pool: Created " << texture_description.size << " texture for " << label << ", " << entries.size() << " textures pooled";
+  }
+  best->in_use = true;
+  best->last_used_frame = frame;
+  return best->view;
+}
+
+void texture_pool::release(wgpu::TextureView const &view) {
+  /// Return a texture to the pool, for anything later wanting a texture with the same description
+  auto it{std::ranges::find_if(entries, [&](entry const &this_entry){
+    return this_entry.view.Get() == view.Get();
+  })};
+  if(it == entries.end()) return;
+  it->in_use = false;
+  it->last_used_frame = frame;
+}
+
+void texture_pool::end_frame() {
+  /// Evict free textures that haven't been used recently, or are in excess of what we keep spare
+  /// Call once the frame's commands have been submitted, then have the memory tracker destroy what was evicted
+  std::ranges::sort(entries, std::ranges::greater{}, &entry::last_used_frame);  // most recently used first, so the excess is at the end
+  unsigned int free_count{0};
+  std::erase_if(entries, [&](entry &this_entry){
+    if(this_entry.in_use) return false;
+    ++free_count;
+    if(this_entry.last_used_frame == frame) return false;                       // textures used this frame are kept, even in excess
+    if(free_count <= max_free_textures && frame - this_entry.last_used_frame <= max_unused_frames) return false;
+    memory.destroy_later(this_entry.texture);                                   // release the memory once submitted, rather than whenever the handle is collected
+    return true;
+  });
+  ++frame;
+}
+
+void texture_pool::evict(uint64_t bytes) {
+  /// Evict free textures, least recently used first, until at least this many bytes are freed or none are left
+  /// This can happen mid-frame, so textures used this frame are never evicted, and the rest are only destroyed once the frame is submitted
+  std::ranges::sort(entries, std::ranges::greater{}, &entry::last_used_frame);
+  auto const target{memory.get_total() > bytes ? memory.get_total() - bytes : 0};
+  while(memory.get_total() > target) {
+    auto it{std::ranges::find_if(entries.rbegin(), entries.rend(), [&](entry const &this_entry){
+      return !this_entry.in_use && this_entry.last_used_frame != frame;
+    })};
+    if(it == entries.rend()) break;
+    logger << "WebGPU: Texture pool: Evicting " << it->texture_description.size << " texture to stay within the memory budget";
+    memory.destroy_later(it->texture);
+    entries.erase(std::next(it).base());
+  }
+}
+
+void texture_pool::draw_gui(image_function const &draw_image) {
+  /// List the pooled textures, with a preview of each that can be sampled, within the current ImGui window
+  /// Free textures show whatever was last drawn into them, and are kept from eviction while previewed, as this frame's GUI samples them
+  constexpr float preview_height{64.0f};
+  if(entries.empty()) {
+    ImGui::TextDisabled("No textures pooled");
+    return;
+  }
+  for(auto &this_entry : entries) {
+    auto const &size{this_entry.texture_description.size};
+    auto const format_name{magic_enum::enum_name(this_entry.texture_description.format)};
+    ImGui::Text("%s: %ux%u %.*s%s", this_entry.label, size.x, size.y, static_cast<int>(format_name.size()), format_name.data(), this_entry.in_use ? "" : " (free)");
+    if(!(this_entry.texture_description.usage & wgpu::TextureUsage::TextureBinding) || this_entry.texture_description.sample_count != 1) continue;
+    this_entry.last_used_frame = frame;
+    draw_image(this_entry.texture, this_entry.view, {preview_height * static_cast<float>(size.x) / static_cast<float>(std::max(size.y, 1u)), preview_height});
+  }
+}
+
+}
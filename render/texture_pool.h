@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <webgpu/webgpu_cpp.h>
+#include "logstorm/logstorm_forward.h"
+#include "vectorstorm/vector/vector2.h"
+#include "memory_tracker.h"
+
+namespace render {
+
+class texture_pool {
+  /// Recycles render target textures across frames and resizes, rather than destroying and recreating them
+  /// Textures nobody has used for a while are evicted, so sizes left behind by a resize don't linger
+public:
+  struct description {
+    wgpu::TextureFormat format{wgpu::TextureFormat::Undefined};
+    vec2ui size;
+    wgpu::TextureUsage usage{wgpu::TextureUsage::RenderAttachment};
+    uint32_t sample_count{1};
+
+    bool operator==(description const&) const = default;
+  };
+
+  using image_function = std::function<void(wgpu::Texture const &texture, wgpu::TextureView const &view, vec2f const &size)>; // draws a texture in the GUI at this size
+
+private:
+  logstorm::manager &logger;
+  memory_tracker &memory;
+
+  wgpu::Device device;
+
+  struct entry {
+    description texture_description;
+    char const *label{nullptr};                                                 // of whatever first acquired it
+    wgpu::Texture texture;
+    wgpu::TextureView view;
+    bool in_use{false};
+    unsigned int last_used_frame{0};
+  };
+  std::vector<entry> entries;
+  unsigned int frame{0};
+
+  static constexpr unsigned int max_unused_frames{120};                         // free textures unused for this long are evicted
+  static constexpr unsigned int max_free_textures{8};                           // beyond this, the least recently used free textures are evicted at the end of the frame
+
+public:
+  texture_pool(logstorm::manager &logger, memory_tracker &memory);
+
+  void init(wgpu::Device const &device);
+
+  wgpu::TextureView acquire(description const &texture_description, char const *label, memory_tracker::category memory_category = memory_tracker::category::render_target);
+  void release(wgpu::TextureView const &view);
+
+  void end_frame();
+  void evict(uint64_t bytes);
+
+  void draw_gui(image_function const &draw_image);
+};
+
+}
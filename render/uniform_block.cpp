@@ -0,0 +1,81 @@
+#include "uniform_block.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace render {
+
+uniform_block::uniform_block(memory_tracker &this_memory)
+  : memory{this_memory} {
+  /// Default constructor
+}
+
+void uniform_block::init(wgpu::Device const &device, char const *label, uint64_t size) {
+  /// Create the buffer, replacing any previous one - new buffers are zeroed, so the shadow copy starts out zeroed and clean to match
+  memory.destroy(buffer);
+  size = (size + write_alignment - 1) / write_alignment * write_alignment;
+  wgpu::BufferDescriptor buffer_descriptor{
+    .label{label},
+    .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform},
+    .size{size},
+  };
+  buffer = memory.create_buffer(device, buffer_descriptor, memory_tracker::category::uniform);
+  shadow.assign(size, std::byte{0});
+  dirty.clear();
+}
+
+wgpu::Buffer const &uniform_block::get_buffer() const {
+  /// Return the buffer, for binding
+  return buffer;
+}
+
+uint64_t uniform_block::get_size() const {
+  /// Return the size of the buffer in bytes
+  return shadow.size();
+}
+
+void uniform_block::write(uint64_t offset, void const *data, uint64_t size) {
+  /// Write data into the shadow copy, marking only the bytes that differ from what it already holds as dirty
+  assert(offset + size <= shadow.size());
+  auto const *source{static_cast<std::byte const*>(data)};
+  auto *destination{shadow.data() + offset};
+  uint64_t first{0};
+  while(first != size && source[first] == destination[first]) ++first;
+  if(first == size) return;                                                     // nothing changed
+  uint64_t last{size};
+  while(source[last - 1] == destination[last - 1]) --last;
+  std::memcpy(destination + first, source + first, last - first);
+  mark_dirty(offset + first, offset + last);
+}
+
+void uniform_block::upload(wgpu::Queue const &queue) {
+  /// Upload the dirty ranges of the shadow copy to the buffer, one WriteBuffer call for each
+  for(auto const &this_range : dirty) {
+    queue.WriteBuffer(
+      buffer,                                                                   // buffer
+      this_range.begin,                                                         // offset
+      shadow.data() + this_range.begin,                                         // data
+      this_range.end - this_range.begin                                         // size
+    );
+  }
+  dirty.clear();
+}
+
+void uniform_block::mark_dirty(uint64_t begin, uint64_t end) {
+  /// Add a range to the dirty list, widened to the write alignment and merged with any ranges it touches or comes near
+  begin = begin / write_alignment * write_alignment;
+  end = std::min((end + write_alignment - 1) / write_alignment * write_alignment, static_cast<uint64_t>(shadow.size()));
+  auto first{std::lower_bound(dirty.begin(), dirty.end(), begin, [](range const &this_range, uint64_t value){
+    return this_range.end + merge_gap < value;                                  // ranges ending well before us are left alone
+  })};
+  auto last{first};
+  while(last != dirty.end() && last->begin <= end + merge_gap) {
+    begin = std::min(begin, last->begin);
+    end = std::max(end, last->end);
+    ++last;
+  }
+  first = dirty.erase(first, last);
+  dirty.insert(first, range{begin, end});
+}
+
+}
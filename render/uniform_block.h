@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <webgpu/webgpu_cpp.h>
+#include "memory_tracker.h"
+
+namespace render {
+
+class uniform_block {
+  /// A uniform buffer with a CPU shadow copy of its contents, so only the byte ranges that actually changed are uploaded
+  /// Writes go to the shadow copy, and upload() sends the dirty ranges, merging nearby ones into as few WriteBuffer calls as possible
+  memory_tracker &memory;
+
+  wgpu::Buffer buffer;
+  std::vector<std::byte> shadow;                                                // what the buffer will hold once dirty ranges are uploaded
+
+  struct range {
+    uint64_t begin{0};
+    uint64_t end{0};
+  };
+  std::vector<range> dirty;                                                     // sorted, and never overlapping or within merge_gap of each other
+
+  static constexpr uint64_t write_alignment{4};                                 // WriteBuffer offsets and sizes must be multiples of this
+  static constexpr uint64_t merge_gap{16};                                      // ranges closer than this are uploaded as one, as re-sending a few clean bytes costs less than another call
+
+public:
+  uniform_block(memory_tracker &memory);
+
+  void init(wgpu::Device const &device, char const *label, uint64_t size);
+
+  wgpu::Buffer const &get_buffer() const;
+  uint64_t get_size() const;
+
+  void write(uint64_t offset, void const *data, uint64_t size);
+  template<typename T>
+  void write(T const &data, uint64_t offset = 0) {
+    /// Write a value at an offset in the block, typically a whole uniform struct or one of its members
+    write(offset, &data, sizeof(T));
+  }
+
+  void upload(wgpu::Queue const &queue);
+
+private:
+  void mark_dirty(uint64_t begin, uint64_t end);
+};
+
+}
@@ -1,6 +1,10 @@
 #include "webgpu_renderer.h"
 #include "logstorm/manager.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -9,10 +13,11 @@
 #include <emscripten/val.h>
 #include <imgui/imgui_impl_wgpu.h>
 #include <magic_enum/magic_enum.hpp>
+#include "meshlet_builder.h"
 #include "vertex.h"
 #include "triangle_index.h"
 #include "uniforms.h"
-#include "shaders/default.wgsl.h"
+#include "embedded/resources.h"
 
 namespace render {
 
@@ -90,9 +95,21 @@ std::string enum_wgpu_name(Tcpp enum_in) {
 }
 
 webgpu_renderer::webgpu_renderer(logstorm::manager &this_logger)
-  : logger{this_logger} {
+  : logger{this_logger},
+    errors{this_logger},
+    memory{this_logger},
+    pipelines{this_logger},
+    textures{this_logger, memory},
+    graph{textures},
+    post{this_logger, memory},
+    scene_uniforms{memory},
+    meshlets{this_logger, memory},
+    terrain{this_logger, memory} {
   /// Construct a WebGPU renderer and populate those members that don't require delayed init
   if(!webgpu.instance) throw std::runtime_error{"Could not initialize WebGPU"};
+  memory.add_eviction_function([this](uint64_t bytes_over){
+    textures.evict(bytes_over);                                                 // spare render targets are the only thing we can drop and recreate later
+  });
 
   // find out about the initial canvas size and the current window and doc sizes
   window.viewport_size.assign(emscripten::val::global("window")["innerWidth"].as<unsigned int>(),
@@ -120,377 +137,384 @@ void webgpu_renderer::init(std::function<void(webgpu_data const&)> &&this_postin
   postinit_callback = this_postinit_callback;
   main_loop_callback = this_main_loop_callback;
 
-  {
-    // request an adapter
-    wgpu::RequestAdapterOptions adapter_request_options{
-      .compatibleSurface{webgpu.surface},
-      .powerPreference{wgpu::PowerPreference::HighPerformance},
-    };
+  request_adapter();
 
-    webgpu.instance.RequestAdapter(
-      &adapter_request_options,
-      [](WGPURequestAdapterStatus status_c, WGPUAdapterImpl *adapter_ptr, const char *message, void *data){
-        /// Request adapter callback
-        auto &renderer{*static_cast<webgpu_renderer*>(data)};
-        auto &logger{renderer.logger};
-        auto &webgpu{renderer.webgpu};
-        if(message) logger << "WebGPU: Request adapter callback message: " << message;
-        if(auto status{static_cast<wgpu::RequestAdapterStatus>(status_c)}; status != wgpu::RequestAdapterStatus::Success) {
-          logger << "ERROR: WebGPU adapter request failure, status " << enum_wgpu_name<wgpu::RequestAdapterStatus>(status_c);
-          throw std::runtime_error{"WebGPU: Could not get adapter"};
-        }
-
-        auto &adapter{webgpu.adapter};
-        adapter = wgpu::Adapter::Acquire(adapter_ptr);
-        if(!adapter) throw std::runtime_error{"WebGPU: Could not acquire adapter"};
+  emscripten_set_main_loop_arg([](void *data){
+    /// Dispatch the loop waiting for WebGPU to become ready
+    auto &renderer{*static_cast<webgpu_renderer*>(data)};
+    renderer.wait_to_configure_loop();
+  }, this, 0, true);                                                            // loop function, user data, FPS (0 to use browser requestAnimationFrame mechanism), simulate infinite loop
+  std::unreachable();
+}
 
-        // report surface and adapter capabilities
-        #ifndef NDEBUG
-          {
-            wgpu::SurfaceCapabilities surface_capabilities;
-            webgpu.surface.GetCapabilities(adapter, &surface_capabilities);
-            for(size_t i{0}; i != surface_capabilities.formatCount; ++i) {
-              logger << "DEBUG: WebGPU surface capabilities: texture formats: " << magic_enum::enum_name(surface_capabilities.formats[i]);
-            }
-            for(size_t i{0}; i != surface_capabilities.presentModeCount; ++i) {
-              logger << "DEBUG: WebGPU surface capabilities: present modes: " << magic_enum::enum_name(surface_capabilities.presentModes[i]);
-            }
-            for(size_t i{0}; i != surface_capabilities.alphaModeCount; ++i) {
-              logger << "DEBUG: WebGPU surface capabilities: alpha modes: " << magic_enum::enum_name(surface_capabilities.alphaModes[i]);
-            }
-          }
-        #endif // NDEBUG
-        webgpu.surface_preferred_format = webgpu.surface.GetPreferredFormat(adapter);
-        logger << "WebGPU surface preferred format for this adapter: " << magic_enum::enum_name(webgpu.surface_preferred_format);
-        if(webgpu.surface_preferred_format == wgpu::TextureFormat::Undefined) {
-          webgpu.surface_preferred_format = wgpu::TextureFormat::BGRA8Unorm;
-          logger << "WebGPU manually specifying preferred format: " << magic_enum::enum_name(webgpu.surface_preferred_format);
-        }
+void webgpu_renderer::request_adapter() {
+  /// Request an adapter and then a device from it, asynchronously - the device is available in webgpu.device once both have completed
+  wgpu::RequestAdapterOptions adapter_request_options{
+    .compatibleSurface{webgpu.surface},
+    .powerPreference{wgpu::PowerPreference::HighPerformance},
+  };
 
+  webgpu.instance.RequestAdapter(
+    &adapter_request_options,
+    [](WGPURequestAdapterStatus status_c, WGPUAdapterImpl *adapter_ptr, const char *message, void *data){
+      /// Request adapter callback
+      auto &renderer{*static_cast<webgpu_renderer*>(data)};
+      auto &logger{renderer.logger};
+      auto &webgpu{renderer.webgpu};
+      if(message) logger << "WebGPU: Request adapter callback message: " << message;
+      if(auto status{static_cast<wgpu::RequestAdapterStatus>(status_c)}; status != wgpu::RequestAdapterStatus::Success) {
+        logger << "ERROR: WebGPU adapter request failure, status " << enum_wgpu_name<wgpu::RequestAdapterStatus>(status_c);
+        throw std::runtime_error{"WebGPU: Could not get adapter"};
+      }
+
+      auto &adapter{webgpu.adapter};
+      adapter = wgpu::Adapter::Acquire(adapter_ptr);
+      if(!adapter) throw std::runtime_error{"WebGPU: Could not acquire adapter"};
+
+      // report surface and adapter capabilities
+      #ifndef NDEBUG
         {
-          wgpu::AdapterInfo adapter_info;
-          adapter.GetInfo(&adapter_info);
-          #ifndef NDEBUG
-            logger << "DEBUG: WebGPU adapter info: vendor: " << adapter_info.vendor;
-            logger << "DEBUG: WebGPU adapter info: architecture: " << adapter_info.architecture;
-            logger << "DEBUG: WebGPU adapter info: device: " << adapter_info.device;
-            logger << "DEBUG: WebGPU adapter info: description: " << adapter_info.description;
-            logger << "DEBUG: WebGPU adapter info: vendorID:deviceID: " << adapter_info.vendorID << ":" << adapter_info.deviceID;
-            logger << "DEBUG: WebGPU adapter info: backendType: " << magic_enum::enum_name(adapter_info.backendType);
-            logger << "DEBUG: WebGPU adapter info: adapterType: " << magic_enum::enum_name(adapter_info.adapterType);
-          #endif // NDEBUG
-          logger << "WebGPU adapter info: " << adapter_info.description << " (" << magic_enum::enum_name(adapter_info.backendType) << ", " << adapter_info.vendor << ", " << adapter_info.architecture << ")";
+          wgpu::SurfaceCapabilities surface_capabilities;
+          webgpu.surface.GetCapabilities(adapter, &surface_capabilities);
+          for(size_t i{0}; i != surface_capabilities.formatCount; ++i) {
+            logger << "DEBUG: WebGPU surface capabilities: texture formats: " << magic_enum::enum_name(surface_capabilities.formats[i]);
+          }
+          for(size_t i{0}; i != surface_capabilities.presentModeCount; ++i) {
+            logger << "DEBUG: WebGPU surface capabilities: present modes: " << magic_enum::enum_name(surface_capabilities.presentModes[i]);
+          }
+          for(size_t i{0}; i != surface_capabilities.alphaModeCount; ++i) {
+            logger << "DEBUG: WebGPU surface capabilities: alpha modes: " << magic_enum::enum_name(surface_capabilities.alphaModes[i]);
+          }
         }
+      #endif // NDEBUG
+      webgpu.surface_preferred_format = webgpu.surface.GetPreferredFormat(adapter);
+      logger << "WebGPU surface preferred format for this adapter: " << magic_enum::enum_name(webgpu.surface_preferred_format);
+      if(webgpu.surface_preferred_format == wgpu::TextureFormat::Undefined) {
+        webgpu.surface_preferred_format = wgpu::TextureFormat::BGRA8Unorm;
+        logger << "WebGPU manually specifying preferred format: " << magic_enum::enum_name(webgpu.surface_preferred_format);
+      }
+
+      {
+        wgpu::AdapterInfo adapter_info;
+        adapter.GetInfo(&adapter_info);
         #ifndef NDEBUG
-          {
-            wgpu::AdapterProperties adapter_properties;
-            adapter.GetProperties(&adapter_properties);
-            // TODO: wgpuAdapterGetProperties is deprecated, use wgpuAdapterGetInfo instead - C++ wrapper needs to be updated
-            logger << "DEBUG: WebGPU adapter properties: vendorID: " << adapter_properties.vendorID;
-            logger << "DEBUG: WebGPU adapter properties: vendorName: " << adapter_properties.vendorName;
-            logger << "DEBUG: WebGPU adapter properties: architecture: " << adapter_properties.architecture;
-            logger << "DEBUG: WebGPU adapter properties: deviceID: " << adapter_properties.deviceID;
-            logger << "DEBUG: WebGPU adapter properties: name: " << adapter_properties.name;
-            logger << "DEBUG: WebGPU adapter properties: driverDescription: " << adapter_properties.driverDescription;
-            logger << "DEBUG: WebGPU adapter properties: backendType: " << magic_enum::enum_name(adapter_properties.backendType);
-            logger << "DEBUG: WebGPU adapter properties: adapterType: " << magic_enum::enum_name(adapter_properties.adapterType);
-            logger << "DEBUG: WebGPU adapter properties: compatibilityMode: " << std::boolalpha << adapter_properties.compatibilityMode;
-            logger << "DEBUG: WebGPU adapter properties: nextInChain: " << adapter_properties.nextInChain;
-          }
+          logger << "DEBUG: WebGPU adapter info: vendor: " << adapter_info.vendor;
+          logger << "DEBUG: WebGPU adapter info: architecture: " << adapter_info.architecture;
+          logger << "DEBUG: WebGPU adapter info: device: " << adapter_info.device;
+          logger << "DEBUG: WebGPU adapter info: description: " << adapter_info.description;
+          logger << "DEBUG: WebGPU adapter info: vendorID:deviceID: " << adapter_info.vendorID << ":" << adapter_info.deviceID;
+          logger << "DEBUG: WebGPU adapter info: backendType: " << magic_enum::enum_name(adapter_info.backendType);
+          logger << "DEBUG: WebGPU adapter info: adapterType: " << magic_enum::enum_name(adapter_info.adapterType);
         #endif // NDEBUG
-        std::set<wgpu::FeatureName> adapter_features;
+        logger << "WebGPU adapter info: " << adapter_info.description << " (" << magic_enum::enum_name(adapter_info.backendType) << ", " << adapter_info.vendor << ", " << adapter_info.architecture << ")";
+      }
+      #ifndef NDEBUG
         {
-          // see https://developer.mozilla.org/en-US/docs/Web/API/GPUSupportedFeatures and https://www.w3.org/TR/webgpu/#feature-index
-          auto const count{adapter.EnumerateFeatures(nullptr)};
-          logger << "DEBUG: WebGPU adapter features count: " << count;
-          std::vector<wgpu::FeatureName> adapter_features_arr(count);
-          adapter.EnumerateFeatures(adapter_features_arr.data());
-          for(unsigned int i{0}; i != adapter_features_arr.size(); ++i) {
-            adapter_features.emplace(adapter_features_arr[i]);
-          }
+          wgpu::AdapterProperties adapter_properties;
+          adapter.GetProperties(&adapter_properties);
+          // TODO: wgpuAdapterGetProperties is deprecated, use wgpuAdapterGetInfo instead - C++ wrapper needs to be updated
+          logger << "DEBUG: WebGPU adapter properties: vendorID: " << adapter_properties.vendorID;
+          logger << "DEBUG: WebGPU adapter properties: vendorName: " << adapter_properties.vendorName;
+          logger << "DEBUG: WebGPU adapter properties: architecture: " << adapter_properties.architecture;
+          logger << "DEBUG: WebGPU adapter properties: deviceID: " << adapter_properties.deviceID;
+          logger << "DEBUG: WebGPU adapter properties: name: " << adapter_properties.name;
+          logger << "DEBUG: WebGPU adapter properties: driverDescription: " << adapter_properties.driverDescription;
+          logger << "DEBUG: WebGPU adapter properties: backendType: " << magic_enum::enum_name(adapter_properties.backendType);
+          logger << "DEBUG: WebGPU adapter properties: adapterType: " << magic_enum::enum_name(adapter_properties.adapterType);
+          logger << "DEBUG: WebGPU adapter properties: compatibilityMode: " << std::boolalpha << adapter_properties.compatibilityMode;
+          logger << "DEBUG: WebGPU adapter properties: nextInChain: " << adapter_properties.nextInChain;
         }
-        for(auto const feature : adapter_features) {
-          logger << "DEBUG: WebGPU adapter features: " << enum_wgpu_name<wgpu::FeatureName, WGPUFeatureName>(feature);
+      #endif // NDEBUG
+      std::set<wgpu::FeatureName> adapter_features;
+      {
+        // see https://developer.mozilla.org/en-US/docs/Web/API/GPUSupportedFeatures and https://www.w3.org/TR/webgpu/#feature-index
+        auto const count{adapter.EnumerateFeatures(nullptr)};
+        logger << "DEBUG: WebGPU adapter features count: " << count;
+        std::vector<wgpu::FeatureName> adapter_features_arr(count);
+        adapter.EnumerateFeatures(adapter_features_arr.data());
+        for(unsigned int i{0}; i != adapter_features_arr.size(); ++i) {
+          adapter_features.emplace(adapter_features_arr[i]);
         }
-
-        wgpu::SupportedLimits adapter_limits;
-        bool const result{adapter.GetLimits(&adapter_limits)};
-        if(!result) throw std::runtime_error{"WebGPU: Could not query adapter limits"};
+      }
+      for(auto const feature : adapter_features) {
+        logger << "DEBUG: WebGPU adapter features: " << enum_wgpu_name<wgpu::FeatureName, WGPUFeatureName>(feature);
+      }
+
+      wgpu::SupportedLimits adapter_limits;
+      bool const result{adapter.GetLimits(&adapter_limits)};
+      if(!result) throw std::runtime_error{"WebGPU: Could not query adapter limits"};
+      #ifndef NDEBUG
+        logger << "DEBUG: WebGPU adapter limits result: " << std::boolalpha << result;
+        logger << "DEBUG: WebGPU adapter limits nextInChain: " << adapter_limits.nextInChain;
+        logger << "DEBUG: WebGPU adapter limits maxTextureDimension1D: " << adapter_limits.limits.maxTextureDimension1D;
+        logger << "DEBUG: WebGPU adapter limits maxTextureDimension2D: " << adapter_limits.limits.maxTextureDimension2D;
+        logger << "DEBUG: WebGPU adapter limits maxTextureDimension3D: " << adapter_limits.limits.maxTextureDimension3D;
+        logger << "DEBUG: WebGPU adapter limits maxTextureArrayLayers: " << adapter_limits.limits.maxTextureArrayLayers;
+        logger << "DEBUG: WebGPU adapter limits maxBindGroups: " << adapter_limits.limits.maxBindGroups;
+        logger << "DEBUG: WebGPU adapter limits maxBindGroupsPlusVertexBuffers: " << adapter_limits.limits.maxBindGroupsPlusVertexBuffers;
+        logger << "DEBUG: WebGPU adapter limits maxBindingsPerBindGroup: " << adapter_limits.limits.maxBindingsPerBindGroup;
+        logger << "DEBUG: WebGPU adapter limits maxDynamicUniformBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicUniformBuffersPerPipelineLayout;
+        logger << "DEBUG: WebGPU adapter limits maxDynamicStorageBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicStorageBuffersPerPipelineLayout;
+        logger << "DEBUG: WebGPU adapter limits maxSamplersPerShaderStage: " << adapter_limits.limits.maxSamplersPerShaderStage;
+        logger << "DEBUG: WebGPU adapter limits maxStorageBuffersPerShaderStage: " << adapter_limits.limits.maxStorageBuffersPerShaderStage;
+        logger << "DEBUG: WebGPU adapter limits maxStorageTexturesPerShaderStage: " << adapter_limits.limits.maxStorageTexturesPerShaderStage;
+        logger << "DEBUG: WebGPU adapter limits maxUniformBuffersPerShaderStage: " << adapter_limits.limits.maxUniformBuffersPerShaderStage;
+        logger << "DEBUG: WebGPU adapter limits maxUniformBufferBindingSize: " << adapter_limits.limits.maxUniformBufferBindingSize;
+        logger << "DEBUG: WebGPU adapter limits maxStorageBufferBindingSize: " << adapter_limits.limits.maxStorageBufferBindingSize;
+        logger << "DEBUG: WebGPU adapter limits minUniformBufferOffsetAlignment: " << adapter_limits.limits.minUniformBufferOffsetAlignment;
+        logger << "DEBUG: WebGPU adapter limits minStorageBufferOffsetAlignment: " << adapter_limits.limits.minStorageBufferOffsetAlignment;
+        logger << "DEBUG: WebGPU adapter limits maxVertexBuffers: " << adapter_limits.limits.maxVertexBuffers;
+        logger << "DEBUG: WebGPU adapter limits maxBufferSize: " << adapter_limits.limits.maxBufferSize;
+        logger << "DEBUG: WebGPU adapter limits maxVertexAttributes: " << adapter_limits.limits.maxVertexAttributes;
+        logger << "DEBUG: WebGPU adapter limits maxVertexBufferArrayStride: " << adapter_limits.limits.maxVertexBufferArrayStride;
+        logger << "DEBUG: WebGPU adapter limits maxInterStageShaderComponents: " << adapter_limits.limits.maxInterStageShaderComponents;
+        logger << "DEBUG: WebGPU adapter limits maxInterStageShaderVariables: " << adapter_limits.limits.maxInterStageShaderVariables;
+        logger << "DEBUG: WebGPU adapter limits maxColorAttachments: " << adapter_limits.limits.maxColorAttachments;
+        logger << "DEBUG: WebGPU adapter limits maxColorAttachmentBytesPerSample: " << adapter_limits.limits.maxColorAttachmentBytesPerSample;
+        logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupStorageSize: " << adapter_limits.limits.maxComputeWorkgroupStorageSize;
+        logger << "DEBUG: WebGPU adapter limits maxComputeInvocationsPerWorkgroup: " << adapter_limits.limits.maxComputeInvocationsPerWorkgroup;
+        logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupSizeX: " << adapter_limits.limits.maxComputeWorkgroupSizeX;
+        logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupSizeY: " << adapter_limits.limits.maxComputeWorkgroupSizeY;
+        logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupSizeZ: " << adapter_limits.limits.maxComputeWorkgroupSizeZ;
+        logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupsPerDimension: " << adapter_limits.limits.maxComputeWorkgroupsPerDimension;
+      #endif // NDEBUG
+
+      // specify required features for the device
+      std::set<wgpu::FeatureName> required_features{
+        wgpu::FeatureName::Depth32FloatStencil8,
         #ifndef NDEBUG
-          logger << "DEBUG: WebGPU adapter limits result: " << std::boolalpha << result;
-          logger << "DEBUG: WebGPU adapter limits nextInChain: " << adapter_limits.nextInChain;
-          logger << "DEBUG: WebGPU adapter limits maxTextureDimension1D: " << adapter_limits.limits.maxTextureDimension1D;
-          logger << "DEBUG: WebGPU adapter limits maxTextureDimension2D: " << adapter_limits.limits.maxTextureDimension2D;
-          logger << "DEBUG: WebGPU adapter limits maxTextureDimension3D: " << adapter_limits.limits.maxTextureDimension3D;
-          logger << "DEBUG: WebGPU adapter limits maxTextureArrayLayers: " << adapter_limits.limits.maxTextureArrayLayers;
-          logger << "DEBUG: WebGPU adapter limits maxBindGroups: " << adapter_limits.limits.maxBindGroups;
-          logger << "DEBUG: WebGPU adapter limits maxBindGroupsPlusVertexBuffers: " << adapter_limits.limits.maxBindGroupsPlusVertexBuffers;
-          logger << "DEBUG: WebGPU adapter limits maxBindingsPerBindGroup: " << adapter_limits.limits.maxBindingsPerBindGroup;
-          logger << "DEBUG: WebGPU adapter limits maxDynamicUniformBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicUniformBuffersPerPipelineLayout;
-          logger << "DEBUG: WebGPU adapter limits maxDynamicStorageBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicStorageBuffersPerPipelineLayout;
-          logger << "DEBUG: WebGPU adapter limits maxSamplersPerShaderStage: " << adapter_limits.limits.maxSamplersPerShaderStage;
-          logger << "DEBUG: WebGPU adapter limits maxStorageBuffersPerShaderStage: " << adapter_limits.limits.maxStorageBuffersPerShaderStage;
-          logger << "DEBUG: WebGPU adapter limits maxStorageTexturesPerShaderStage: " << adapter_limits.limits.maxStorageTexturesPerShaderStage;
-          logger << "DEBUG: WebGPU adapter limits maxUniformBuffersPerShaderStage: " << adapter_limits.limits.maxUniformBuffersPerShaderStage;
-          logger << "DEBUG: WebGPU adapter limits maxUniformBufferBindingSize: " << adapter_limits.limits.maxUniformBufferBindingSize;
-          logger << "DEBUG: WebGPU adapter limits maxStorageBufferBindingSize: " << adapter_limits.limits.maxStorageBufferBindingSize;
-          logger << "DEBUG: WebGPU adapter limits minUniformBufferOffsetAlignment: " << adapter_limits.limits.minUniformBufferOffsetAlignment;
-          logger << "DEBUG: WebGPU adapter limits minStorageBufferOffsetAlignment: " << adapter_limits.limits.minStorageBufferOffsetAlignment;
-          logger << "DEBUG: WebGPU adapter limits maxVertexBuffers: " << adapter_limits.limits.maxVertexBuffers;
-          logger << "DEBUG: WebGPU adapter limits maxBufferSize: " << adapter_limits.limits.maxBufferSize;
-          logger << "DEBUG: WebGPU adapter limits maxVertexAttributes: " << adapter_limits.limits.maxVertexAttributes;
-          logger << "DEBUG: WebGPU adapter limits maxVertexBufferArrayStride: " << adapter_limits.limits.maxVertexBufferArrayStride;
-          logger << "DEBUG: WebGPU adapter limits maxInterStageShaderComponents: " << adapter_limits.limits.maxInterStageShaderComponents;
-          logger << "DEBUG: WebGPU adapter limits maxInterStageShaderVariables: " << adapter_limits.limits.maxInterStageShaderVariables;
-          logger << "DEBUG: WebGPU adapter limits maxColorAttachments: " << adapter_limits.limits.maxColorAttachments;
-          logger << "DEBUG: WebGPU adapter limits maxColorAttachmentBytesPerSample: " << adapter_limits.limits.maxColorAttachmentBytesPerSample;
-          logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupStorageSize: " << adapter_limits.limits.maxComputeWorkgroupStorageSize;
-          logger << "DEBUG: WebGPU adapter limits maxComputeInvocationsPerWorkgroup: " << adapter_limits.limits.maxComputeInvocationsPerWorkgroup;
-          logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupSizeX: " << adapter_limits.limits.maxComputeWorkgroupSizeX;
-          logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupSizeY: " << adapter_limits.limits.maxComputeWorkgroupSizeY;
-          logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupSizeZ: " << adapter_limits.limits.maxComputeWorkgroupSizeZ;
-          logger << "DEBUG: WebGPU adapter limits maxComputeWorkgroupsPerDimension: " << adapter_limits.limits.maxComputeWorkgroupsPerDimension;
+          wgpu::FeatureName::TimestampQuery,
         #endif // NDEBUG
+        wgpu::FeatureName::TextureCompressionBC,
+        wgpu::FeatureName::IndirectFirstInstance,
+      };
+      std::set<wgpu::FeatureName> desired_features{
+        wgpu::FeatureName::ShaderF16,
+        wgpu::FeatureName::Float32Filterable,
+      };
 
-        // specify required features for the device
-        std::set<wgpu::FeatureName> required_features{
-          wgpu::FeatureName::Depth32FloatStencil8,
-          #ifndef NDEBUG
-            wgpu::FeatureName::TimestampQuery,
-          #endif // NDEBUG
-          wgpu::FeatureName::TextureCompressionBC,
-          wgpu::FeatureName::IndirectFirstInstance,
+      std::vector<wgpu::FeatureName> required_features_arr;
+      for(auto const feature : required_features) {
+        if(!adapter_features.contains(feature)) {
+          logger << "WebGPU: Required adapter feature " << magic_enum::enum_name(feature) << " unavailable, cannot continue";
+          throw std::runtime_error{"WebGPU: Required adapter feature " + std::string{magic_enum::enum_name(feature)} + " not available"};
+        }
+        logger << "WebGPU: Required adapter feature: " << magic_enum::enum_name(feature) << " requested";
+        required_features_arr.emplace_back(feature);
+      }
+      for(auto const feature : desired_features) {
+        if(!adapter_features.contains(feature)) {
+          logger << "WebGPU: Desired adapter feature " << magic_enum::enum_name(feature) << " unavailable, continuing without it";
+          continue;
+        }
+        logger << "WebGPU: Desired adapter feature " << magic_enum::enum_name(feature) << " requested";
+        required_features_arr.emplace_back(feature);
+      }
+
+      // specify required limits for the device
+      struct limit {
+        wgpu::Limits required{
+          .maxTextureDimension2D{3840},
+          .maxTextureArrayLayers{terrain_clipmap::level_count},
+          .maxBindGroups{2},
+          .maxStorageBuffersPerShaderStage{6},
+          .maxUniformBuffersPerShaderStage{2},
+          .maxUniformBufferBindingSize{16 * 4},
+          .maxVertexBuffers{2},
+          .maxBufferSize{6 * 2 * sizeof(float)},
+          .maxVertexAttributes{4},
+          .maxVertexBufferArrayStride{2 * sizeof(float)},
         };
-        std::set<wgpu::FeatureName> desired_features{
-          wgpu::FeatureName::ShaderF16,
-          wgpu::FeatureName::Float32Filterable,
+        wgpu::Limits desired{
+          .maxTextureDimension2D{8192},
         };
-
-        std::vector<wgpu::FeatureName> required_features_arr;
-        for(auto const feature : required_features) {
-          if(!adapter_features.contains(feature)) {
-            logger << "WebGPU: Required adapter feature " << magic_enum::enum_name(feature) << " unavailable, cannot continue";
-            throw std::runtime_error{"WebGPU: Required adapter feature " + std::string{magic_enum::enum_name(feature)} + " not available"};
-          }
-          logger << "WebGPU: Required adapter feature: " << magic_enum::enum_name(feature) << " requested";
-          required_features_arr.emplace_back(feature);
-        }
-        for(auto const feature : desired_features) {
-          if(!adapter_features.contains(feature)) {
-            logger << "WebGPU: Desired adapter feature " << magic_enum::enum_name(feature) << " unavailable, continuing without it";
-            continue;
+      } requested_limits;
+
+      auto require_limit{[&]<typename T>(std::string const &name, T available, T required, T desired){
+        constexpr auto undefined{std::numeric_limits<T>::max()};
+        if(required == undefined) {                                             // no hard requirement for this value
+          if(desired == undefined) {                                            //   no specific desire for this value
+            return undefined;                                                   //     we don't care about the value
+          } else {                                                              //   we have a desire for a specific value
+            if(available == undefined) {                                        //     but it's not available
+              logger << "WebGPU: Desired minimum limit for " << name << " is " << desired << " but is unavailable, ignoring";
+              return undefined;                                                 //       that's fine, we don't care
+            } else {                                                            //     some limit is available
+              logger << "WebGPU: Desired minimum limit for " << name << " is " << desired << ", requesting " << std::min(desired, available);
+              return std::min(desired, available);                              //       we'll accept our desired amount or the limit, whichever is lowest
+            }
           }
-          logger << "WebGPU: Desired adapter feature " << magic_enum::enum_name(feature) << " requested";
-          required_features_arr.emplace_back(feature);
-        }
-
-        // specify required limits for the device
-        struct limit {
-          wgpu::Limits required{
-            .maxTextureDimension2D{3840},
-            .maxTextureArrayLayers{1},
-            .maxBindGroups{2},
-            .maxUniformBuffersPerShaderStage{1},
-            .maxUniformBufferBindingSize{16 * 4},
-            .maxVertexBuffers{1},
-            .maxBufferSize{6 * 2 * sizeof(float)},
-            .maxVertexAttributes{1},
-            .maxVertexBufferArrayStride{2 * sizeof(float)},
-          };
-          wgpu::Limits desired{
-            .maxTextureDimension2D{8192},
-          };
-        } requested_limits;
-
-        auto require_limit{[&]<typename T>(std::string const &name, T available, T required, T desired){
-          constexpr auto undefined{std::numeric_limits<T>::max()};
-          if(required == undefined) {                                           // no hard requirement for this value
-            if(desired == undefined) {                                          //   no specific desire for this value
-              return undefined;                                                 //     we don't care about the value
-            } else {                                                            //   we have a desire for a specific value
-              if(available == undefined) {                                      //     but it's not available
-                logger << "WebGPU: Desired minimum limit for " << name << " is " << desired << " but is unavailable, ignoring";
-                return undefined;                                               //       that's fine, we don't care
-              } else {                                                          //     some limit is available
+        } else {                                                                // we have a hard requirement for this value
+          if(available == undefined) {                                          //   but it's not available
+            logger << "WebGPU: Required minimum limit " << required << " is not available for " << name << " (limit undefined), cannot continue";
+            throw std::runtime_error("WebGPU: Required adapter limits not met (limit undefined)");
+          } else {                                                              //   some limit is available
+            if(available < required) {                                          //     but the limit is below our requirement
+              logger << "WebGPU: Required minimum limit " << required << " is not available for " << name << " (max " << available << "), cannot continue";
+              throw std::runtime_error("WebGPU: Required adapter limits not met");
+            } else {                                                            //     the limit is acceptable
+              if(desired == undefined) {                                        //       we have no desire beyond the basic requirement
+                logger << "WebGPU: Required minimum limit for " << name << " is " << required << ", available";
+                return required;                                                //         we'll accept the required minimum
+              } else {                                                          //       we desire a value beyond the basic requirement
+                assert(desired > required);                                     //         make sure we're not requesting nonsense with desired values below required minimum
                 logger << "WebGPU: Desired minimum limit for " << name << " is " << desired << ", requesting " << std::min(desired, available);
-                return std::min(desired, available);                            //       we'll accept our desired amount or the limit, whichever is lowest
-              }
-            }
-          } else {                                                              // we have a hard requirement for this value
-            if(available == undefined) {                                        //   but it's not available
-              logger << "WebGPU: Required minimum limit " << required << " is not available for " << name << " (limit undefined), cannot continue";
-              throw std::runtime_error("WebGPU: Required adapter limits not met (limit undefined)");
-            } else {                                                            //   some limit is available
-              if(available < required) {                                        //     but the limit is below our requirement
-                logger << "WebGPU: Required minimum limit " << required << " is not available for " << name << " (max " << available << "), cannot continue";
-                throw std::runtime_error("WebGPU: Required adapter limits not met");
-              } else {                                                          //     the limit is acceptable
-                if(desired == undefined) {                                      //       we have no desire beyond the basic requirement
-                  logger << "WebGPU: Required minimum limit for " << name << " is " << required << ", available";
-                  return required;                                              //         we'll accept the required minimum
-                } else {                                                        //       we desire a value beyond the basic requirement
-                  assert(desired > required);                                   //         make sure we're not requesting nonsense with desired values below required minimum
-                  logger << "WebGPU: Desired minimum limit for " << name << " is " << desired << ", requesting " << std::min(desired, available);
-                  return std::min(desired, available);                          //         we'll accept our desired amount or the limit, whichever is lowest
-                }
+                return std::min(desired, available);                            //         we'll accept our desired amount or the limit, whichever is lowest
               }
             }
           }
-        }};
-
-        wgpu::RequiredLimits const required_limits{
-          .limits{                                                              // see https://www.w3.org/TR/webgpu/#limit-default
-            #define REQUIRE_LIMIT(limit) .limit{require_limit(#limit, adapter_limits.limits.limit, requested_limits.required.limit, requested_limits.desired.limit)}
-            REQUIRE_LIMIT(maxTextureDimension1D),
-            REQUIRE_LIMIT(maxTextureDimension2D),
-            REQUIRE_LIMIT(maxTextureDimension3D),
-            REQUIRE_LIMIT(maxTextureArrayLayers),
-            REQUIRE_LIMIT(maxBindGroups),
-            REQUIRE_LIMIT(maxBindGroupsPlusVertexBuffers),
-            REQUIRE_LIMIT(maxBindingsPerBindGroup),
-            REQUIRE_LIMIT(maxDynamicUniformBuffersPerPipelineLayout),
-            REQUIRE_LIMIT(maxDynamicStorageBuffersPerPipelineLayout),
-            REQUIRE_LIMIT(maxSampledTexturesPerShaderStage),
-            REQUIRE_LIMIT(maxSamplersPerShaderStage),
-            REQUIRE_LIMIT(maxStorageBuffersPerShaderStage),
-            REQUIRE_LIMIT(maxStorageTexturesPerShaderStage),
-            REQUIRE_LIMIT(maxUniformBuffersPerShaderStage),
-            REQUIRE_LIMIT(maxUniformBufferBindingSize),
-            REQUIRE_LIMIT(maxStorageBufferBindingSize),
-            REQUIRE_LIMIT(minUniformBufferOffsetAlignment),
-            REQUIRE_LIMIT(minStorageBufferOffsetAlignment),
-            // special treatment for minimum rather than maximum limits may be required, see notes for "alignment" at https://www.w3.org/TR/webgpu/#limit-default:
-            //.minUniformBufferOffsetAlignment{adapter_limits.limits.minUniformBufferOffsetAlignment},
-            //.minStorageBufferOffsetAlignment{adapter_limits.limits.minStorageBufferOffsetAlignment},
-            REQUIRE_LIMIT(maxVertexBuffers),
-            REQUIRE_LIMIT(maxBufferSize),
-            REQUIRE_LIMIT(maxVertexAttributes),
-            REQUIRE_LIMIT(maxVertexBufferArrayStride),
-            REQUIRE_LIMIT(maxInterStageShaderComponents),
-            REQUIRE_LIMIT(maxInterStageShaderVariables),
-            REQUIRE_LIMIT(maxColorAttachments),
-            REQUIRE_LIMIT(maxColorAttachmentBytesPerSample),
-            REQUIRE_LIMIT(maxComputeWorkgroupStorageSize),
-            REQUIRE_LIMIT(maxComputeInvocationsPerWorkgroup),
-            REQUIRE_LIMIT(maxComputeWorkgroupSizeX),
-            REQUIRE_LIMIT(maxComputeWorkgroupSizeY),
-            REQUIRE_LIMIT(maxComputeWorkgroupSizeZ),
-            REQUIRE_LIMIT(maxComputeWorkgroupsPerDimension),
-            #undef REQUIRE_LIMIT
-          },
-        };
+        }
+      }};
+
+      wgpu::RequiredLimits const required_limits{
+        .limits{                                                                // see https://www.w3.org/TR/webgpu/#limit-default
+          #define REQUIRE_LIMIT(limit) .limit{require_limit(#limit, adapter_limits.limits.limit, requested_limits.required.limit, requested_limits.desired.limit)}
+          REQUIRE_LIMIT(maxTextureDimension1D),
+          REQUIRE_LIMIT(maxTextureDimension2D),
+          REQUIRE_LIMIT(maxTextureDimension3D),
+          REQUIRE_LIMIT(maxTextureArrayLayers),
+          REQUIRE_LIMIT(maxBindGroups),
+          REQUIRE_LIMIT(maxBindGroupsPlusVertexBuffers),
+          REQUIRE_LIMIT(maxBindingsPerBindGroup),
+          REQUIRE_LIMIT(maxDynamicUniformBuffersPerPipelineLayout),
+          REQUIRE_LIMIT(maxDynamicStorageBuffersPerPipelineLayout),
+          REQUIRE_LIMIT(maxSampledTexturesPerShaderStage),
+          REQUIRE_LIMIT(maxSamplersPerShaderStage),
+          REQUIRE_LIMIT(maxStorageBuffersPerShaderStage),
+          REQUIRE_LIMIT(maxStorageTexturesPerShaderStage),
+          REQUIRE_LIMIT(maxUniformBuffersPerShaderStage),
+          REQUIRE_LIMIT(maxUniformBufferBindingSize),
+          REQUIRE_LIMIT(maxStorageBufferBindingSize),
+          REQUIRE_LIMIT(minUniformBufferOffsetAlignment),
+          REQUIRE_LIMIT(minStorageBufferOffsetAlignment),
+          // special treatment for minimum rather than maximum limits may be required, see notes for "alignment" at https://www.w3.org/TR/webgpu/#limit-default:
+          //.minUniformBufferOffsetAlignment{adapter_limits.limits.minUniformBufferOffsetAlignment},
+          //.minStorageBufferOffsetAlignment{adapter_limits.limits.minStorageBufferOffsetAlignment},
+          REQUIRE_LIMIT(maxVertexBuffers),
+          REQUIRE_LIMIT(maxBufferSize),
+          REQUIRE_LIMIT(maxVertexAttributes),
+          REQUIRE_LIMIT(maxVertexBufferArrayStride),
+          REQUIRE_LIMIT(maxInterStageShaderComponents),
+          REQUIRE_LIMIT(maxInterStageShaderVariables),
+          REQUIRE_LIMIT(maxColorAttachments),
+          REQUIRE_LIMIT(maxColorAttachmentBytesPerSample),
+          REQUIRE_LIMIT(maxComputeWorkgroupStorageSize),
+          REQUIRE_LIMIT(maxComputeInvocationsPerWorkgroup),
+          REQUIRE_LIMIT(maxComputeWorkgroupSizeX),
+          REQUIRE_LIMIT(maxComputeWorkgroupSizeY),
+          REQUIRE_LIMIT(maxComputeWorkgroupSizeZ),
+          REQUIRE_LIMIT(maxComputeWorkgroupsPerDimension),
+          #undef REQUIRE_LIMIT
+        },
+      };
 
-        // request a device
-        wgpu::DeviceDescriptor device_descriptor{
-          .requiredFeatureCount{required_features_arr.size()},
-          .requiredFeatures{required_features_arr.data()},
-          .requiredLimits{&required_limits},
-          .defaultQueue{
-            .label{"Default queue"},
-          },
-          .deviceLostCallback{[](WGPUDeviceLostReason reason_c, char const *message, void *data){
-            /// Device lost callback
-            auto &renderer{*static_cast<webgpu_renderer*>(data)};
-            auto &logger{renderer.logger};
-            logger << "ERROR: WebGPU lost device, reason " << enum_wgpu_name<wgpu::DeviceLostReason>(reason_c) << ": " << message;
-          }},
-          .deviceLostUserdata{&renderer},
-        };
+      // request a device
+      wgpu::DeviceDescriptor device_descriptor{
+        .requiredFeatureCount{required_features_arr.size()},
+        .requiredFeatures{required_features_arr.data()},
+        .requiredLimits{&required_limits},
+        .defaultQueue{
+          .label{"Default queue"},
+        },
+        .deviceLostCallback{[](WGPUDeviceLostReason reason_c, char const *message, void *data){
+          /// Device lost callback
+          auto &renderer{*static_cast<webgpu_renderer*>(data)};
+          auto &logger{renderer.logger};
+          logger << "ERROR: WebGPU lost device, reason " << enum_wgpu_name<wgpu::DeviceLostReason>(reason_c) << ": " << message;
+          if(static_cast<wgpu::DeviceLostReason>(reason_c) == wgpu::DeviceLostReason::Destroyed) return; // we destroyed it ourselves, so there's nothing to recover
+          renderer.lost_device = std::move(renderer.webgpu.device);             // kept alive until everything using it has moved to the replacement
+          renderer.webgpu.adapter = nullptr;                                    // an adapter can only provide one device, so we need a new one too
+          logger << "WebGPU: Requesting a replacement device";
+          renderer.request_adapter();
+        }},
+        .deviceLostUserdata{&renderer},
+      };
 
-        adapter.RequestDevice(
-          &device_descriptor,
-          [](WGPURequestDeviceStatus status_c, WGPUDevice device_ptr,  const char *message,  void *data){
-            /// Request device callback
-            auto &renderer{*static_cast<webgpu_renderer*>(data)};
-            auto &logger{renderer.logger};
-            auto &webgpu{renderer.webgpu};
-            if(message) logger << "WebGPU: Request device callback message: " << message;
-            if(auto status{static_cast<wgpu::RequestDeviceStatus>(status_c)}; status != wgpu::RequestDeviceStatus::Success) {
-              logger << "ERROR: WebGPU device request failure, status " << enum_wgpu_name<wgpu::RequestDeviceStatus>(status_c);
-              throw std::runtime_error{"WebGPU: Could not get adapter"};
-            }
-            auto &device{webgpu.device};
-            device = wgpu::Device::Acquire(device_ptr);
+      adapter.RequestDevice(
+        &device_descriptor,
+        [](WGPURequestDeviceStatus status_c, WGPUDevice device_ptr,  const char *message,  void *data){
+          /// Request device callback
+          auto &renderer{*static_cast<webgpu_renderer*>(data)};
+          auto &logger{renderer.logger};
+          auto &webgpu{renderer.webgpu};
+          if(message) logger << "WebGPU: Request device callback message: " << message;
+          if(auto status{static_cast<wgpu::RequestDeviceStatus>(status_c)}; status != wgpu::RequestDeviceStatus::Success) {
+            logger << "ERROR: WebGPU device request failure, status " << enum_wgpu_name<wgpu::RequestDeviceStatus>(status_c);
+            throw std::runtime_error{"WebGPU: Could not get adapter"};
+          }
+          auto &device{webgpu.device};
+          device = wgpu::Device::Acquire(device_ptr);
 
-            // report device capabilities
-            std::set<wgpu::FeatureName> device_features;
-            {
-              auto const count{device.EnumerateFeatures(nullptr)};
-              #ifndef NDEBUG
-                logger << "DEBUG: WebGPU device features count: " << count;
-              #endif // NDEBUG
-              std::vector<wgpu::FeatureName> device_features_arr(count);
-              device.EnumerateFeatures(device_features_arr.data());
-              for(unsigned int i{0}; i != device_features_arr.size(); ++i) {
-                device_features.emplace(device_features_arr[i]);
-              }
-            }
-            for(auto const feature : device_features) {
-              logger << "DEBUG: WebGPU device features: " << magic_enum::enum_name(feature);
-            }
+          // report device capabilities
+          std::set<wgpu::FeatureName> device_features;
+          {
+            auto const count{device.EnumerateFeatures(nullptr)};
             #ifndef NDEBUG
-              {
-                wgpu::SupportedLimits adapter_limits;
-                bool result{device.GetLimits(&adapter_limits)};
-                logger << "DEBUG: WebGPU device limits result: " << std::boolalpha << result;
-                logger << "DEBUG: WebGPU device limits nextInChain: " << adapter_limits.nextInChain;
-                logger << "DEBUG: WebGPU device limits maxTextureDimension1D: " << adapter_limits.limits.maxTextureDimension1D;
-                logger << "DEBUG: WebGPU device limits maxTextureDimension2D: " << adapter_limits.limits.maxTextureDimension2D;
-                logger << "DEBUG: WebGPU device limits maxTextureDimension3D: " << adapter_limits.limits.maxTextureDimension3D;
-                logger << "DEBUG: WebGPU device limits maxTextureArrayLayers: " << adapter_limits.limits.maxTextureArrayLayers;
-                logger << "DEBUG: WebGPU device limits maxBindGroups: " << adapter_limits.limits.maxBindGroups;
-                logger << "DEBUG: WebGPU device limits maxBindGroupsPlusVertexBuffers: " << adapter_limits.limits.maxBindGroupsPlusVertexBuffers;
-                logger << "DEBUG: WebGPU device limits maxBindingsPerBindGroup: " << adapter_limits.limits.maxBindingsPerBindGroup;
-                logger << "DEBUG: WebGPU device limits maxDynamicUniformBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicUniformBuffersPerPipelineLayout;
-                logger << "DEBUG: WebGPU device limits maxDynamicStorageBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicStorageBuffersPerPipelineLayout;
-                logger << "DEBUG: WebGPU device limits maxSamplersPerShaderStage: " << adapter_limits.limits.maxSamplersPerShaderStage;
-                logger << "DEBUG: WebGPU device limits maxStorageBuffersPerShaderStage: " << adapter_limits.limits.maxStorageBuffersPerShaderStage;
-                logger << "DEBUG: WebGPU device limits maxStorageTexturesPerShaderStage: " << adapter_limits.limits.maxStorageTexturesPerShaderStage;
-                logger << "DEBUG: WebGPU device limits maxUniformBuffersPerShaderStage: " << adapter_limits.limits.maxUniformBuffersPerShaderStage;
-                logger << "DEBUG: WebGPU device limits maxUniformBufferBindingSize: " << adapter_limits.limits.maxUniformBufferBindingSize;
-                logger << "DEBUG: WebGPU device limits maxStorageBufferBindingSize: " << adapter_limits.limits.maxStorageBufferBindingSize;
-                logger << "DEBUG: WebGPU device limits minUniformBufferOffsetAlignment: " << adapter_limits.limits.minUniformBufferOffsetAlignment;
-                logger << "DEBUG: WebGPU device limits minStorageBufferOffsetAlignment: " << adapter_limits.limits.minStorageBufferOffsetAlignment;
-                logger << "DEBUG: WebGPU device limits maxVertexBuffers: " << adapter_limits.limits.maxVertexBuffers;
-                logger << "DEBUG: WebGPU device limits maxBufferSize: " << adapter_limits.limits.maxBufferSize;
-                logger << "DEBUG: WebGPU device limits maxVertexAttributes: " << adapter_limits.limits.maxVertexAttributes;
-                logger << "DEBUG: WebGPU device limits maxVertexBufferArrayStride: " << adapter_limits.limits.maxVertexBufferArrayStride;
-                logger << "DEBUG: WebGPU device limits maxInterStageShaderComponents: " << adapter_limits.limits.maxInterStageShaderComponents;
-                logger << "DEBUG: WebGPU device limits maxInterStageShaderVariables: " << adapter_limits.limits.maxInterStageShaderVariables;
-                logger << "DEBUG: WebGPU device limits maxColorAttachments: " << adapter_limits.limits.maxColorAttachments;
-                logger << "DEBUG: WebGPU device limits maxColorAttachmentBytesPerSample: " << adapter_limits.limits.maxColorAttachmentBytesPerSample;
-                logger << "DEBUG: WebGPU device limits maxComputeWorkgroupStorageSize: " << adapter_limits.limits.maxComputeWorkgroupStorageSize;
-                logger << "DEBUG: WebGPU device limits maxComputeInvocationsPerWorkgroup: " << adapter_limits.limits.maxComputeInvocationsPerWorkgroup;
-                logger << "DEBUG: WebGPU device limits maxComputeWorkgroupSizeX: " << adapter_limits.limits.maxComputeWorkgroupSizeX;
-                logger << "DEBUG: WebGPU device limits maxComputeWorkgroupSizeY: " << adapter_limits.limits.maxComputeWorkgroupSizeY;
-                logger << "DEBUG: WebGPU device limits maxComputeWorkgroupSizeZ: " << adapter_limits.limits.maxComputeWorkgroupSizeZ;
-                logger << "DEBUG: WebGPU device limits maxComputeWorkgroupsPerDimension: " << adapter_limits.limits.maxComputeWorkgroupsPerDimension;
-              }
+              logger << "DEBUG: WebGPU device features count: " << count;
             #endif // NDEBUG
+            std::vector<wgpu::FeatureName> device_features_arr(count);
+            device.EnumerateFeatures(device_features_arr.data());
+            for(unsigned int i{0}; i != device_features_arr.size(); ++i) {
+              device_features.emplace(device_features_arr[i]);
+            }
+          }
+          for(auto const feature : device_features) {
+            logger << "DEBUG: WebGPU device features: " << magic_enum::enum_name(feature);
+          }
+          #ifndef NDEBUG
+            {
+              wgpu::SupportedLimits adapter_limits;
+              bool result{device.GetLimits(&adapter_limits)};
+              logger << "DEBUG: WebGPU device limits result: " << std::boolalpha << result;
+              logger << "DEBUG: WebGPU device limits nextInChain: " << adapter_limits.nextInChain;
+              logger << "DEBUG: WebGPU device limits maxTextureDimension1D: " << adapter_limits.limits.maxTextureDimension1D;
+              logger << "DEBUG: WebGPU device limits maxTextureDimension2D: " << adapter_limits.limits.maxTextureDimension2D;
+              logger << "DEBUG: WebGPU device limits maxTextureDimension3D: " << adapter_limits.limits.maxTextureDimension3D;
+              logger << "DEBUG: WebGPU device limits maxTextureArrayLayers: " << adapter_limits.limits.maxTextureArrayLayers;
+              logger << "DEBUG: WebGPU device limits maxBindGroups: " << adapter_limits.limits.maxBindGroups;
+              logger << "DEBUG: WebGPU device limits maxBindGroupsPlusVertexBuffers: " << adapter_limits.limits.maxBindGroupsPlusVertexBuffers;
+              logger << "DEBUG: WebGPU device limits maxBindingsPerBindGroup: " << adapter_limits.limits.maxBindingsPerBindGroup;
+              logger << "DEBUG: WebGPU device limits maxDynamicUniformBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicUniformBuffersPerPipelineLayout;
+              logger << "DEBUG: WebGPU device limits maxDynamicStorageBuffersPerPipelineLayout: " << adapter_limits.limits.maxDynamicStorageBuffersPerPipelineLayout;
+              logger << "DEBUG: WebGPU device limits maxSamplersPerShaderStage: " << adapter_limits.limits.maxSamplersPerShaderStage;
+              logger << "DEBUG: WebGPU device limits maxStorageBuffersPerShaderStage: " << adapter_limits.limits.maxStorageBuffersPerShaderStage;
+              logger << "DEBUG: WebGPU device limits maxStorageTexturesPerShaderStage: " << adapter_limits.limits.maxStorageTexturesPerShaderStage;
+              logger << "DEBUG: WebGPU device limits maxUniformBuffersPerShaderStage: " << adapter_limits.limits.maxUniformBuffersPerShaderStage;
+              logger << "DEBUG: WebGPU device limits maxUniformBufferBindingSize: " << adapter_limits.limits.maxUniformBufferBindingSize;
+              logger << "DEBUG: WebGPU device limits maxStorageBufferBindingSize: " << adapter_limits.limits.maxStorageBufferBindingSize;
+              logger << "DEBUG: WebGPU device limits minUniformBufferOffsetAlignment: " << adapter_limits.limits.minUniformBufferOffsetAlignment;
+              logger << "DEBUG: WebGPU device limits minStorageBufferOffsetAlignment: " << adapter_limits.limits.minStorageBufferOffsetAlignment;
+              logger << "DEBUG: WebGPU device limits maxVertexBuffers: " << adapter_limits.limits.maxVertexBuffers;
+              logger << "DEBUG: WebGPU device limits maxBufferSize: " << adapter_limits.limits.maxBufferSize;
+              logger << "DEBUG: WebGPU device limits maxVertexAttributes: " << adapter_limits.limits.maxVertexAttributes;
+              logger << "DEBUG: WebGPU device limits maxVertexBufferArrayStride: " << adapter_limits.limits.maxVertexBufferArrayStride;
+              logger << "DEBUG: WebGPU device limits maxInterStageShaderComponents: " << adapter_limits.limits.maxInterStageShaderComponents;
+              logger << "DEBUG: WebGPU device limits maxInterStageShaderVariables: " << adapter_limits.limits.maxInterStageShaderVariables;
+              logger << "DEBUG: WebGPU device limits maxColorAttachments: " << adapter_limits.limits.maxColorAttachments;
+              logger << "DEBUG: WebGPU device limits maxColorAttachmentBytesPerSample: " << adapter_limits.limits.maxColorAttachmentBytesPerSample;
+              logger << "DEBUG: WebGPU device limits maxComputeWorkgroupStorageSize: " << adapter_limits.limits.maxComputeWorkgroupStorageSize;
+              logger << "DEBUG: WebGPU device limits maxComputeInvocationsPerWorkgroup: " << adapter_limits.limits.maxComputeInvocationsPerWorkgroup;
+              logger << "DEBUG: WebGPU device limits maxComputeWorkgroupSizeX: " << adapter_limits.limits.maxComputeWorkgroupSizeX;
+              logger << "DEBUG: WebGPU device limits maxComputeWorkgroupSizeY: " << adapter_limits.limits.maxComputeWorkgroupSizeY;
+              logger << "DEBUG: WebGPU device limits maxComputeWorkgroupSizeZ: " << adapter_limits.limits.maxComputeWorkgroupSizeZ;
+              logger << "DEBUG: WebGPU device limits maxComputeWorkgroupsPerDimension: " << adapter_limits.limits.maxComputeWorkgroupsPerDimension;
+            }
+          #endif // NDEBUG
 
-            device.SetUncapturedErrorCallback(
-              [](WGPUErrorType type, char const *message, void *data){
-                /// Uncaptured error callback
-                auto &renderer{*static_cast<webgpu_renderer*>(data)};
-                auto &logger{renderer.logger};
-                logger << "ERROR: WebGPU uncaptured error " << enum_wgpu_name<wgpu::ErrorType>(type) << ": " << message;
-              },
-              &renderer
-            );
-          },
-          data
-        );
-      },
-      this
-    );
-  }
-
-  emscripten_set_main_loop_arg([](void *data){
-    /// Dispatch the loop waiting for WebGPU to become ready
-    auto &renderer{*static_cast<webgpu_renderer*>(data)};
-    renderer.wait_to_configure_loop();
-  }, this, 0, true);                                                            // loop function, user data, FPS (0 to use browser requestAnimationFrame mechanism), simulate infinite loop
-  std::unreachable();
+          device.SetUncapturedErrorCallback(
+            [](WGPUErrorType type, char const *message, void *data){
+              /// Uncaptured error callback
+              auto &renderer{*static_cast<webgpu_renderer*>(data)};
+              renderer.errors.record_uncaptured(static_cast<wgpu::ErrorType>(type), message);
+            },
+            &renderer
+          );
+        },
+        data
+      );
+    },
+    this
+  );
 }
 
 void webgpu_renderer::init_swapchain() {
@@ -506,35 +530,165 @@ void webgpu_renderer::init_swapchain() {
   webgpu.swapchain = webgpu.device.CreateSwapChain(webgpu.surface, &swapchain_descriptor);
 }
 
-void webgpu_renderer::init_depth_texture() {
-  /// Create or recreate the depth buffer and its texture view
-  {
-    wgpu::TextureDescriptor depth_texture_descriptor{
-      .label{"Depth texture 1"},
-      .usage{wgpu::TextureUsage::RenderAttachment},
-      .dimension{wgpu::TextureDimension::e2D},
-      .size{
-        window.viewport_size.x,
-        window.viewport_size.y,
-        1
-      },
-      .format{webgpu.depth_texture_format},
-      .viewFormatCount{1},
-      .viewFormats{&webgpu.depth_texture_format},
-    };
-    webgpu.depth_texture = webgpu.device.CreateTexture(&depth_texture_descriptor);
+void webgpu_renderer::init_gui_texture() {
+  /// Take the cached GUI layer texture for the current viewport size from the pool, returning any previous one, and create the bind group used to composite it
+  auto const error_scope{errors.capture("GUI texture")};
+  gui_layer.valid = false;                                                      // any new texture needs the GUI redrawing into it
+  if(webgpu.gui_texture_view) textures.release(webgpu.gui_texture_view);        // kept pooled for a while, in case the viewport returns to this size
+  if(!gui_layer.enabled) {
+    webgpu.gui_composite_bind_group = nullptr;
+    webgpu.gui_texture_view = nullptr;
+    return;
   }
+  webgpu.gui_texture_view = textures.acquire({
+    .format{webgpu.surface_preferred_format},
+    .size{window.viewport_size},
+    .usage{wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding},
+  }, "GUI texture 1", memory_tracker::category::gui);
   {
-    wgpu::TextureViewDescriptor depth_texture_view_descriptor{
-      .label{"Depth texture view 1"},
-      .format{webgpu.depth_texture_format},
-      .dimension{wgpu::TextureViewDimension::e2D},
-      .mipLevelCount{1},
-      .arrayLayerCount{1},
-      .aspect{wgpu::TextureAspect::DepthOnly},
+    wgpu::BindGroupEntry bind_group_entry{
+      .binding{0},
+      .textureView{webgpu.gui_texture_view},
     };
-    webgpu.depth_texture_view = webgpu.depth_texture.CreateView(&depth_texture_view_descriptor);
+    wgpu::BindGroupDescriptor bind_group_descriptor{
+      .label{"GUI composite bind group 1"},
+      .layout{webgpu.gui_composite_bind_group_layout},
+      .entryCount{1},
+      .entries{&bind_group_entry},
+    };
+    webgpu.gui_composite_bind_group = webgpu.device.CreateBindGroup(&bind_group_descriptor);
+  }
+}
+
+void webgpu_renderer::init_scene() {
+  /// Create the buffers holding the scene, which stay the same from frame to frame apart from the uniforms
+  // test geometry
+  std::vector<vertex> vertex_data{
+    {{-1.0f, -1.0f, -1.0f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // bottom face normal & colour
+    {{+1.0f, -1.0f, -1.0f}, {+1.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // right face normal & colour
+    {{+1.0f, +1.0f, -1.0f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // front face normal & colour
+    {{-1.0f, +1.0f, -1.0f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // left face normal & colour
+    {{-1.0f, -1.0f, +1.0f}, { 0.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // normal & colour not used
+    {{+1.0f, -1.0f, +1.0f}, { 0.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // normal & colour not used
+    {{+1.0f, +1.0f, +1.0f}, { 0.0f, +1.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // top face normal & colour
+    {{-1.0f, +1.0f, +1.0f}, { 0.0f,  0.0f, +1.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // back face normal & colour
+  };
+  std::vector<triangle_index> index_data{
+    {0, 1, 5}, {0, 5, 4},                                                       // bottom face (y = -1)
+    {1, 6, 5}, {1, 2, 6},                                                       // right face (x = +1)
+    {2, 1, 0}, {2, 0, 3},                                                       // front face (z = -1)
+    {3, 0, 4}, {3, 4, 7},                                                       // left face (x = -1)
+    {6, 3, 7}, {6, 2, 3},                                                       // top face (y = +1)
+    {7, 4, 5}, {7, 5, 6},                                                       // back face (z = +1)
+  };
+
+  // vertex buffer
+  wgpu::BufferDescriptor vertex_buffer_descriptor{
+    .label{"Vertex buffer 1"},
+    .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Storage}, // also read as storage when vertex pulling
+    .size{vertex_data.size() * sizeof(vertex_data[0])},
+  };
+  scene.vertex_buffer = memory.create_buffer(webgpu.device, vertex_buffer_descriptor, memory_tracker::category::mesh);
+  webgpu.queue.WriteBuffer(
+    scene.vertex_buffer,                                                        // buffer
+    0,                                                                          // offset
+    vertex_data.data(),                                                         // data
+    vertex_data.size() * sizeof(vertex_data[0])                                 // size
+  );
+
+  // index buffer
+  wgpu::BufferDescriptor index_buffer_descriptor{
+    .label{"Index buffer 1"},
+    .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Index | wgpu::BufferUsage::Storage},
+    .size{index_data.size() * sizeof(index_data[0])},
+  };
+  scene.index_buffer = memory.create_buffer(webgpu.device, index_buffer_descriptor, memory_tracker::category::mesh);
+  webgpu.queue.WriteBuffer(
+    scene.index_buffer,                                                         // buffer
+    0,                                                                          // offset
+    index_data.data(),                                                          // data
+    index_data.size() * sizeof(index_data[0])                                   // size
+  );
+  scene.index_count = static_cast<uint32_t>(index_data.size() * decltype(index_data)::value_type::size());
+
+  meshlets.set_geometry(meshlet_builder::build(vertex_data, index_data), scene.vertex_buffer);
+
+  init_scene_instances();
+
+  // uniform buffer, written each frame where it changes
+  scene_uniforms.init(webgpu.device, "Uniform buffer 1", sizeof(uniforms));
+
+  // uniform bind group
+  wgpu::BindGroupEntry bind_group_entry{
+    .binding{0},
+    .buffer{scene_uniforms.get_buffer()},
+    .size{sizeof(uniforms)},
+  };
+  wgpu::BindGroupDescriptor bind_group_descriptor{
+    .label{"Bind group 1"},
+    .layout{webgpu.bind_group_layout},
+    .entryCount{1},                                                             // must correspond to layout
+    .entries{&bind_group_entry},
+  };
+  scene.bind_group = webgpu.device.CreateBindGroup(&bind_group_descriptor);
+}
+
+void webgpu_renderer::init_scene_instances() {
+  /// Create the buffer of per-instance offsets, laying instances out in a cubic grid centred on the origin
+  std::vector<vec3f> offsets;
+  offsets.reserve(scene.instance_count);
+  auto const grid_size{static_cast<unsigned int>(std::ceil(std::cbrt(static_cast<float>(scene.instance_count))))};
+  constexpr float spacing{3.0f};
+  vec3f const origin{vec3f{1.0f, 1.0f, 1.0f} * (static_cast<float>(grid_size - 1) * spacing * -0.5f)};
+  for(unsigned int i{0}; i != scene.instance_count; ++i) {
+    offsets.emplace_back(origin + vec3f{
+      static_cast<float>(i % grid_size),
+      static_cast<float>(i / grid_size % grid_size),
+      static_cast<float>(i / (grid_size * grid_size))
+    } * spacing);
   }
+
+  memory.destroy(scene.instance_buffer);
+  wgpu::BufferDescriptor instance_buffer_descriptor{
+    .label{"Instance buffer 1"},
+    .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Storage},
+    .size{offsets.size() * sizeof(offsets[0])},
+  };
+  scene.instance_buffer = memory.create_buffer(webgpu.device, instance_buffer_descriptor, memory_tracker::category::mesh);
+  webgpu.queue.WriteBuffer(
+    scene.instance_buffer,                                                      // buffer
+    0,                                                                          // offset
+    offsets.data(),                                                             // data
+    offsets.size() * sizeof(offsets[0])                                         // size
+  );
+
+  // storage bind group for vertex pulling, which refers to the instance buffer so must follow it
+  std::array pulled_bind_group_entries{
+    wgpu::BindGroupEntry{
+      .binding{0},
+      .buffer{scene.vertex_buffer},
+      .size{scene.vertex_buffer.GetSize()},
+    },
+    wgpu::BindGroupEntry{
+      .binding{1},
+      .buffer{scene.index_buffer},
+      .size{scene.index_buffer.GetSize()},
+    },
+    wgpu::BindGroupEntry{
+      .binding{2},
+      .buffer{scene.instance_buffer},
+      .size{scene.instance_buffer.GetSize()},
+    },
+  };
+  wgpu::BindGroupDescriptor pulled_bind_group_descriptor{
+    .label{"Vertex pulling bind group 1"},
+    .layout{webgpu.pulled_bind_group_layout},
+    .entryCount{pulled_bind_group_entries.size()},
+    .entries{pulled_bind_group_entries.data()},
+  };
+  scene.pulled_bind_group = webgpu.device.CreateBindGroup(&pulled_bind_group_descriptor);
+
+  meshlets.set_instances(scene.instance_buffer, scene.instance_count);
 }
 
 void webgpu_renderer::wait_to_configure_loop() {
@@ -545,10 +699,16 @@ void webgpu_renderer::wait_to_configure_loop() {
     // TODO: sensible timeout
     return;
   }
+  if(!configured) {
+    configure();
+    configured = true;
+  }
+  if(pipelines.is_warming_up()) {
+    if(emscripten_get_now() < warm_up_deadline) return;                         // keep loading until pipelines used last session are ready
+    logger << "WebGPU: Pipeline warm-up still incomplete after " << warm_up_timeout_ms << "ms, continuing in the background";
+  }
   emscripten_cancel_main_loop();
 
-  configure();
-
   if(postinit_callback) {
     logger << "WebGPU: Configuration complete, running post-init tasks";
     postinit_callback(webgpu);                                                  // perform any user-provided post-init tasks before launching the main loop
@@ -566,7 +726,10 @@ void webgpu_renderer::wait_to_configure_loop() {
 void webgpu_renderer::configure() {
   /// When the device is ready, configure the WebGPU system
   logger << "WebGPU device ready, configuring surface";
+  errors.init(webgpu.device);
+  memory.clear();                                                               // anything previously accounted for was on a lost device
   {
+    auto const error_scope{errors.capture("Surface configuration")};
     wgpu::SurfaceConfiguration surface_configuration{
       .device{webgpu.device},
       .format{webgpu.surface_preferred_format},
@@ -585,79 +748,32 @@ void webgpu_renderer::configure() {
 
   logger << "WebGPU assembling shaders";
   {
+    auto const error_scope{errors.capture("Shader modules")};
     wgpu::ShaderModuleWGSLDescriptor shader_module_wgsl_decriptor;
-    shader_module_wgsl_decriptor.code = render::shaders::default_wgsl;
+    shader_module_wgsl_decriptor.code = embedded::get("render/shaders/default.wgsl").c_str();
     wgpu::ShaderModuleDescriptor shader_module_descriptor{
       .nextInChain{&shader_module_wgsl_decriptor},
       .label{"Shader module 1"},
     };
-    wgpu::ShaderModule shader_module{webgpu.device.CreateShaderModule(&shader_module_descriptor)};
-
-    logger << "WebGPU configuring pipeline";
-
-    std::array vertex_attributes{
-      wgpu::VertexAttribute{
-        .format{wgpu::VertexFormat::Float32x3},
-        .offset{offsetof(vertex, position)},
-        .shaderLocation{0},
-      },
-      wgpu::VertexAttribute{
-        .format{wgpu::VertexFormat::Float32x3},
-        .offset{offsetof(vertex, normal)},
-        .shaderLocation{1},
-      },
-      wgpu::VertexAttribute{
-        .format{wgpu::VertexFormat::Float32x4},
-        .offset{offsetof(vertex, colour)},
-        .shaderLocation{2},
-      },
-    };
-    wgpu::VertexBufferLayout vertex_buffer_layout{
-      .arrayStride{sizeof(vertex)},
-      .attributeCount{vertex_attributes.size()},
-      .attributes{vertex_attributes.data()},
-    };
-
-    wgpu::BlendState blend_state{
-      .color{                                                                   // BlendComponent
-        .operation{wgpu::BlendOperation::Add},                                  // initial values from https://eliemichel.github.io/LearnWebGPU/basic-3d-rendering/hello-triangle.html
-        .srcFactor{wgpu::BlendFactor::SrcAlpha},
-        .dstFactor{wgpu::BlendFactor::OneMinusSrcAlpha},
-      },
-      .alpha{                                                                   // BlendComponent
-        .operation{wgpu::BlendOperation::Add},                                  // these differ from defaults
-        .srcFactor{wgpu::BlendFactor::Zero},
-        .dstFactor{wgpu::BlendFactor::One},
-        // TODO: compare with defaults
-      },
-    };
-    wgpu::ColorTargetState colour_target_state{
-      .format{webgpu.surface_preferred_format},
-      .blend{&blend_state},
-    };
-    wgpu::FragmentState fragment_state{
-      .module{shader_module},
-      .entryPoint{"fs_main"},
-      .constantCount{0},
-      .constants{nullptr},
-      .targetCount{1},
-      .targets{&colour_target_state},
-    };
-
-    wgpu::DepthStencilState depth_stencil_state{
-      .format{wgpu::TextureFormat::Depth24Plus},
-      .depthWriteEnabled{true},
-      .depthCompare{wgpu::CompareFunction::Less},
-      .stencilFront{},                                                          // StencilFaceState
-      .stencilBack{},                                                           // StencilFaceState
-      .stencilReadMask{0},
-      .stencilWriteMask{0},
-      // TODO: tweak depth bias settings
+    webgpu.shader_module = webgpu.device.CreateShaderModule(&shader_module_descriptor);
+  }
+  {
+    auto const error_scope{errors.capture("Shader modules")};
+    wgpu::ShaderModuleWGSLDescriptor shader_module_wgsl_decriptor;
+    shader_module_wgsl_decriptor.code = embedded::get("render/shaders/gui_composite.wgsl").c_str();
+    wgpu::ShaderModuleDescriptor shader_module_descriptor{
+      .nextInChain{&shader_module_wgsl_decriptor},
+      .label{"GUI composite shader module 1"},
     };
+    webgpu.gui_composite_shader_module = webgpu.device.CreateShaderModule(&shader_module_descriptor);
+  }
 
+  logger << "WebGPU configuring bind group layouts";
+  {
+    auto const error_scope{errors.capture("Bind group layouts")};
     wgpu::BindGroupLayoutEntry binding_layout{
       .binding{0},                                                              // binding index as used in the @binding attribute in the shader
-      .visibility{wgpu::ShaderStage::Vertex},
+      .visibility{wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Compute},      // meshlet culling reads the transforms too
       .buffer{                                                                  // BufferBindingLayout
         .type{wgpu::BufferBindingType::Uniform},
         .minBindingSize{sizeof(uniforms)},
@@ -672,37 +788,87 @@ void webgpu_renderer::configure() {
       .entries{&binding_layout},
     };
     webgpu.bind_group_layout = webgpu.device.CreateBindGroupLayout(&bind_group_layout_descriptor);
-
-    wgpu::PipelineLayoutDescriptor pipeline_layout_descriptor{
-      .label{"Pipeline layout 1"},
-      .bindGroupLayoutCount{1},
-      .bindGroupLayouts{&webgpu.bind_group_layout},
+  }
+  {
+    auto const error_scope{errors.capture("Bind group layouts")};
+    auto const storage_binding_layout{[](uint32_t binding){
+      return wgpu::BindGroupLayoutEntry{
+        .binding{binding},
+        .visibility{wgpu::ShaderStage::Vertex},
+        .buffer{                                                                // BufferBindingLayout
+          .type{wgpu::BufferBindingType::ReadOnlyStorage},
+        },
+      };
+    }};
+    std::array binding_layouts{
+      storage_binding_layout(0),                                                // vertices
+      storage_binding_layout(1),                                                // indices
+      storage_binding_layout(2),                                                // instance offsets
     };
-    wgpu::PipelineLayout pipeline_layout{webgpu.device.CreatePipelineLayout(&pipeline_layout_descriptor)};
-
-    wgpu::RenderPipelineDescriptor render_pipeline_descriptor{
-      .label{"Render pipeline 1"},
-      .layout{std::move(pipeline_layout)},
-      .vertex{                                                                  // VertexState
-        .module{shader_module},
-        .entryPoint{"vs_main"},
-        .constantCount{0},
-        .constants{nullptr},
-        .bufferCount{1},
-        .buffers{&vertex_buffer_layout},
-      },
-      .primitive{                                                               // PrimitiveState
-        .cullMode{wgpu::CullMode::Back},
+    wgpu::BindGroupLayoutDescriptor bind_group_layout_descriptor{
+      .label{"Vertex pulling bind group layout 1"},
+      .entryCount{binding_layouts.size()},
+      .entries{binding_layouts.data()},
+    };
+    webgpu.pulled_bind_group_layout = webgpu.device.CreateBindGroupLayout(&bind_group_layout_descriptor);
+  }
+  {
+    auto const error_scope{errors.capture("Bind group layouts")};
+    wgpu::BindGroupLayoutEntry binding_layout{
+      .binding{0},
+      .visibility{wgpu::ShaderStage::Fragment},
+      .buffer{},                                                                // BufferBindingLayout
+      .sampler{},                                                               // SamplerBindingLayout
+      .texture{                                                                 // TextureBindingLayout
+        .sampleType{wgpu::TextureSampleType::Float},
+        .viewDimension{wgpu::TextureViewDimension::e2D},
       },
-      .depthStencil{&depth_stencil_state},
-      .multisample{},
-      .fragment{&fragment_state},
+      .storageTexture{},                                                        // StorageTextureBindingLayout
+    };
+    wgpu::BindGroupLayoutDescriptor bind_group_layout_descriptor{
+      .label{"GUI composite bind group layout 1"},
+      .entryCount{1},
+      .entries{&binding_layout},
     };
-    webgpu.pipeline = webgpu.device.CreateRenderPipeline(&render_pipeline_descriptor);
+    webgpu.gui_composite_bind_group_layout = webgpu.device.CreateBindGroupLayout(&bind_group_layout_descriptor);
+  }
+
+  logger << "WebGPU initialising meshlet culling";
+  {
+    auto const error_scope{errors.capture("Meshlet culling init")};
+    meshlets.init(webgpu.device, webgpu.queue, webgpu.bind_group_layout);
+  }
+
+  logger << "WebGPU initialising terrain";
+  {
+    auto const error_scope{errors.capture("Terrain init")};
+    terrain.init(webgpu.device, webgpu.queue, webgpu.bind_group_layout);
+  }
+
+  logger << "WebGPU creating scene buffers";
+  {
+    auto const error_scope{errors.capture("Scene buffers")};
+    init_scene();
+  }
+
+  logger << "WebGPU initialising post-processing";
+  {
+    auto const error_scope{errors.capture("Post-process init")};
+    post.init(webgpu.device, webgpu.queue);
   }
 
-  logger << "WebGPU creating depth texture";
-  init_depth_texture();
+  logger << "WebGPU warming up pipelines";
+  pipelines.init(webgpu.device, [this](pipeline_key const &key, pipeline_cache::create_function const &create){
+    describe_pipeline(key, create);
+  });
+  pipelines.warm_up();
+  warm_up_deadline = emscripten_get_now() + warm_up_timeout_ms;
+
+  logger << "WebGPU creating texture pool";
+  textures.init(webgpu.device);
+
+  logger << "WebGPU creating GUI texture";
+  init_gui_texture();
 
   emscripten_set_resize_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, this, false,   // target, userdata, use_capture, callback
     ([](int /*event_type*/, EmscriptenUiEvent const *event, void *data) {       // event_type == EMSCRIPTEN_EVENT_RESIZE
@@ -711,156 +877,602 @@ void webgpu_renderer::configure() {
       renderer.window.viewport_size.y = static_cast<unsigned int>(event->windowInnerHeight);
 
       renderer.init_swapchain();
-      renderer.init_depth_texture();
+      renderer.init_gui_texture();
       return true;                                                              // the event was consumed
     })
   );
 }
 
-void webgpu_renderer::draw(vec2f const& rotation) {
-  /// Draw a frame
-  wgpu::TextureView texture_view{webgpu.swapchain.GetCurrentTextureView()};
-  if(!texture_view) throw std::runtime_error{"Could not get current texture view from swap chain"};
+void webgpu_renderer::describe_pipeline(pipeline_key const &key, pipeline_cache::create_function const &create) const {
+  /// Describe the render pipeline for one permutation, and pass the descriptor on to be created
+  switch(key.type) {
+  case pipeline_type::scene:
+    {
+      std::array vertex_attributes{
+        wgpu::VertexAttribute{
+          .format{wgpu::VertexFormat::Float32x3},
+          .offset{offsetof(vertex, position)},
+          .shaderLocation{0},
+        },
+        wgpu::VertexAttribute{
+          .format{wgpu::VertexFormat::Float32x3},
+          .offset{offsetof(vertex, normal)},
+          .shaderLocation{1},
+        },
+        wgpu::VertexAttribute{
+          .format{wgpu::VertexFormat::Float32x4},
+          .offset{offsetof(vertex, colour)},
+          .shaderLocation{2},
+        },
+      };
+      wgpu::VertexAttribute instance_attribute{
+        .format{wgpu::VertexFormat::Float32x3},
+        .offset{0},
+        .shaderLocation{3},
+      };
+      std::array vertex_buffer_layouts{
+        wgpu::VertexBufferLayout{
+          .arrayStride{sizeof(vertex)},
+          .attributeCount{vertex_attributes.size()},
+          .attributes{vertex_attributes.data()},
+        },
+        wgpu::VertexBufferLayout{                                               // per-instance offsets
+          .arrayStride{sizeof(vec3f)},
+          .stepMode{wgpu::VertexStepMode::Instance},
+          .attributeCount{1},
+          .attributes{&instance_attribute},
+        },
+      };
 
-  {
-    wgpu::CommandEncoderDescriptor command_encoder_descriptor{
-      .label = "Command encoder 1"
-    };
-    wgpu::CommandEncoder command_encoder{webgpu.device.CreateCommandEncoder(&command_encoder_descriptor)};
+      wgpu::BlendState blend_state{
+        .color{                                                                 // BlendComponent
+          .operation{wgpu::BlendOperation::Add},                                // initial values from https://eliemichel.github.io/LearnWebGPU/basic-3d-rendering/hello-triangle.html
+          .srcFactor{wgpu::BlendFactor::SrcAlpha},
+          .dstFactor{wgpu::BlendFactor::OneMinusSrcAlpha},
+        },
+        .alpha{                                                                 // BlendComponent
+          .operation{wgpu::BlendOperation::Add},                                // these differ from defaults
+          .srcFactor{wgpu::BlendFactor::Zero},
+          .dstFactor{wgpu::BlendFactor::One},
+          // TODO: compare with defaults
+        },
+      };
+      wgpu::ColorTargetState colour_target_state{
+        .format{key.colour_format},
+        .blend{&blend_state},
+      };
+      wgpu::FragmentState fragment_state{
+        .module{webgpu.shader_module},
+        .entryPoint{"fs_main"},
+        .constantCount{0},
+        .constants{nullptr},
+        .targetCount{1},
+        .targets{&colour_target_state},
+      };
+
+      wgpu::DepthStencilState depth_stencil_state{
+        .format{key.depth_format},
+        .depthWriteEnabled{true},
+        .depthCompare{wgpu::CompareFunction::Less},
+        .stencilFront{},                                                        // StencilFaceState
+        .stencilBack{},                                                         // StencilFaceState
+        .stencilReadMask{0},
+        .stencilWriteMask{0},
+        // TODO: tweak depth bias settings
+      };
+
+      wgpu::PipelineLayoutDescriptor pipeline_layout_descriptor{
+        .label{"Pipeline layout 1"},
+        .bindGroupLayoutCount{1},
+        .bindGroupLayouts{&webgpu.bind_group_layout},
+      };
 
+      wgpu::RenderPipelineDescriptor render_pipeline_descriptor{
+        .label{"Render pipeline 1"},
+        .layout{webgpu.device.CreatePipelineLayout(&pipeline_layout_descriptor)},
+        .vertex{                                                                // VertexState
+          .module{webgpu.shader_module},
+          .entryPoint{"vs_main"},
+          .constantCount{0},
+          .constants{nullptr},
+          .bufferCount{vertex_buffer_layouts.size()},
+          .buffers{vertex_buffer_layouts.data()},
+        },
+        .primitive{                                                             // PrimitiveState
+          .cullMode{wgpu::CullMode::Back},
+        },
+        .depthStencil{&depth_stencil_state},
+        .multisample{
+          .count{key.sample_count},
+        },
+        .fragment{&fragment_state},
+      };
+      create(render_pipeline_descriptor);
+    }
+    break;
+
+  case pipeline_type::scene_pulled:
+  case pipeline_type::scene_meshlets:                                           // pulls vertices the same way, only choosing them differently
     {
-      // set up render pass
-      wgpu::RenderPassColorAttachment render_pass_colour_attachment{
-        .view{texture_view},
-        .loadOp{wgpu::LoadOp::Clear},
-        .storeOp{wgpu::StoreOp::Store},
-        .clearValue{wgpu::Color{0, 0.5, 0.5, 1.0}},
+      bool const meshlet_culled{key.type == pipeline_type::scene_meshlets};
+      auto const constant{[](char const *name, size_t bytes){
+        return wgpu::ConstantEntry{
+          .key{name},
+          .value{static_cast<double>(bytes / sizeof(float))},                   // in 32-bit words
+        };
+      }};
+      std::array constants{                                                     // describe the vertex layout, so the same shader can pull any vertex format
+        constant("vertex_stride", sizeof(vertex)),
+        constant("position_offset", offsetof(vertex, position)),
+        constant("normal_offset", offsetof(vertex, normal)),
+        constant("colour_offset", offsetof(vertex, colour)),
       };
 
-      wgpu::RenderPassDepthStencilAttachment render_pass_depth_stencil_attachment{
-        .view{webgpu.depth_texture_view},
-        .depthLoadOp{wgpu::LoadOp::Clear},
-        .depthStoreOp{wgpu::StoreOp::Store},
-        .depthClearValue{1.0f},
+      wgpu::BlendState blend_state{                                             // as for the scene with vertex buffers
+        .color{                                                                 // BlendComponent
+          .operation{wgpu::BlendOperation::Add},
+          .srcFactor{wgpu::BlendFactor::SrcAlpha},
+          .dstFactor{wgpu::BlendFactor::OneMinusSrcAlpha},
+        },
+        .alpha{                                                                 // BlendComponent
+          .operation{wgpu::BlendOperation::Add},
+          .srcFactor{wgpu::BlendFactor::Zero},
+          .dstFactor{wgpu::BlendFactor::One},
+        },
       };
-      wgpu::RenderPassDescriptor render_pass_descriptor{
-        .label{"Render pass 1"},
-        .colorAttachmentCount{1},
-        .colorAttachments{&render_pass_colour_attachment},
-        .depthStencilAttachment{&render_pass_depth_stencil_attachment},
+      wgpu::ColorTargetState colour_target_state{
+        .format{key.colour_format},
+        .blend{&blend_state},
       };
-      wgpu::RenderPassEncoder render_pass_encoder{command_encoder.BeginRenderPass(&render_pass_descriptor)};
-
-      render_pass_encoder.SetPipeline(webgpu.pipeline);                         // select which render pipeline to use
-
-      // set up test buffers
-      std::vector<vertex> vertex_data{
-        {{-1.0f, -1.0f, -1.0f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // bottom face normal & colour
-        {{+1.0f, -1.0f, -1.0f}, {+1.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // right face normal & colour
-        {{+1.0f, +1.0f, -1.0f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // front face normal & colour
-        {{-1.0f, +1.0f, -1.0f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // left face normal & colour
-        {{-1.0f, -1.0f, +1.0f}, { 0.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // normal & colour not used
-        {{+1.0f, -1.0f, +1.0f}, { 0.0f,  0.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // normal & colour not used
-        {{+1.0f, +1.0f, +1.0f}, { 0.0f, +1.0f,  0.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // top face normal & colour
-        {{-1.0f, +1.0f, +1.0f}, { 0.0f,  0.0f, +1.0f}, {1.0f, 0.75f, 0.0f, 1.0f}}, // back face normal & colour
+      wgpu::FragmentState fragment_state{
+        .module{webgpu.shader_module},
+        .entryPoint{"fs_main"},
+        .constantCount{0},
+        .constants{nullptr},
+        .targetCount{1},
+        .targets{&colour_target_state},
       };
-      std::vector<triangle_index> index_data{
-        {0, 1, 5}, {0, 5, 4},                                                   // bottom face (y = -1)
-        {1, 6, 5}, {1, 2, 6},                                                   // right face (x = +1)
-        {2, 1, 0}, {2, 0, 3},                                                   // front face (z = -1)
-        {3, 0, 4}, {3, 4, 7},                                                   // left face (x = -1)
-        {6, 3, 7}, {6, 2, 3},                                                   // top face (y = +1)
-        {7, 4, 5}, {7, 5, 6},                                                   // back face (z = +1)
+
+      wgpu::DepthStencilState depth_stencil_state{
+        .format{key.depth_format},
+        .depthWriteEnabled{true},
+        .depthCompare{wgpu::CompareFunction::Less},
+        .stencilFront{},                                                        // StencilFaceState
+        .stencilBack{},                                                         // StencilFaceState
+        .stencilReadMask{0},
+        .stencilWriteMask{0},
       };
 
-      // set up matrices
-      static vec2f angles;
-      angles += rotation;
-      angles.x += 0.01f;                                                        // constant slow spin
-      quatf model_rotation{quatf::from_euler_angles_rad(0.0, angles.x, 0.0)};
-
-      vec3f camera_pos{0.0f, 2.0f, -5.0f};
-      camera_pos.rotate_rad_x(angles.y);
-
-      mat4f projection{make_projection_matrix(static_cast<vec2f>(window.viewport_size))};
-      mat4f look_at{mat4f::create_look_at(
-        camera_pos,                                                             // eye pos
-        {0.0f, 0.0f, 0.0f},                                                     // target pos
-        {0.0f, 1.0f, 0.0f}                                                      // up dir
-      )};
-
-      uniforms uniform_data{
-        projection * look_at * model_rotation.transform(),
-        mat3fwgpu{model_rotation.rotmatrix()},
+      std::array bind_group_layouts{
+        webgpu.bind_group_layout,
+        meshlet_culled ? meshlets.get_draw_bind_group_layout() : webgpu.pulled_bind_group_layout,
+      };
+      wgpu::PipelineLayoutDescriptor pipeline_layout_descriptor{
+        .label{meshlet_culled ? "Meshlet pipeline layout 1" : "Vertex pulling pipeline layout 1"},
+        .bindGroupLayoutCount{bind_group_layouts.size()},
+        .bindGroupLayouts{bind_group_layouts.data()},
       };
 
-      // vertex buffer
-      wgpu::BufferDescriptor vertex_buffer_descriptor{
-        .label{"Vertex buffer 1"},
-        .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Vertex},
-        .size{vertex_data.size() * sizeof(vertex_data[0])},
+      wgpu::RenderPipelineDescriptor render_pipeline_descriptor{
+        .label{meshlet_culled ? "Meshlet render pipeline 1" : "Vertex pulling render pipeline 1"},
+        .layout{webgpu.device.CreatePipelineLayout(&pipeline_layout_descriptor)},
+        .vertex{                                                                // VertexState
+          .module{webgpu.shader_module},
+          .entryPoint{meshlet_culled ? "vs_meshlet" : "vs_pulled"},
+          .constantCount{constants.size()},
+          .constants{constants.data()},
+          .bufferCount{0},                                                      // no fixed vertex layouts, the shader fetches what it needs
+          .buffers{nullptr},
+        },
+        .primitive{                                                             // PrimitiveState
+          .cullMode{wgpu::CullMode::Back},
+        },
+        .depthStencil{&depth_stencil_state},
+        .multisample{
+          .count{key.sample_count},
+        },
+        .fragment{&fragment_state},
       };
-      wgpu::Buffer vertex_buffer{webgpu.device.CreateBuffer(&vertex_buffer_descriptor)};
-      webgpu.queue.WriteBuffer(
-        vertex_buffer,                                                          // buffer
-        0,                                                                      // offset
-        vertex_data.data(),                                                     // data
-        vertex_data.size() * sizeof(vertex_data[0])                             // size
-      );
+      create(render_pipeline_descriptor);
+    }
+    break;
 
-      // index buffer
-      wgpu::BufferDescriptor index_buffer_descriptor{
-        .label{"Index buffer 1"},
-        .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Index},
-        .size{index_data.size() * sizeof(index_data[0])},
+  case pipeline_type::gui_composite:
+    {
+      wgpu::BlendState blend_state{
+        .color{                                                                 // BlendComponent
+          .operation{wgpu::BlendOperation::Add},                                // GUI layer colour is already multiplied by its alpha when rendered over a transparent clear
+          .srcFactor{wgpu::BlendFactor::One},
+          .dstFactor{wgpu::BlendFactor::OneMinusSrcAlpha},
+        },
+        .alpha{                                                                 // BlendComponent
+          .operation{wgpu::BlendOperation::Add},                                // matches the alpha blending of the GUI pipeline itself
+          .srcFactor{wgpu::BlendFactor::One},
+          .dstFactor{wgpu::BlendFactor::OneMinusSrcAlpha},
+        },
+      };
+      wgpu::ColorTargetState colour_target_state{
+        .format{key.colour_format},
+        .blend{&blend_state},
+      };
+      wgpu::FragmentState fragment_state{
+        .module{webgpu.gui_composite_shader_module},
+        .entryPoint{"fs_main"},
+        .constantCount{0},
+        .constants{nullptr},
+        .targetCount{1},
+        .targets{&colour_target_state},
       };
-      wgpu::Buffer index_buffer{webgpu.device.CreateBuffer(&index_buffer_descriptor)};
-      webgpu.queue.WriteBuffer(
-        index_buffer,                                                           // buffer
-        0,                                                                      // offset
-        index_data.data(),                                                      // data
-        index_data.size() * sizeof(index_data[0])                               // size
-      );
 
-      // uniform buffer
-      wgpu::BufferDescriptor uniform_buffer_desecriptor{
-        .label{"Uniform buffer 1"},
-        .usage{wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform},
-        .size{sizeof(uniform_data)},
+      wgpu::DepthStencilState depth_stencil_state{                              // composited within the main pass, so must match its depth attachment
+        .format{key.depth_format},
+        .depthWriteEnabled{false},
+        .depthCompare{wgpu::CompareFunction::Always},
+        .stencilFront{},                                                        // StencilFaceState
+        .stencilBack{},                                                         // StencilFaceState
+        .stencilReadMask{0},
+        .stencilWriteMask{0},
       };
-      wgpu::Buffer uniform_buffer{webgpu.device.CreateBuffer(&uniform_buffer_desecriptor)};
-      webgpu.queue.WriteBuffer(
-        uniform_buffer,                                                         // buffer
-        0,                                                                      // offset
-        &uniform_data,                                                          // data
-        sizeof(uniform_data)                                                    // size
-      );
 
-      // uniform bind group
-      wgpu::BindGroupEntry bind_group_entry{
-        .binding{0},
-        .buffer{uniform_buffer},
-        .size{sizeof(uniforms)},
+      wgpu::PipelineLayoutDescriptor pipeline_layout_descriptor{
+        .label{"GUI composite pipeline layout 1"},
+        .bindGroupLayoutCount{1},
+        .bindGroupLayouts{&webgpu.gui_composite_bind_group_layout},
       };
-      wgpu::BindGroupDescriptor bind_group_descriptor{
-        .label{"Bind group 1"},
-        .layout{webgpu.bind_group_layout},
-        .entryCount{1},                                                         // must correspond to layout
-        .entries{&bind_group_entry},
+
+      wgpu::RenderPipelineDescriptor render_pipeline_descriptor{
+        .label{"GUI composite pipeline 1"},
+        .layout{webgpu.device.CreatePipelineLayout(&pipeline_layout_descriptor)},
+        .vertex{                                                                // VertexState
+          .module{webgpu.gui_composite_shader_module},
+          .entryPoint{"vs_main"},
+          .constantCount{0},
+          .constants{nullptr},
+          .bufferCount{0},
+          .buffers{nullptr},
+        },
+        .primitive{                                                             // PrimitiveState
+          .cullMode{wgpu::CullMode::None},
+        },
+        .depthStencil{&depth_stencil_state},
+        .multisample{
+          .count{key.sample_count},
+        },
+        .fragment{&fragment_state},
       };
-      wgpu::BindGroup bind_group{webgpu.device.CreateBindGroup(&bind_group_descriptor)};
+      create(render_pipeline_descriptor);
+    }
+    break;
+
+  case pipeline_type::post_process:
+    post.describe_pipeline(key, create);
+    break;
+
+  case pipeline_type::terrain:
+    terrain.describe_pipeline(key, create);
+    break;
+  }
+}
+
+void webgpu_renderer::draw_gui_layer(wgpu::CommandEncoder &command_encoder, ImDrawData &draw_data, wgpu::TextureView const &depth) {
+  /// Render the GUI into the cached GUI layer texture
+  wgpu::RenderPassColorAttachment render_pass_colour_attachment{
+    .view{webgpu.gui_texture_view},
+    .loadOp{wgpu::LoadOp::Clear},
+    .storeOp{wgpu::StoreOp::Store},
+    .clearValue{wgpu::Color{0.0, 0.0, 0.0, 0.0}},                               // transparent, so the layer composites as premultiplied alpha
+  };
+  wgpu::RenderPassDepthStencilAttachment render_pass_depth_stencil_attachment{  // the GUI pipeline expects a depth attachment, but never tests against it, so it's cleared rather than read
+    .view{depth},
+    .depthLoadOp{wgpu::LoadOp::Clear},
+    .depthStoreOp{wgpu::StoreOp::Discard},
+    .depthClearValue{1.0f},
+  };
+  wgpu::RenderPassDescriptor render_pass_descriptor{
+    .label{"GUI render pass 1"},
+    .colorAttachmentCount{1},
+    .colorAttachments{&render_pass_colour_attachment},
+    .depthStencilAttachment{&render_pass_depth_stencil_attachment},
+  };
+  wgpu::RenderPassEncoder render_pass_encoder{command_encoder.BeginRenderPass(&render_pass_descriptor)};
+  ImGui_ImplWGPU_RenderDrawData(&draw_data, render_pass_encoder.Get());
+  render_pass_encoder.End();
+}
+
+void webgpu_renderer::set_gui_layer_caching(bool enabled) {
+  /// Choose whether to cache the GUI in its own texture, or render it directly into the frame every frame
+  if(gui_layer.enabled == enabled) return;
+  gui_layer.enabled = enabled;
+  if(webgpu.device) init_gui_texture();                                         // create or release the GUI texture, if we're already configured
+}
+
+void webgpu_renderer::invalidate_gui_layer() {
+  /// Redraw the cached GUI layer next frame, even if the GUI draw data hasn't changed
+  /// The draw data only refers to textures, so anything changing the contents of a texture the GUI shows must call this
+  gui_layer.valid = false;
+}
+
+void webgpu_renderer::set_scene_instances(unsigned int count) {
+  /// Set how many copies of the scene geometry to draw, laid out in a grid
+  scene.instance_count = std::max(count, 1u);
+  if(configured) init_scene_instances();
+}
+
+void webgpu_renderer::set_gpu_time_callback(std::function<void(uint64_t, double)> &&this_gpu_time_callback) {
+  /// Set a callback to receive the number of each frame, as from get_frame_number, and how long its GPU work took from submission to completion, in milliseconds
+  gpu_time_callback = std::move(this_gpu_time_callback);
+}
+
+void webgpu_renderer::set_gui_image_callback(texture_pool::image_function &&this_gui_image_callback) {
+  /// Set a callback to draw a view of one of our textures in the GUI, for previewing render targets
+  gui_image_callback = std::move(this_gui_image_callback);
+}
+
+void webgpu_renderer::add_texture_destroyed_callback(memory_tracker::texture_destroyed_function &&texture_destroyed_callback) {
+  /// Add a callback to be told when one of our textures is destroyed, so anything holding views of it can let them go
+  memory.add_texture_destroyed_function(std::move(texture_destroyed_callback));
+}
+
+void webgpu_renderer::report_gui_memory(void const *resource, uint64_t bytes) {
+  /// Account for a buffer or texture the GUI backend created with this many bytes, or released if 0
+  if(bytes == 0) {
+    memory.remove_external(resource);
+  } else {
+    memory.add_external(resource, memory_tracker::category::gui, bytes);
+  }
+}
+
+void webgpu_renderer::draw_settings_gui() {
+  /// Show controls for renderer settings, within the current ImGui window
+  if(bool caching{gui_layer.enabled}; ImGui::Checkbox("Cache GUI layer", &caching)) set_gui_layer_caching(caching);
+  if(auto path{static_cast<int>(geometry)}; ImGui::Combo("Geometry", &path, "Vertex buffers\0Vertex pulling\0Meshlet culling\0")) {
+    geometry = static_cast<geometry_path>(path);
+  }
+  ImGui::SetItemTooltip("How vertices reach the shader: through vertex buffer layouts, fetched from storage buffers, or from meshlets culled on the GPU");
+  if(geometry == geometry_path::meshlets) meshlets.draw_gui();
+  ImGui::SeparatorText("Terrain");
+  terrain.draw_settings_gui();
+  ImGui::SeparatorText("Post-processing");
+  post.draw_settings_gui();
+  if(ImGui::CollapsingHeader("GPU memory")) memory.draw_gui();
+  if(gui_image_callback && ImGui::CollapsingHeader("Render targets")) {
+    textures.draw_gui([&](wgpu::Texture const &texture, wgpu::TextureView const &view, vec2f const &size){
+      if(gui_layer.enabled && view.Get() == webgpu.gui_texture_view.Get()) {    // the GUI can't sample the texture it's being drawn into
+        ImGui::TextDisabled("(the GUI layer itself)");
+        return;
+      }
+      gui_image_callback(texture, view, size);
+    });
+  }
+  #ifndef NDEBUG
+    if(ImGui::CollapsingHeader(("WebGPU errors (" + std::to_string(errors.get_total()) + ")###WebGPU errors").c_str())) {
+      errors.draw_gui();
+    }
+  #endif // NDEBUG
+}
+
+void webgpu_renderer::draw_scene(wgpu::CommandEncoder &command_encoder, wgpu::TextureView const &target, wgpu::TextureFormat target_format, wgpu::TextureView const &depth, vec2f const& rotation, bool overlay_gui) {
+  /// Render the scene, then if requested composite or render the GUI over it
+  // set up matrices
+  static vec2f angles;
+  angles += rotation;
+  angles.x += 0.01f;                                                            // constant slow spin
+  quatf model_rotation{quatf::from_euler_angles_rad(0.0, angles.x, 0.0)};
+
+  vec3f camera_pos{0.0f, 2.0f, -5.0f};
+  camera_pos.rotate_rad_x(angles.y);
+
+  mat4f projection{make_projection_matrix(static_cast<vec2f>(window.viewport_size))};
+  mat4f look_at{mat4f::create_look_at(
+    camera_pos,                                                                 // eye pos
+    {0.0f, 0.0f, 0.0f},                                                         // target pos
+    {0.0f, 1.0f, 0.0f}                                                          // up dir
+  )};
+
+  mat4f const model_view_projection{projection * look_at * model_rotation.transform()};
+  vec3f const camera_model_pos{model_rotation.rotmatrix().transpose() * camera_pos}; // camera in model space, where the meshlet bounds and terrain are
+
+  // uniform buffer, written a member at a time so an unchanged one isn't uploaded even when its neighbour changes
+  scene_uniforms.write(model_view_projection, offsetof(uniforms, model_view_projection_matrix));
+  scene_uniforms.write(mat3fwgpu{model_rotation.rotmatrix()}, offsetof(uniforms, normal_matrix));
+  scene_uniforms.upload(webgpu.queue);
+
+  if(geometry == geometry_path::meshlets) meshlets.cull(command_encoder, scene.bind_group, camera_model_pos);
+  terrain.update(camera_model_pos, model_view_projection);
+
+  // set up render pass
+  wgpu::RenderPassColorAttachment render_pass_colour_attachment{
+    .view{target},
+    .loadOp{wgpu::LoadOp::Clear},
+    .storeOp{wgpu::StoreOp::Store},
+    .clearValue{wgpu::Color{0, 0.5, 0.5, 1.0}},
+  };
+
+  wgpu::RenderPassDepthStencilAttachment render_pass_depth_stencil_attachment{
+    .view{depth},
+    .depthLoadOp{wgpu::LoadOp::Clear},
+    .depthStoreOp{wgpu::StoreOp::Store},
+    .depthClearValue{1.0f},
+  };
+  wgpu::RenderPassDescriptor render_pass_descriptor{
+    .label{"Render pass 1"},
+    .colorAttachmentCount{1},
+    .colorAttachments{&render_pass_colour_attachment},
+    .depthStencilAttachment{&render_pass_depth_stencil_attachment},
+  };
+  wgpu::RenderPassEncoder render_pass_encoder{command_encoder.BeginRenderPass(&render_pass_descriptor)};
+
+  pipeline_key key{
+    .colour_format{target_format},
+    .depth_format{webgpu.depth_texture_format},
+  };
+  render_pass_encoder.SetBindGroup(0, scene.bind_group);                        // groupIndex, group, dynamicOffsetCount = 0, dynamicOffsets = nullptr
+  switch(geometry) {
+  case geometry_path::vertex_buffers:
+    key.type = pipeline_type::scene;
+    render_pass_encoder.SetPipeline(pipelines.get(key));
+    render_pass_encoder.SetVertexBuffer(0, scene.vertex_buffer, 0, scene.vertex_buffer.GetSize()); // slot, buffer, offset, size
+    render_pass_encoder.SetVertexBuffer(1, scene.instance_buffer, 0, scene.instance_buffer.GetSize()); // slot, buffer, offset, size
+    render_pass_encoder.SetIndexBuffer(scene.index_buffer, wgpu::IndexFormat::Uint16, 0, scene.index_buffer.GetSize()); // buffer, format, offset, size
+    render_pass_encoder.DrawIndexed(scene.index_count, scene.instance_count);   // indexCount, instanceCount, firstIndex = 0, baseVertex = 0, firstInstance = 0
+    break;
+  case geometry_path::vertex_pulling:
+    key.type = pipeline_type::scene_pulled;
+    render_pass_encoder.SetPipeline(pipelines.get(key));
+    render_pass_encoder.SetBindGroup(1, scene.pulled_bind_group);
+    render_pass_encoder.Draw(scene.index_count, scene.instance_count);          // vertexCount, instanceCount, firstVertex = 0, firstInstance = 0 - each vertex looks up its own index
+    break;
+  case geometry_path::meshlets:
+    key.type = pipeline_type::scene_meshlets;
+    render_pass_encoder.SetPipeline(pipelines.get(key));
+    meshlets.draw(render_pass_encoder);
+    break;
+  }
+  if(terrain.settings.enabled) {
+    key.type = pipeline_type::terrain;
+    terrain.draw(render_pass_encoder, pipelines.get(key));
+  }
+
+  if(overlay_gui) draw_gui(render_pass_encoder);
+
+  // TODO: add timestamp query: https://eliemichel.github.io/LearnWebGPU/advanced-techniques/benchmarking/time.html
+  render_pass_encoder.End();
+}
 
-      render_pass_encoder.SetVertexBuffer(0, vertex_buffer, 0, vertex_buffer.GetSize()); // slot, buffer, offset, size
-      render_pass_encoder.SetIndexBuffer(index_buffer, wgpu::IndexFormat::Uint16, 0, index_buffer.GetSize()); // buffer, format, offset, size
-      render_pass_encoder.SetBindGroup(0, bind_group);                          // groupIndex, group, dynamicOffsetCount = 0, dynamicOffsets = nullptr
-      render_pass_encoder.DrawIndexed(index_data.size() * decltype(index_data)::value_type::size()); // indexCount, instanceCount = 1, firstIndex = 0, baseVertex = 0, firstInstance = 0
+void webgpu_renderer::draw_post_process(wgpu::CommandEncoder &command_encoder, wgpu::TextureView const &scene_colour, wgpu::TextureView const &target, wgpu::TextureView const &depth, uint32_t variant) {
+  /// Apply post-processing to the scene in a single full-screen pass into the frame, then composite or render the GUI over it
+  wgpu::RenderPassColorAttachment render_pass_colour_attachment{
+    .view{target},
+    .loadOp{wgpu::LoadOp::Clear},                                               // every pixel is overwritten, but clearing avoids loading the old contents
+    .storeOp{wgpu::StoreOp::Store},
+    .clearValue{wgpu::Color{0.0, 0.0, 0.0, 1.0}},
+  };
+  wgpu::RenderPassDepthStencilAttachment render_pass_depth_stencil_attachment{  // the GUI pipelines expect a depth attachment, but never read or write it
+    .view{depth},
+    .depthReadOnly{true},
+  };
+  wgpu::RenderPassDescriptor render_pass_descriptor{
+    .label{"Post-process render pass 1"},
+    .colorAttachmentCount{1},
+    .colorAttachments{&render_pass_colour_attachment},
+    .depthStencilAttachment{&render_pass_depth_stencil_attachment},
+  };
+  wgpu::RenderPassEncoder render_pass_encoder{command_encoder.BeginRenderPass(&render_pass_descriptor)};
+
+  post.draw(render_pass_encoder, pipelines.get({
+    .type{pipeline_type::post_process},
+    .colour_format{webgpu.surface_preferred_format},
+    .depth_format{webgpu.depth_texture_format},
+    .variant{variant},
+  }), scene_colour, window.viewport_size);
+  draw_gui(render_pass_encoder);                                                // the GUI goes over the top unprocessed
+
+  render_pass_encoder.End();
+}
+
+void webgpu_renderer::draw_gui(wgpu::RenderPassEncoder &render_pass_encoder) {
+  /// Composite the cached GUI layer, or render the GUI directly, into the frame being drawn by the current pass
+  if(gui_layer.enabled) {
+    render_pass_encoder.SetPipeline(pipelines.get({                             // composite the cached GUI layer over the frame
+      .type{pipeline_type::gui_composite},
+      .colour_format{webgpu.surface_preferred_format},
+      .depth_format{webgpu.depth_texture_format},
+    }));
+    render_pass_encoder.SetBindGroup(0, webgpu.gui_composite_bind_group);
+    render_pass_encoder.Draw(3);                                                // vertexCount, instanceCount = 1, firstVertex = 0, firstInstance = 0
+  } else {
+    ImGui_ImplWGPU_RenderDrawData(ImGui::GetDrawData(), render_pass_encoder.Get()); // render the outstanding GUI draw data
+  }
+}
+
+void webgpu_renderer::recover_device() {
+  /// Recreate everything on the replacement for a lost device, from the state each part of the renderer keeps on the CPU
+  logger << "WebGPU: Replacement device ready, recreating resources";
+  configure();
+  if(device_recovered_callback) device_recovered_callback(webgpu);              // let anything else rendering with the device move to the new one
+  lost_device = nullptr;
+  logger << "WebGPU: Recovered from device loss";
+}
+
+void webgpu_renderer::set_device_recovered_callback(std::function<void(webgpu_data const&)> &&this_device_recovered_callback) {
+  /// Set a callback to be called when a replacement for a lost device is ready, after the renderer has recreated its own resources
+  device_recovered_callback = std::move(this_device_recovered_callback);
+}
+
+uint64_t webgpu_renderer::get_frame_number() const {
+  /// Return the number the next frame drawn will have
+  return frame_number;
+}
+
+void webgpu_renderer::draw(vec2f const& rotation) {
+  /// Draw a frame
+  auto const this_frame_number{frame_number++};                                 // counted even when we can't draw, so frame numbers stay in step with the caller's frames
+  if(!webgpu.device) return;                                                    // the device was lost, and its replacement isn't ready yet
+  if(lost_device) {
+    recover_device();
+    return;                                                                     // this frame's GUI draw data refers to the lost device's resources
+  }
+
+  wgpu::TextureView texture_view{webgpu.swapchain.GetCurrentTextureView()};
+  if(!texture_view) throw std::runtime_error{"Could not get current texture view from swap chain"};
 
-      ImGui_ImplWGPU_RenderDrawData(ImGui::GetDrawData(), render_pass_encoder.Get()); // render the outstanding GUI draw data
+  {
+    auto const error_scope{errors.capture("Frame")};                            // encoding errors are only reported when the encoder is finished, so one scope covers the whole frame
+    wgpu::CommandEncoderDescriptor command_encoder_descriptor{
+      .label = "Command encoder 1"
+    };
+    wgpu::CommandEncoder command_encoder{webgpu.device.CreateCommandEncoder(&command_encoder_descriptor)};
 
-      // TODO: add timestamp query: https://eliemichel.github.io/LearnWebGPU/advanced-techniques/benchmarking/time.html
-      render_pass_encoder.End();
+    graph.reset();
+    auto const frame{graph.import_texture("Swapchain texture", texture_view)};
+    graph.mark_output(frame);
+    auto const depth{graph.create_texture("Depth texture", {
+      .format{webgpu.depth_texture_format},
+      .size{window.viewport_size},
+    })};
+
+    std::vector<render_graph::resource_id> gui_reads;                           // whichever pass draws the GUI over the frame
+    if(gui_layer.enabled) {
+      auto const gui_layer_texture{graph.import_texture("GUI layer texture", webgpu.gui_texture_view)};
+      gui_reads.emplace_back(gui_layer_texture);                                // composited over the frame
+      if(ImDrawData *draw_data{ImGui::GetDrawData()}; draw_data) {
+        gui_layer_data::draw_data_key const key{                                // hashed once here, and reused by the backend to skip unchanged uploads
+          .hash{ImGui_ImplWGPU_HashDrawData(draw_data)},
+          .vertex_count{draw_data->TotalVtxCount},
+          .index_count{draw_data->TotalIdxCount},
+          .list_count{draw_data->CmdListsCount},
+        };
+        if(!gui_layer.valid || gui_layer.draw_data != key) {                    // otherwise the texture already holds this GUI output
+          graph.add_pass("GUI layer", {}, {gui_layer_texture, depth}, [this, draw_data, depth, key](wgpu::CommandEncoder &command_encoder){
+            draw_gui_layer(command_encoder, *draw_data, graph.get_view(depth));
+            gui_layer.draw_data = key;                                          // only once the pass is actually recorded
+            gui_layer.valid = true;
+          });
+        }
+      }
+    }
+    if(auto const post_variant{post.get_variant()}; post_variant == 0) {        // no post-processing, so the scene goes straight into the frame
+      graph.add_pass("Scene", std::move(gui_reads), {frame, depth}, [this, frame, depth, rotation](wgpu::CommandEncoder &command_encoder){
+        draw_scene(command_encoder, graph.get_view(frame), webgpu.surface_preferred_format, graph.get_view(depth), rotation, true);
+      });
+    } else {
+      auto const scene_colour{graph.create_texture("Scene colour texture", {
+        .format{post_process::input_format},
+        .size{window.viewport_size},
+        .usage{wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding},
+      })};
+      graph.add_pass("Scene", {}, {scene_colour, depth}, [this, scene_colour, depth, rotation](wgpu::CommandEncoder &command_encoder){
+        draw_scene(command_encoder, graph.get_view(scene_colour), post_process::input_format, graph.get_view(depth), rotation, false);
+      });
+      gui_reads.emplace_back(scene_colour);
+      gui_reads.emplace_back(depth);
+      graph.add_pass("Post-process", std::move(gui_reads), {frame}, [this, scene_colour, frame, depth, post_variant](wgpu::CommandEncoder &command_encoder){
+        draw_post_process(command_encoder, graph.get_view(scene_colour), graph.get_view(frame), graph.get_view(depth), post_variant);
+      });
     }
 
+    graph.execute(command_encoder);
+
     command_encoder.InsertDebugMarker("Debug marker 1");
 
     wgpu::CommandBufferDescriptor command_buffer_descriptor {
@@ -882,6 +1494,26 @@ void webgpu_renderer::draw(vec2f const& rotation) {
     //);
 
     webgpu.queue.Submit(1, &command_buffer);
+    textures.end_frame();
+    memory.destroy_pending();                                                   // textures evicted while recording, which the submitted commands may have used
+
+    if(gpu_time_callback) {
+      struct request {
+        webgpu_renderer &renderer;
+        uint64_t frame_number;
+        double submit_time;
+      };
+      webgpu.queue.OnSubmittedWorkDone(
+        [](WGPUQueueWorkDoneStatus status_c, void *data){
+          /// Submitted work done callback, timing the frame's GPU work
+          std::unique_ptr<request> const this_request{static_cast<request*>(data)};
+          auto &renderer{this_request->renderer};
+          if(static_cast<wgpu::QueueWorkDoneStatus>(status_c) != wgpu::QueueWorkDoneStatus::Success) return;
+          if(renderer.gpu_time_callback) renderer.gpu_time_callback(this_request->frame_number, emscripten_get_now() - this_request->submit_time);
+        },
+        new request{*this, this_frame_number, emscripten_get_now()}
+      );
+    }
   }
 }
 
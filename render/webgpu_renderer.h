@@ -4,6 +4,17 @@
 #include <webgpu/webgpu_cpp.h>
 #include "logstorm/logstorm_forward.h"
 #include "vectorstorm/vector/vector2.h"
+#include "error_tracker.h"
+#include "memory_tracker.h"
+#include "meshlet_culling.h"
+#include "pipeline_cache.h"
+#include "post_process.h"
+#include "render_graph.h"
+#include "terrain_clipmap.h"
+#include "texture_pool.h"
+#include "uniform_block.h"
+
+struct ImDrawData;
 
 namespace render {
 
@@ -17,13 +28,16 @@ public:
     wgpu::Adapter adapter;                                                      // WebGPU adapter once it has been acquired
     wgpu::Device device;                                                        // WebGPU device once it has been acquired
     wgpu::Queue queue;                                                          // the queue for this device, once it has been acquired
+    wgpu::ShaderModule shader_module;                                           // scene shaders
     wgpu::BindGroupLayout bind_group_layout;                                    // layout for the uniform bind group
-    wgpu::RenderPipeline pipeline;                                              // the render pipeline currently in use
+    wgpu::BindGroupLayout pulled_bind_group_layout;                             // layout for the storage buffers vertices are pulled from
 
     wgpu::SwapChain swapchain;                                                  // the swapchain providing a texture view to render to
 
-    wgpu::Texture depth_texture;                                                // depth buffer
-    wgpu::TextureView depth_texture_view;
+    wgpu::TextureView gui_texture_view;                                         // cached GUI layer, redrawn only when the GUI draw data changes, drawn from the texture pool
+    wgpu::BindGroupLayout gui_composite_bind_group_layout;                      // layout for the GUI layer texture bind group
+    wgpu::BindGroup gui_composite_bind_group;                                   // binds the GUI layer texture for compositing
+    wgpu::ShaderModule gui_composite_shader_module;                             // shaders compositing the GUI layer onto the frame
 
     wgpu::TextureFormat surface_preferred_format{wgpu::TextureFormat::Undefined}; // preferred texture format for this surface
     static constexpr wgpu::TextureFormat depth_texture_format{wgpu::TextureFormat::Depth24Plus}; // what format to use for the depth texture
@@ -35,30 +49,100 @@ public:
 
 private:
   webgpu_data webgpu;
+  error_tracker errors;                                                         // WebGPU errors by call site in debug builds
+  memory_tracker memory;                                                        // estimated GPU memory use by category
+  pipeline_cache pipelines;                                                     // render pipelines by permutation, warmed up at startup
+  texture_pool textures;                                                        // render targets, recycled across frames and resizes
+  render_graph graph;                                                           // passes making up the current frame
+  post_process post;                                                            // post-processing effects applied to the scene
+  uniform_block scene_uniforms;                                                 // scene transforms, uploaded only where they change
+  meshlet_culling meshlets;                                                     // GPU culling of the scene's meshlets
+  terrain_clipmap terrain;                                                      // clipmap terrain, streamed in around the viewer
+  wgpu::Device lost_device;                                                     // a device we've lost, while we wait for its replacement
+  bool configured{false};
+  uint64_t frame_number{0};                                                     // frames drawn so far, so each frame's GPU time can be matched to the frame that submitted it
+  double warm_up_deadline{0.0};                                                 // time after which we stop waiting for pipelines to warm up before starting
+  static constexpr double warm_up_timeout_ms{5000.0};
 
   struct window_data {
     vec2ui viewport_size;                                                       // our idea of the size of the viewport we render to, in real pixels
     float device_pixel_ratio{1.0f};
   } window;
 
+  struct scene_data {
+    wgpu::Buffer vertex_buffer;
+    wgpu::Buffer index_buffer;
+    uint32_t index_count{0};
+    wgpu::Buffer instance_buffer;                                               // offset of each instance
+    uint32_t instance_count{1};
+    wgpu::BindGroup bind_group;                                                 // binds the uniform buffer
+    wgpu::BindGroup pulled_bind_group;                                          // binds the vertex, index and instance buffers as storage for vertex pulling
+  } scene;
+
+  enum class geometry_path : uint32_t {                                         // how the scene's geometry reaches the vertex shader
+    vertex_buffers,                                                             // fixed vertex buffer layouts
+    vertex_pulling,                                                             // fetched from storage buffers in the shader
+    meshlets,                                                                   // meshlets culled in a compute pass, with the survivors pulled and drawn indirectly
+  } geometry{geometry_path::vertex_buffers};
+
+  struct gui_layer_data {
+    bool enabled{true};                                                         // render the GUI into its own texture only when it changes, and composite that texture every frame
+    bool valid{false};                                                          // whether the GUI texture currently holds the draw data matching draw_data, cleared when a texture the GUI shows changes
+    struct draw_data_key {                                                      // content hash of the GUI draw data, along with its sizes to make collisions less likely - texture contents aren't included
+      unsigned int hash{0};
+      int vertex_count{0};
+      int index_count{0};
+      int list_count{0};
+
+      bool operator==(draw_data_key const&) const = default;
+    } draw_data;                                                                // the GUI draw data last rendered into the GUI texture
+  } gui_layer;
+
   std::function<void(webgpu_data const&)> postinit_callback;                    // the callback that is called once when init completes (it cannot return normally because of emscripten's loop mechanism)
   std::function<void()> main_loop_callback;                                     // the callback that is called repeatedly for the main loop after init
+  std::function<void(webgpu_data const&)> device_recovered_callback;            // the callback that is called when a lost device has been replaced
+  std::function<void(uint64_t, double)> gpu_time_callback;                      // the callback that is called with the number and GPU time of each frame, if set
+  texture_pool::image_function gui_image_callback;                              // the callback that draws one of our textures in the GUI, if set
 
 public:
   webgpu_renderer(logstorm::manager &logger);
 
   void init(std::function<void(webgpu_data const&)> &&postinit_callback, std::function<void()> &&main_loop_callback);
+  void set_device_recovered_callback(std::function<void(webgpu_data const&)> &&device_recovered_callback);
 
 private:
+  void request_adapter();
+  void recover_device();
+
   void init_swapchain();
-  void init_depth_texture();
+  void init_gui_texture();
+  void init_scene();
+  void init_scene_instances();
 
   void wait_to_configure_loop();
   void configure();
 
   void update_imgui_size();
 
+  void describe_pipeline(pipeline_key const &key, pipeline_cache::create_function const &create) const;
+
+  void draw_gui_layer(wgpu::CommandEncoder &command_encoder, ImDrawData &draw_data, wgpu::TextureView const &depth);
+  void draw_scene(wgpu::CommandEncoder &command_encoder, wgpu::TextureView const &target, wgpu::TextureFormat target_format, wgpu::TextureView const &depth, vec2f const& rotation, bool overlay_gui);
+  void draw_post_process(wgpu::CommandEncoder &command_encoder, wgpu::TextureView const &scene_colour, wgpu::TextureView const &target, wgpu::TextureView const &depth, uint32_t variant);
+  void draw_gui(wgpu::RenderPassEncoder &render_pass_encoder);
+
 public:
+  void set_gui_layer_caching(bool enabled);
+  void invalidate_gui_layer();
+  void set_scene_instances(unsigned int count);
+  void set_gpu_time_callback(std::function<void(uint64_t, double)> &&gpu_time_callback);
+  void set_gui_image_callback(texture_pool::image_function &&gui_image_callback);
+  void add_texture_destroyed_callback(memory_tracker::texture_destroyed_function &&texture_destroyed_callback);
+  void report_gui_memory(void const *resource, uint64_t bytes);
+  void draw_settings_gui();
+
+  uint64_t get_frame_number() const;
+
   void draw(vec2f const& rotation);
 };
 
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <new>
 #include <span>
 #include <string>
 
 namespace secure_cleanse_impl {
 
+#if !defined(__GNUC__) && !defined(__clang__)
 // Pointer to memset is volatile so that compiler must de-reference
 // the pointer and can't assume that it points to any function in
 // particular (such as memset, which it then might further "optimize")
 using memset_t = void *(*)(void *, int, size_t);
 static volatile memset_t memset_func{memset};
+#endif // !defined(__GNUC__) && !defined(__clang__)
 
 } // namespace secure_cleanse_impl
 
@@ -20,17 +27,134 @@ inline void secure_cleanse(std::string &target);
 
 inline void secure_cleanse(void *ptr, size_t len) {
   /// Securely erase a block of memory
-  secure_cleanse_impl::memset_func(ptr, 0, len);
+  #if defined(__GNUC__) || defined(__clang__)
+    // a plain memset can be inlined and vectorised (memory.fill on wasm), and the empty asm statement that
+    // claims to read the memory afterwards stops the compiler eliding it as a dead store, as explicit_bzero does
+    std::memset(ptr, 0, len);
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
+  #else
+    secure_cleanse_impl::memset_func(ptr, 0, len);
+  #endif // defined(__GNUC__) || defined(__clang__)
 }
 
 inline void secure_cleanse(std::span<std::byte> target) {
   /// Securely erase a block of memory pointed to by a span
-  secure_cleanse_impl::memset_func(target.data(), 0, target.size());
+  secure_cleanse(target.data(), target.size());
 }
 
 inline void secure_cleanse(std::string &target) {
-  /// Securely erase a string
-  target.resize(target.capacity(), '\0');
-  secure_cleanse_impl::memset_func(target.data(), 0, target.size());
+  /// Securely erase a string, including any unused capacity
+  target.resize_and_overwrite(target.capacity(), [](char *data, size_t size){   // extends to the full capacity without filling it first
+    secure_cleanse(data, size);
+    return size;
+  });
   target.clear();
 }
+
+template<typename T>
+class secure_allocator {
+  /// Standard allocator that securely erases memory when it is freed
+  /// Note that containers with small buffer optimisation, such as std::string, don't allocate short contents at all
+public:
+  using value_type = T;
+
+  secure_allocator() noexcept = default;
+  template<typename U> secure_allocator(secure_allocator<U> const &/*other*/) noexcept {}
+
+  T *allocate(size_t count) {
+    /// Allocate memory as std::allocator does
+    return std::allocator<T>{}.allocate(count);
+  }
+
+  void deallocate(T *ptr, size_t count) noexcept {
+    /// Securely erase memory before freeing it
+    secure_cleanse(ptr, count * sizeof(T));
+    std::allocator<T>{}.deallocate(ptr, count);
+  }
+
+  template<typename U> bool operator==(secure_allocator<U> const &/*other*/) const noexcept {
+    return true;
+  }
+};
+
+using secure_string = std::basic_string<char, std::char_traits<char>, secure_allocator<char>>;
+
+class secure_arena {
+  /// Bump allocator over a single block, which is securely erased in bulk when reset or destroyed
+  /// Many small sensitive allocations can be made without erasing each one as it's freed
+  std::unique_ptr<std::byte[]> block;
+  size_t capacity{0};
+  size_t used{0};                                                               // high water mark, everything below this is erased on reset
+
+public:
+  explicit secure_arena(size_t this_capacity)
+    : block{std::make_unique_for_overwrite<std::byte[]>(this_capacity)},
+      capacity{this_capacity} {
+  }
+  secure_arena(secure_arena const&) = delete;
+  secure_arena &operator=(secure_arena const&) = delete;
+
+  ~secure_arena() {
+    reset();
+  }
+
+  void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept {
+    /// Return memory from the arena, or nullptr if it's full - alignment must be a power of two
+    auto const base{reinterpret_cast<uintptr_t>(block.get())};                  // the block itself is only aligned for new, so align the address rather than the offset
+    size_t const offset{((base + used + alignment - 1) & ~(alignment - 1)) - base};
+    if(offset > capacity || size > capacity - offset) return nullptr;
+    used = offset + size;
+    return block.get() + offset;
+  }
+
+  void reset() noexcept {
+    /// Securely erase everything allocated so far, and make the whole arena available again
+    secure_cleanse(block.get(), used);
+    used = 0;
+  }
+
+  size_t get_used() const noexcept {
+    return used;
+  }
+
+  size_t get_capacity() const noexcept {
+    return capacity;
+  }
+};
+
+template<typename T>
+class secure_arena_allocator {
+  /// Standard allocator drawing from a secure_arena - freeing is a no-op, the arena erases everything when it is reset
+  template<typename U> friend class secure_arena_allocator;
+
+  secure_arena *arena;
+
+public:
+  using value_type = T;
+
+  explicit secure_arena_allocator(secure_arena &this_arena) noexcept
+    : arena{&this_arena} {
+  }
+  template<typename U> secure_arena_allocator(secure_arena_allocator<U> const &other) noexcept
+    : arena{other.arena} {
+  }
+
+  T *allocate(size_t count) {
+    void *ptr{count > static_cast<size_t>(-1) / sizeof(T) ? nullptr : arena->allocate(count * sizeof(T), alignof(T))};
+    if(!ptr) {
+      #ifdef __cpp_exceptions
+        throw std::bad_alloc{};
+      #else
+        std::abort();
+      #endif // __cpp_exceptions
+    }
+    return static_cast<T*>(ptr);
+  }
+
+  void deallocate(T */*ptr*/, size_t /*count*/) noexcept {
+  }
+
+  template<typename U> bool operator==(secure_arena_allocator<U> const &other) const noexcept {
+    return arena == other.arena;
+  }
+};
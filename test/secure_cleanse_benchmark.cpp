@@ -0,0 +1,47 @@
+/// Native benchmark of secure_cleanse against the volatile memset pointer it replaced, across a sweep of sizes
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "secure_cleanse.h"
+
+namespace {
+
+using memset_t = void *(*)(void *, int, size_t);
+volatile memset_t volatile_memset_func{memset};
+
+void volatile_cleanse(void *ptr, size_t len) {
+  /// The previous implementation, calling memset through a volatile pointer so it can't be inlined or elided
+  volatile_memset_func(ptr, 0, len);
+}
+
+template<typename T>
+double measure_gibibytes_per_second(T &&cleanse, std::vector<std::byte> &buffer, size_t size) {
+  /// Time repeated erasure of a block of this size, returning the best throughput of several runs
+  constexpr size_t bytes_per_run{size_t{256} << 20};
+  constexpr unsigned int runs{5};
+  size_t const repeats{std::max<size_t>(bytes_per_run / size, 1)};
+  double best_seconds{0.0};
+  for(unsigned int run{0}; run != runs; ++run) {
+    auto const start{std::chrono::steady_clock::now()};
+    for(size_t i{0}; i != repeats; ++i) cleanse(buffer.data(), size);
+    std::chrono::duration<double> const elapsed{std::chrono::steady_clock::now() - start};
+    if(run == 0 || elapsed.count() < best_seconds) best_seconds = elapsed.count();
+  }
+  return static_cast<double>(repeats * size) / best_seconds / static_cast<double>(size_t{1} << 30);
+}
+
+}
+
+int main() {
+  constexpr size_t max_size{size_t{64} << 20};
+  std::vector<std::byte> buffer(max_size, std::byte{0xaa});
+  std::printf("%12s %16s %16s %8s\n", "bytes", "volatile GiB/s", "inline GiB/s", "speedup");
+  for(size_t size{16}; size <= max_size; size *= 4) {
+    double const before{measure_gibibytes_per_second(volatile_cleanse, buffer, size)};
+    double const after{measure_gibibytes_per_second([](void *ptr, size_t len){secure_cleanse(ptr, len);}, buffer, size)};
+    std::printf("%12zu %16.2f %16.2f %7.2fx\n", size, before, after, after / before);
+  }
+}
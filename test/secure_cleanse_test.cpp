@@ -0,0 +1,162 @@
+/// Native test that secure_cleanse, secure_allocator and secure_arena really leave memory zeroed
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "secure_cleanse.h"
+
+namespace {
+
+unsigned int failures{0};
+
+void *watched_ptr{nullptr};                                                     // checked for zeroes when it is freed, as reading it afterwards is undefined
+size_t watched_size{0};
+bool watched_freed{false};
+bool watched_zeroed{false};
+
+void watch(void *ptr, size_t size) {
+  /// Start checking the contents of a block when it is freed
+  watched_ptr = ptr;
+  watched_size = size;
+  watched_freed = false;
+  watched_zeroed = false;
+}
+
+void check_watched(void *ptr) {
+  /// Record whether the watched block is all zeroes, if this is it being freed
+  if(!ptr || ptr != watched_ptr) return;
+  auto const *bytes{static_cast<unsigned char const*>(ptr)};
+  watched_zeroed = std::all_of(bytes, bytes + watched_size, [](unsigned char byte){return byte == 0;});
+  watched_freed = true;
+  watched_ptr = nullptr;
+}
+
+void check(bool condition, char const *description) {
+  /// Report a failed expectation
+  if(condition) return;
+  std::cerr << "FAILED: " << description << std::endl;
+  ++failures;
+}
+
+bool is_zeroed(void const *ptr, size_t size) {
+  /// Whether a block of memory is all zeroes
+  auto const *bytes{static_cast<unsigned char const*>(ptr)};
+  return std::all_of(bytes, bytes + size, [](unsigned char byte){return byte == 0;});
+}
+
+void test_secure_cleanse() {
+  /// Every byte is zeroed, for a range of sizes and alignments, without touching the bytes either side
+  for(size_t const size : {size_t{0}, size_t{1}, size_t{7}, size_t{16}, size_t{63}, size_t{4096}, size_t{1000003}}) {
+    for(size_t const offset : {size_t{0}, size_t{1}, size_t{3}}) {
+      std::vector<unsigned char> buffer(size + offset + 1, 0xaa);
+      secure_cleanse(buffer.data() + offset, size);
+      check(is_zeroed(buffer.data() + offset, size), "secure_cleanse zeroes the block");
+      check(std::all_of(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset), [](unsigned char byte){return byte == 0xaa;}), "secure_cleanse leaves the bytes before the block");
+      check(buffer.back() == 0xaa, "secure_cleanse leaves the byte after the block");
+    }
+  }
+
+  std::vector<std::byte> span_buffer(256, std::byte{0xaa});
+  secure_cleanse(std::span{span_buffer});
+  check(is_zeroed(span_buffer.data(), span_buffer.size()), "secure_cleanse zeroes a span");
+
+  std::string text(100, 'x');
+  text.resize(10);                                                              // leave secrets in the unused capacity too
+  auto const *text_data{text.data()};
+  auto const text_capacity{text.capacity()};
+  secure_cleanse(text);
+  check(text.empty(), "secure_cleanse empties a string");
+  check(text.data() == text_data && is_zeroed(text_data, text_capacity), "secure_cleanse zeroes a string's whole capacity");
+}
+
+void test_secure_allocator() {
+  /// Memory is zeroed before it is returned to the heap
+  constexpr size_t count{1000};
+  secure_allocator<int> allocator;
+  int *ints{allocator.allocate(count)};
+  std::fill_n(ints, count, 0x5a5a5a5a);
+  watch(ints, count * sizeof(int));
+  allocator.deallocate(ints, count);
+  check(watched_freed, "secure_allocator frees its memory");
+  check(watched_zeroed, "secure_allocator zeroes memory before freeing it");
+
+  {
+    secure_string text{"a secret long enough not to fit in the small string buffer"};
+    watch(text.data(), text.capacity() + 1);
+  }
+  check(watched_freed && watched_zeroed, "secure_string zeroes its buffer before freeing it");
+}
+
+void test_secure_arena() {
+  /// Everything allocated is zeroed when the arena is reset, and when it is destroyed
+  constexpr size_t capacity{4096};
+  std::byte *block{nullptr};
+  {
+    secure_arena arena{capacity};
+    auto *first{static_cast<std::byte*>(arena.allocate(100))};
+    auto *second{static_cast<std::byte*>(arena.allocate(200, 64))};
+    check(first && second, "secure_arena allocates within its capacity");
+    check(reinterpret_cast<uintptr_t>(second) % 64 == 0, "secure_arena aligns allocations");
+    check(!arena.allocate(capacity), "secure_arena refuses allocations beyond its capacity");
+    std::fill_n(first, 100, std::byte{0xaa});
+    std::fill_n(second, 200, std::byte{0xaa});
+    block = first;
+    auto const used{arena.get_used()};
+    arena.reset();
+    check(arena.get_used() == 0, "secure_arena is empty after reset");
+    check(is_zeroed(block, used), "secure_arena zeroes its allocations on reset");
+
+    {
+      std::vector<int, secure_arena_allocator<int>> ints(50, 0x5a5a5a5a, secure_arena_allocator<int>{arena});
+      check(reinterpret_cast<std::byte*>(ints.data()) == block, "secure_arena_allocator draws from the arena");
+    }
+    watch(block, arena.get_used());
+  }
+  check(watched_freed && watched_zeroed, "secure_arena zeroes its allocations when destroyed");
+}
+
+}
+
+// replace the global allocation functions, to inspect blocks as they are freed - new and delete both use malloc and free, so they do match
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void *ptr) noexcept {
+  check_watched(ptr);
+  std::free(ptr);
+}
+void operator delete(void *ptr, size_t /*size*/) noexcept {
+  check_watched(ptr);
+  std::free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+  check_watched(ptr);
+  std::free(ptr);
+}
+void operator delete[](void *ptr, size_t /*size*/) noexcept {
+  check_watched(ptr);
+  std::free(ptr);
+}
+void *operator new(size_t size) {
+  if(void *ptr{std::malloc(size ? size : 1)}; ptr) return ptr;
+  throw std::bad_alloc{};
+}
+void *operator new[](size_t size) {
+  return operator new(size);
+}
+#pragma GCC diagnostic pop
+
+int main() {
+  test_secure_cleanse();
+  test_secure_allocator();
+  test_secure_arena();
+  if(failures != 0) {
+    std::cerr << failures << " checks failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "All checks passed" << std::endl;
+  return EXIT_SUCCESS;
+}